@@ -0,0 +1,282 @@
+//
+//  softrenderer.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <new>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "softrenderer.h"
+#include "core/FrameBuffer.hpp"
+#include "texture/YUVTexture.hpp"
+#include "rasterization/Rasterizer.hpp"
+#include "shaders/Transform2DShader.hpp"
+#include "shaders/PassThroughVertexShader.hpp"
+#include "tuning/AutoTuner.hpp"
+
+using namespace SoftRenderer;
+
+struct sr_context {
+    Rasterizer rasterizer;
+    Transform2DShader transform_shader;
+    PassThroughVertexShader pass_through_shader;
+    std::vector<Vertex> vertices;              // 变换后的顶点，在调用间复用
+    std::vector<unsigned char> rgba_scratch;   // RGBA32 目标的 RGB 中转缓冲，在调用间复用
+    std::string last_error;
+};
+
+namespace {
+
+    // 把 C++ 异常转换为状态码并记录错误信息
+    template <typename Body>
+    sr_status guarded(sr_context *ctx, Body &&body) {
+        if (!ctx) {
+            return SR_ERROR_INVALID_ARGUMENT;
+        }
+        ctx->last_error.clear();
+        try {
+            body();
+            return SR_OK;
+        } catch (const std::invalid_argument &e) {
+            ctx->last_error = e.what();
+            return SR_ERROR_INVALID_ARGUMENT;
+        } catch (const std::bad_alloc &) {
+            ctx->last_error = "out of memory";
+            return SR_ERROR_OUT_OF_MEMORY;
+        } catch (const std::exception &e) {
+            ctx->last_error = e.what();
+            return SR_ERROR_RUNTIME;
+        }
+    }
+
+    void validateTarget(const sr_target *target) {
+        if (!target || !target->data || target->width <= 0 || target->height <= 0) {
+            throw std::invalid_argument("sr_target: 目标为空或尺寸无效");
+        }
+        const size_t bytes_per_pixel = target->format == SR_PIXEL_RGBA32 ? 4 : 3;
+        if (target->format != SR_PIXEL_RGB24 && target->format != SR_PIXEL_RGBA32) {
+            throw std::invalid_argument("sr_target: 未知的像素格式");
+        }
+        if (target->stride < static_cast<size_t>(target->width) * bytes_per_pixel) {
+            throw std::invalid_argument("sr_target: 行跨度小于行宽");
+        }
+    }
+
+    ColorSpaceStandard toColorSpace(sr_color_standard standard) {
+        switch (standard) {
+        case SR_COLOR_BT601:
+            return ColorSpaceStandard::BT601;
+        case SR_COLOR_BT709:
+            return ColorSpaceStandard::BT709;
+        case SR_COLOR_BT2020:
+            return ColorSpaceStandard::BT2020;
+        }
+        throw std::invalid_argument("sr_yuv_image: 未知的颜色标准");
+    }
+
+    TextureFilter toFilter(sr_filter filter) {
+        switch (filter) {
+        case SR_FILTER_NEAREST:
+            return TextureFilter::NEAREST;
+        case SR_FILTER_BILINEAR:
+            return TextureFilter::BILINEAR;
+        }
+        throw std::invalid_argument("未知的纹理过滤模式");
+    }
+
+    // 在调用方的平面上建立零拷贝纹理视图
+    YUVTexture makeTextureView(const sr_yuv_image *image, sr_filter filter) {
+        if (!image) {
+            throw std::invalid_argument("sr_yuv_image 为空");
+        }
+        YUVPlaneView view;
+        view.y = image->y;
+        view.u = image->u;
+        view.v = image->v;
+        view.y_stride = image->y_stride;
+        view.u_stride = image->u_stride;
+        view.v_stride = image->v_stride;
+        YUVTexture texture(image->width, image->height, view);
+        texture.setFilterMode(toFilter(filter));
+        texture.setColorSpace(toColorSpace(image->color_standard));
+        return texture;
+    }
+
+    // as_quad 为 true 时 vertices 是沿边界排列的 4 个顶点（整张图像），否则为三角形列表
+    void drawTriangles(sr_context *ctx, const sr_target *target, const sr_yuv_image *image, sr_filter filter,
+                       const sr_vertex *vertices, size_t vertex_count, const sr_transform_2d *transform,
+                       bool as_quad = false) {
+        validateTarget(target);
+        if ((as_quad ? vertex_count != 4 : vertex_count % 3 != 0) || (vertex_count > 0 && !vertices)) {
+            throw std::invalid_argument("sr_draw_triangles: 顶点数必须是 3 的倍数");
+        }
+        YUVTexture texture = makeTextureView(image, filter);
+        if (vertex_count == 0) {
+            return;
+        }
+
+        // 1. 顶点阶段
+        VertexShader *shader = &ctx->pass_through_shader;
+        if (transform) {
+            Transform2DUniforms uniforms;
+            uniforms.translateX = transform->translate_x;
+            uniforms.translateY = transform->translate_y;
+            uniforms.scaleX = transform->scale_x;
+            uniforms.scaleY = transform->scale_y;
+            uniforms.rotate_angle = transform->rotate_angle;
+            ctx->transform_shader.setUniforms(uniforms);
+            shader = &ctx->transform_shader;
+        }
+        static_assert(sizeof(sr_vertex) == sizeof(Vertex), "sr_vertex must mirror SoftRenderer::Vertex");
+        ctx->vertices.resize(vertex_count);
+        for (size_t i = 0; i < vertex_count; ++i) {
+            const sr_vertex &in = vertices[i];
+            ctx->vertices[i] = shader->processVertex(Vertex(in.x, in.y, in.u, in.v));
+        }
+
+        auto rasterize = [&](FrameBuffer &fb) {
+            if (as_quad) {
+                ctx->rasterizer.drawTexturedQuad(fb, ctx->vertices[0], ctx->vertices[1], ctx->vertices[2], ctx->vertices[3], texture);
+                return;
+            }
+            for (size_t i = 0; i < vertex_count; i += 3) {
+                ctx->rasterizer.drawTexturedTriangle(fb, ctx->vertices[i], ctx->vertices[i + 1], ctx->vertices[i + 2], texture);
+            }
+        };
+
+        // 2a. RGB24：直接在调用方内存上光栅化
+        if (target->format == SR_PIXEL_RGB24) {
+            FrameBuffer fb(target->width, target->height, target->data, target->stride);
+            rasterize(fb);
+            return;
+        }
+
+        // 2b. RGBA32：只中转所有三角形包围盒覆盖的行
+        float min_y = ctx->vertices[0].y, max_y = ctx->vertices[0].y;
+        for (const Vertex &vertex : ctx->vertices) {
+            min_y = std::min(min_y, vertex.y);
+            max_y = std::max(max_y, vertex.y);
+        }
+        const int row_begin = std::max(0, static_cast<int>(std::floor(min_y)));
+        const int row_end = std::min(target->height, static_cast<int>(std::ceil(max_y)) + 1);
+        if (row_begin >= row_end) {
+            return;
+        }
+
+        // 中转缓冲与目标同尺寸（保持坐标不变，结果与 RGB24 逐位一致），但只有包围盒内的行参与拷贝；
+        // 光栅化不会写入包围盒以外的行
+        const size_t rgb_stride = static_cast<size_t>(target->width) * 3;
+        ctx->rgba_scratch.resize(rgb_stride * target->height);
+        auto rgba_row = [target](int y) { return target->data + static_cast<size_t>(y) * target->stride; };
+        for (int y = row_begin; y < row_end; ++y) {
+            const unsigned char *in = rgba_row(y);
+            unsigned char *out = &ctx->rgba_scratch[rgb_stride * y];
+            for (int x = 0; x < target->width; ++x) {
+                out[3 * x + 0] = in[4 * x + 0];
+                out[3 * x + 1] = in[4 * x + 1];
+                out[3 * x + 2] = in[4 * x + 2];
+            }
+        }
+
+        FrameBuffer fb(target->width, target->height, ctx->rgba_scratch.data(), rgb_stride);
+        rasterize(fb);
+
+        for (int y = row_begin; y < row_end; ++y) {
+            const unsigned char *in = &ctx->rgba_scratch[rgb_stride * y];
+            unsigned char *out = rgba_row(y);
+            for (int x = 0; x < target->width; ++x) {
+                out[4 * x + 0] = in[3 * x + 0];
+                out[4 * x + 1] = in[3 * x + 1];
+                out[4 * x + 2] = in[3 * x + 2];
+            }
+        }
+    }
+
+} // namespace
+
+extern "C" {
+
+uint32_t sr_get_api_version(void) {
+    return SR_API_VERSION;
+}
+
+sr_context *sr_context_create(void) {
+    return new (std::nothrow) sr_context();
+}
+
+void sr_context_destroy(sr_context *ctx) {
+    delete ctx;
+}
+
+sr_status sr_context_load_tuning(sr_context *ctx, const char *profile_path,
+                                 int32_t fb_width, int32_t fb_height,
+                                 int32_t texture_width, int32_t texture_height) {
+    return guarded(ctx, [&] {
+        if (!profile_path || !*profile_path) {
+            throw std::invalid_argument("sr_context_load_tuning: 配置文件路径为空");
+        }
+        if (fb_width <= 0 || fb_height <= 0 || texture_width <= 0 || texture_height <= 0) {
+            throw std::invalid_argument("sr_context_load_tuning: 尺寸必须为正");
+        }
+        AutoTuner::loadAndApply(profile_path, fb_width, fb_height, texture_width, texture_height, ctx->rasterizer);
+    });
+}
+
+const char *sr_get_last_error(const sr_context *ctx) {
+    return ctx ? ctx->last_error.c_str() : "sr_context 为空";
+}
+
+sr_status sr_clear(sr_context *ctx, const sr_target *target, uint8_t r, uint8_t g, uint8_t b) {
+    return guarded(ctx, [&] {
+        validateTarget(target);
+        if (target->format == SR_PIXEL_RGB24) {
+            FrameBuffer fb(target->width, target->height, target->data, target->stride);
+            for (int y = 0; y < target->height; ++y) {
+                fb.fillSpan(y, 0, target->width, Color(r, g, b));
+            }
+            return;
+        }
+        for (int y = 0; y < target->height; ++y) {
+            unsigned char *row = target->data + static_cast<size_t>(y) * target->stride;
+            for (int x = 0; x < target->width; ++x) {
+                row[4 * x + 0] = r;
+                row[4 * x + 1] = g;
+                row[4 * x + 2] = b;
+                row[4 * x + 3] = 255;
+            }
+        }
+    });
+}
+
+sr_status sr_draw_triangles(sr_context *ctx, const sr_target *target,
+                            const sr_yuv_image *image, sr_filter filter,
+                            const sr_vertex *vertices, size_t vertex_count,
+                            const sr_transform_2d *transform) {
+    return guarded(ctx, [&] {
+        drawTriangles(ctx, target, image, filter, vertices, vertex_count, transform);
+    });
+}
+
+sr_status sr_draw_image(sr_context *ctx, const sr_target *target,
+                        const sr_yuv_image *image, sr_filter filter,
+                        const sr_transform_2d *transform) {
+    return guarded(ctx, [&] {
+        if (!image) {
+            throw std::invalid_argument("sr_yuv_image 为空");
+        }
+        const float w = static_cast<float>(image->width);
+        const float h = static_cast<float>(image->height);
+        const sr_vertex quad[4] = {
+            {0.0f, 0.0f, 0.0f, 0.0f}, {w, 0.0f, 1.0f, 0.0f}, {w, h, 1.0f, 1.0f}, {0.0f, h, 0.0f, 1.0f},
+        };
+        drawTriangles(ctx, target, image, filter, quad, 4, transform, true);
+    });
+}
+
+} // extern "C"
@@ -0,0 +1,150 @@
+//
+//  softrenderer.h
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef softrenderer_h
+#define softrenderer_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * SoftRenderer 的 C API（libsoftrenderer）：在进程内直接渲染，省去“写 YUV 文件 → 启动进程 → 读回 PPM”的往返。
+ *
+ * 零拷贝约定：
+ *   - 源图像 sr_yuv_image 指向调用方的 I420 平面（带行跨度），库只在调用期间读取，不复制、不保存指针；
+ *   - 目标 sr_target 指向调用方的 RGB24 / RGBA32 内存，RGB24 直接作为帧缓冲写入；
+ *     RGBA32 经过一个内部 RGB 缓冲中转（只转换绘制包围盒内的行），alpha 通道只由 sr_clear 写入 255，绘制不改变 alpha。
+ *
+ * 所有函数返回 sr_status；失败时 sr_get_last_error 返回该上下文最近一次错误的描述。
+ * 一个 sr_context 同一时间只能被一个线程使用，不同上下文之间互不影响。
+ */
+
+#if defined(_WIN32)
+    #if defined(SOFTRENDERER_BUILDING_SHARED)
+        #define SR_API __declspec(dllexport)
+    #elif defined(SOFTRENDERER_USING_SHARED)
+        #define SR_API __declspec(dllimport)
+    #else
+        #define SR_API
+    #endif
+#else
+    #define SR_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 结构体布局或函数语义发生不兼容变化时递增
+#define SR_API_VERSION 1
+
+typedef enum sr_status {
+    SR_OK = 0,
+    SR_ERROR_INVALID_ARGUMENT = 1,
+    SR_ERROR_RUNTIME = 2,
+    SR_ERROR_OUT_OF_MEMORY = 3
+} sr_status;
+
+typedef enum sr_filter {
+    SR_FILTER_NEAREST = 0,
+    SR_FILTER_BILINEAR = 1
+} sr_filter;
+
+typedef enum sr_color_standard {
+    SR_COLOR_BT601 = 0,
+    SR_COLOR_BT709 = 1,
+    SR_COLOR_BT2020 = 2
+} sr_color_standard;
+
+typedef enum sr_pixel_format {
+    SR_PIXEL_RGB24 = 0,  // R, G, B
+    SR_PIXEL_RGBA32 = 1  // R, G, B, A
+} sr_pixel_format;
+
+// I420 源图像（宽高为正偶数），行跨度以字节为单位
+typedef struct sr_yuv_image {
+    int32_t width;
+    int32_t height;
+    const uint8_t *y;
+    const uint8_t *u;
+    const uint8_t *v;
+    size_t y_stride;
+    size_t u_stride;
+    size_t v_stride;
+    sr_color_standard color_standard;
+} sr_yuv_image;
+
+// 渲染目标，行跨度以字节为单位
+typedef struct sr_target {
+    int32_t width;
+    int32_t height;
+    uint8_t *data;
+    size_t stride;
+    sr_pixel_format format;
+} sr_target;
+
+// 顶点：屏幕坐标 (x, y) + 纹理坐标 (u, v)，与 SoftRenderer::Vertex 相同
+typedef struct sr_vertex {
+    float x, y;
+    float u, v;
+} sr_vertex;
+
+// 2D 变换（Transform2DShader）：缩放 → 绕原点旋转（弧度）→ 平移，缩放必须为正
+typedef struct sr_transform_2d {
+    float translate_x;
+    float translate_y;
+    float scale_x;
+    float scale_y;
+    float rotate_angle;
+} sr_transform_2d;
+
+typedef struct sr_context sr_context;
+
+SR_API uint32_t sr_get_api_version(void);
+
+// 创建上下文，内存不足时返回 NULL
+SR_API sr_context *sr_context_create(void);
+SR_API void sr_context_destroy(sr_context *ctx);
+
+/**
+ * 加载本机调优配置（见 AutoTuner）：读取 profile_path 中与 fb_width × fb_height 输出、texture_width × texture_height
+ * 源图像同一尺寸等级的配置，没有记录时先校准（1080p 约 5 秒）并写入文件。之后该上下文的绘制使用调优后的绘制路径。
+ * 源图像是每次调用时的零拷贝视图，不开启 RGB 缓存；配置文件格式错误或无法写入时返回 SR_ERROR_RUNTIME。
+ */
+SR_API sr_status sr_context_load_tuning(sr_context *ctx, const char *profile_path,
+                                        int32_t fb_width, int32_t fb_height,
+                                        int32_t texture_width, int32_t texture_height);
+
+// 最近一次失败的错误描述（UTF-8），没有错误时为空字符串；指针在下一次调用该上下文前有效
+SR_API const char *sr_get_last_error(const sr_context *ctx);
+
+// 用 (r, g, b) 填充整个目标，RGBA32 目标的 alpha 置为 255
+SR_API sr_status sr_clear(sr_context *ctx, const sr_target *target, uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * 绘制纹理三角形列表：vertices 每 3 个一组，vertex_count 必须是 3 的倍数。
+ * transform 为 NULL 时顶点原样使用（PassThroughVertexShader），否则先经 Transform2DShader 变换。
+ */
+SR_API sr_status sr_draw_triangles(sr_context *ctx, const sr_target *target,
+                                   const sr_yuv_image *image, sr_filter filter,
+                                   const sr_vertex *vertices, size_t vertex_count,
+                                   const sr_transform_2d *transform);
+
+/**
+ * 便捷接口：把整张图像绘制为以原点为左上角、与图像同尺寸的矩形，再应用 transform（可为 NULL）。
+ * 双线性过滤的大图会走三趟剪切的快速路径（见 Rasterizer::drawTexturedQuad），
+ * 结果与拆成两个三角形调用 sr_draw_triangles 每个分量通常相差 1~2 级。
+ */
+SR_API sr_status sr_draw_image(sr_context *ctx, const sr_target *target,
+                               const sr_yuv_image *image, sr_filter filter,
+                               const sr_transform_2d *transform);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* softrenderer_h */
@@ -18,4 +18,7 @@ struct Color {
     Color(uint8_t red, uint8_t green, uint8_t blue) : r(red), g(green), b(blue) {}
 };
 
+// 帧缓冲按行整段写入（memset / 行指针）依赖于 Color 紧密排列、没有填充字节
+static_assert(sizeof(Color) == 3, "Color must be tightly packed RGB");
+
 #endif /* Color_hpp */
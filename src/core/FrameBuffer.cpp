@@ -5,12 +5,283 @@
 //  Created by Jormungand on 2025/11/20.
 //
 
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
 #include "FrameBuffer.hpp"
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SOFTRENDERER_HAS_STREAMING_STORES 1
+#endif
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
 namespace SoftRenderer {
 
+    namespace {
+        size_t detectLastLevelCache() {
+#if defined(__linux__) && defined(_SC_LEVEL3_CACHE_SIZE)
+            for (int name : {_SC_LEVEL3_CACHE_SIZE, _SC_LEVEL2_CACHE_SIZE}) {
+                const long bytes = sysconf(name);
+                if (bytes > 0) {
+                    return static_cast<size_t>(bytes);
+                }
+            }
+#endif
+            return 32u << 20;
+        }
+
+        std::atomic<size_t> &streamingThreshold() {
+            static std::atomic<size_t> threshold(detectLastLevelCache());
+            return threshold;
+        }
+
+#if defined(SOFTRENDERER_HAS_STREAMING_STORES)
+        constexpr size_t kCacheLine = 64;
+
+        // 首个 64 字节对齐地址之前的字节数
+        size_t headBytes(const unsigned char *dst) {
+            return (kCacheLine - reinterpret_cast<uintptr_t>(dst) % kCacheLine) % kCacheLine;
+        }
+
+        // 首尾不完整的缓存行普通写入，中间整行流式写入；调用方保证 bytes >= kStreamingMinSpanBytes
+        void streamCopy(unsigned char *dst, const unsigned char *src, size_t bytes) {
+            const size_t head = headBytes(dst);
+            std::memcpy(dst, src, head);
+            size_t i = head;
+            for (; i + kCacheLine <= bytes; i += kCacheLine) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 16));
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 32));
+                const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 48));
+                _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i), a);
+                _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i + 16), b);
+                _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i + 32), c);
+                _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i + 48), d);
+            }
+            std::memcpy(dst + i, src + i, bytes - i);
+            // 流式写入是弱序的，返回前排空写合并缓冲，之后其他线程（或 I/O）读到的一定是新数据
+            _mm_sfence();
+        }
+
+        // 用 count 个 color 流式填充；RGB 三字节的周期与 16 字节向量的公倍数是 48 字节，三个向量轮流写出
+        void streamFill(unsigned char *dst, const Color &color, size_t count) {
+            const unsigned char rgb[3] = {color.r, color.g, color.b};
+            const size_t bytes = count * sizeof(Color);
+            const size_t head = headBytes(dst);
+            for (size_t i = 0; i < head; ++i) {
+                dst[i] = rgb[i % 3];
+            }
+            alignas(16) unsigned char pattern[48];
+            for (size_t j = 0; j < sizeof(pattern); ++j) {
+                pattern[j] = rgb[(head + j) % 3];
+            }
+            const __m128i vectors[3] = {_mm_load_si128(reinterpret_cast<const __m128i *>(pattern)),
+                                        _mm_load_si128(reinterpret_cast<const __m128i *>(pattern + 16)),
+                                        _mm_load_si128(reinterpret_cast<const __m128i *>(pattern + 32))};
+            size_t i = head;
+            int phase = 0;
+            for (; i + kCacheLine <= bytes; i += kCacheLine) {
+                for (size_t k = 0; k < kCacheLine; k += 16) {
+                    _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i + k), vectors[phase]);
+                    phase = phase == 2 ? 0 : phase + 1;
+                }
+            }
+            for (; i < bytes; ++i) {
+                dst[i] = rgb[i % 3];
+            }
+            _mm_sfence();
+        }
+#endif
+    }
+
+    FrameBuffer::FrameBuffer(int w, int h)
+        : width(w), height(h), pixels(static_cast<size_t>(w) * h),
+          tiles_x((w + kClearTileSize - 1) / kClearTileSize),
+          tiles_y((h + kClearTileSize - 1) / kClearTileSize),
+          tile_pending(static_cast<size_t>(tiles_x) * tiles_y, 0),
+          row_stride(static_cast<size_t>(w) * sizeof(Color)) {}
+
+    FrameBuffer::FrameBuffer(int w, int h, unsigned char *external, size_t stride)
+        : width(w), height(h),
+          tiles_x((w + kClearTileSize - 1) / kClearTileSize),
+          tiles_y((h + kClearTileSize - 1) / kClearTileSize),
+          tile_pending(static_cast<size_t>(tiles_x) * tiles_y, 0),
+          external_pixels(external), row_stride(stride) {
+        if (w <= 0 || h <= 0) {
+            throw std::invalid_argument("FrameBuffer: 尺寸必须大于0");
+        }
+        if (!external || stride < static_cast<size_t>(w) * sizeof(Color)) {
+            throw std::invalid_argument("FrameBuffer: 外部内存为空或行跨度小于 width × 3");
+        }
+    }
+
     void FrameBuffer::clear(const Color &clear_color) {
-        std::fill(pixels.begin(), pixels.end(), clear_color);
+        this->clear_color = clear_color;
+        std::fill(tile_pending.begin(), tile_pending.end(), 1);
+        pending_count = tile_pending.size();
+    }
+
+    void FrameBuffer::clearRect(const Rect &rect, const Color &clear_color) {
+        Rect clipped = rect.intersect(Rect(0, 0, width, height));
+        if (clipped.empty()) {
+            return;
+        }
+        // 完全落在矩形内的 Tile 马上会被整块覆盖，先放弃其待清除状态，避免先填旧颜色再填新颜色
+        for (int ty = clipped.y / kClearTileSize; ty <= (clipped.bottom() - 1) / kClearTileSize; ++ty) {
+            for (int tx = clipped.x / kClearTileSize; tx <= (clipped.right() - 1) / kClearTileSize; ++tx) {
+                Rect tile = Rect(tx * kClearTileSize, ty * kClearTileSize, kClearTileSize, kClearTileSize)
+                                .intersect(Rect(0, 0, width, height));
+                if (clipped.intersect(tile) == tile) {
+                    discardTileClear(tx, ty);
+                }
+            }
+        }
+        for (int y = clipped.y; y < clipped.bottom(); ++y) {
+            fillSpan(y, clipped.x, clipped.right(), clear_color);
+        }
+    }
+
+    bool FrameBuffer::isTileClearPending(int tile_x, int tile_y) const {
+        if (tile_x < 0 || tile_x >= tiles_x || tile_y < 0 || tile_y >= tiles_y) {
+            return false;
+        }
+        return tile_pending[static_cast<size_t>(tile_y) * tiles_x + tile_x] != 0;
+    }
+
+    void FrameBuffer::discardTileClear(int tile_x, int tile_y) {
+        if (tile_x < 0 || tile_x >= tiles_x || tile_y < 0 || tile_y >= tiles_y) {
+            return;
+        }
+        unsigned char &pending = tile_pending[static_cast<size_t>(tile_y) * tiles_x + tile_x];
+        if (pending) {
+            pending = 0;
+            --pending_count;
+        }
+    }
+
+    void FrameBuffer::resolveClear() const {
+        if (pending_count == 0) {
+            return;
+        }
+        for (size_t i = 0; i < tile_pending.size(); ++i) {
+            if (tile_pending[i]) {
+                resolveTile(i);
+            }
+        }
+    }
+
+    void FrameBuffer::resolveTile(size_t tile_index) const {
+        const int tile_x = static_cast<int>(tile_index % tiles_x);
+        const int tile_y = static_cast<int>(tile_index / tiles_x);
+        const int x0 = tile_x * kClearTileSize;
+        const int x1 = std::min(x0 + kClearTileSize, width);
+        const int y0 = tile_y * kClearTileSize;
+        const int y1 = std::min(y0 + kClearTileSize, height);
+        for (int y = y0; y < y1; ++y) {
+            Color *row = rowAt(y);
+            std::fill(row + x0, row + x1, clear_color);
+        }
+        tile_pending[tile_index] = 0;
+        --pending_count;
+    }
+
+    void FrameBuffer::resolveRegion(int x0, int x1, int y0, int y1) const {
+        if (pending_count == 0 || x0 >= x1 || y0 >= y1) {
+            return;
+        }
+        for (int ty = y0 / kClearTileSize; ty <= (y1 - 1) / kClearTileSize; ++ty) {
+            for (int tx = x0 / kClearTileSize; tx <= (x1 - 1) / kClearTileSize; ++tx) {
+                size_t index = static_cast<size_t>(ty) * tiles_x + tx;
+                if (tile_pending[index]) {
+                    resolveTile(index);
+                }
+            }
+        }
+    }
+
+    Color *FrameBuffer::getRow(int y) {
+        if (y < 0 || y >= height) {
+            return nullptr;
+        }
+        resolveRegion(0, width, y, y + 1); // 调用方可能访问整行
+        return rowAt(y);
+    }
+
+    const Color *FrameBuffer::getRow(int y) const {
+        if (y < 0 || y >= height) {
+            return nullptr;
+        }
+        resolveRegion(0, width, y, y + 1);
+        return rowAt(y);
+    }
+
+    void FrameBuffer::fillSpan(int y, int x0, int x1, const Color &color) {
+        x0 = std::max(x0, 0);
+        x1 = std::min(x1, width);
+        if (y < 0 || y >= height || x0 >= x1) {
+            return;
+        }
+        resolveRegion(x0, x1, y, y + 1);
+        Color *row = rowAt(y);
+#if defined(SOFTRENDERER_HAS_STREAMING_STORES)
+        if (static_cast<size_t>(x1 - x0) * sizeof(Color) >= kStreamingMinSpanBytes && usesStreamingStores()) {
+            streamFill(reinterpret_cast<unsigned char *>(row + x0), color, static_cast<size_t>(x1 - x0));
+            return;
+        }
+#endif
+        if (color.r == color.g && color.g == color.b) {
+            // 灰度（含黑/白）三个字节相同，整段退化为 memset
+            std::memset(reinterpret_cast<unsigned char *>(row + x0), color.r, static_cast<size_t>(x1 - x0) * sizeof(Color));
+        } else {
+            std::fill(row + x0, row + x1, color);
+        }
+    }
+
+    void FrameBuffer::writeSpan(int y, int x0, const Color *src, int count) {
+        int x1 = x0 + count;
+        if (x0 < 0) {
+            src -= x0;
+            x0 = 0;
+        }
+        x1 = std::min(x1, width);
+        if (y < 0 || y >= height || x0 >= x1) {
+            return;
+        }
+        resolveRegion(x0, x1, y, y + 1);
+        const size_t bytes = static_cast<size_t>(x1 - x0) * sizeof(Color);
+        unsigned char *dst = reinterpret_cast<unsigned char *>(rowAt(y) + x0);
+#if defined(SOFTRENDERER_HAS_STREAMING_STORES)
+        if (bytes >= kStreamingMinSpanBytes && usesStreamingStores()) {
+            streamCopy(dst, reinterpret_cast<const unsigned char *>(src), bytes);
+            return;
+        }
+#endif
+        std::memcpy(dst, src, bytes);
+    }
+
+    bool FrameBuffer::usesStreamingStores() const {
+#if defined(SOFTRENDERER_HAS_STREAMING_STORES)
+        if (store_mode != StoreMode::AUTO) {
+            return store_mode == StoreMode::STREAMING;
+        }
+        return static_cast<size_t>(height) * row_stride > getStreamingThreshold();
+#else
+        return false;
+#endif
+    }
+
+    size_t FrameBuffer::getStreamingThreshold() {
+        return streamingThreshold().load(std::memory_order_relaxed);
+    }
+
+    void FrameBuffer::setStreamingThreshold(size_t bytes) {
+        streamingThreshold().store(bytes, std::memory_order_relaxed);
     }
 
     bool FrameBuffer::saveToPPM(std::string filename) {
@@ -29,11 +300,14 @@ namespace SoftRenderer {
         // 3. 最大颜色值：一个整数，通常为 255，表示每个颜色通道的最大值。
         ofs << "P6 " << width << " " << height << " 255\n"; // 最大颜色值 255
 
+        // 落地尚未填充的惰性清屏
+        resolveClear();
+
         // 写入像素数据，按行优先顺序存储，每个像素由3个字节表示（R、G、B）
-        for (const auto &pixel : pixels)
+        // p6格式明确了接下来的像素数据将是二进制形式，因此数据之间无需分隔；外部内存的行间可能有填充，逐行写入
+        for (int y = 0; y < height; ++y)
         {
-            // p6格式明确了接下来的像素数据将是二进制形式，因此数据之间无需分隔
-            ofs << pixel.r << pixel.g << pixel.b;
+            ofs.write(reinterpret_cast<const char *>(rowAt(y)), static_cast<std::streamsize>(width) * sizeof(Color));
         }
 
         return true;
@@ -44,8 +318,13 @@ namespace SoftRenderer {
         // x ∈ [0, width-1], y ∈ [0, height-1]
         if (x >= 0 && x < width && y >= 0 && y < height)
         {
-            int index = y * width + x;
-            pixels[index] = color;
+            if (pending_count != 0) {
+                size_t tile_index = static_cast<size_t>(y / kClearTileSize) * tiles_x + x / kClearTileSize;
+                if (tile_pending[tile_index]) {
+                    resolveTile(tile_index);
+                }
+            }
+            rowAt(y)[x] = color;
         }
     }
 
@@ -53,8 +332,10 @@ namespace SoftRenderer {
         if (x < 0 || x >= width || y < 0 || y >= height) {
             return Color{0, 0, 0}; // 返回默认颜色
         }
-        int index = y * width + x;
-        return pixels[index];
+        if (pending_count != 0 && tile_pending[static_cast<size_t>(y / kClearTileSize) * tiles_x + x / kClearTileSize]) {
+            return clear_color; // 待清除的 Tile 无需落地即可得出结果
+        }
+        return rowAt(y)[x];
     }
 
 } // namespace SoftRenderer
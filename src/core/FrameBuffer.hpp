@@ -12,6 +12,7 @@
 #include <string>
 #include <fstream>
 #include "Color.hpp"
+#include "Rect.hpp"
 
 /**
  YUVTexture (YUV数据)
@@ -32,10 +33,27 @@ namespace SoftRenderer {
      */
     class FrameBuffer {
     public:
-        FrameBuffer(int w, int h) : width(w), height(h), pixels(w * h) {}
+        FrameBuffer(int w, int h);
+
+        /**
+         * 零拷贝：直接渲染到调用方的 RGB24 内存（不拥有、不释放）。
+         * @param external 第 0 行首地址，像素为紧凑的 R、G、B 三字节
+         * @param stride 行跨度（字节），不小于 w × 3，允许行尾填充
+         * 拷贝这样的 FrameBuffer 得到的是同一块内存的另一个视图。
+         */
+        FrameBuffer(int w, int h, unsigned char *external, size_t stride);
         
-        // 清屏函数，把整个帧缓冲填充为指定颜色
+        /**
+         * 清屏函数，把整个帧缓冲“填充”为指定颜色。
+         * 惰性清屏（Fast Clear）：只记录清屏颜色并把所有 Tile 标记为“待清除”，代价是 O(Tile 数) 而不是 O(像素数)。
+         * 某个 Tile 第一次被写入、通过行指针访问或保存时才真正填充；
+         * 读取（getPixel）待清除的 Tile 直接返回清屏颜色，不触发填充；
+         * 确定会完整覆盖某个 Tile 的绘制（例如全屏四边形）可以通过 discardTileClear 跳过这次填充。
+         */
         void clear(const Color &clear_color = Color(0, 0, 0));
+
+        // 只清除指定矩形区域（自动与帧缓冲边界取交集），用于局部重绘
+        void clearRect(const Rect &rect, const Color &clear_color = Color(0, 0, 0));
         
         // 保存帧缓冲为 PPM 图片文件（简单的 RGB 格式）
         bool saveToPPM(std::string filename);
@@ -43,10 +61,75 @@ namespace SoftRenderer {
         // 设置某个像素点的颜色
         void setPixel(int x, int y, const Color &color);
         Color getPixel(int x, int y) const;
+
+        /**
+         * 行指针（Row Span）接口：返回第 y 行第一个像素的地址，越界时返回 nullptr。
+         * 同一行的像素在内存中连续，快速路径可以直接按行批量写入，省去 setPixel 的逐像素边界检查；
+         * 调用方负责保证访问的列在 [0, width) 之内。
+         */
+        Color *getRow(int y);
+        const Color *getRow(int y) const;
+
+        // 用同一颜色填充第 y 行的 [x0, x1) 区间（自动钳制到帧缓冲范围内）
+        void fillSpan(int y, int x0, int x1, const Color &color);
+
+        // 把 src 中连续的 count 个像素写入第 y 行从 x0 开始的位置（自动钳制到帧缓冲范围内）
+        void writeSpan(int y, int x0, const Color *src, int count);
+
+        /**
+         * 写入方式。帧缓冲远大于末级缓存（LLC）时，普通写入要先把目标缓存行读进缓存（Read For Ownership），
+         * 写满后再逐出，既多占一倍内存带宽，又把纹理等还会被再次访问的数据挤出缓存。
+         * 流式写入（Non-temporal Store，SSE2 的 movntdq）绕过缓存直接写内存，只用于 fillSpan / writeSpan
+         * 中整行写满的 64 字节缓存行（跨度不足 kStreamingMinSpanBytes 或首尾不完整的缓存行仍用普通写入）；
+         * setPixel、getRow 等逐像素或读改写的访问始终是普通写入。
+         *  - AUTO：帧缓冲字节数超过 getStreamingThreshold() 时使用流式写入（默认）
+         *  - NORMAL / STREAMING：强制关闭 / 开启
+         * 不支持 SSE2 的平台始终是普通写入。
+         */
+        enum class StoreMode { AUTO, NORMAL, STREAMING };
+        void setStoreMode(StoreMode mode) { store_mode = mode; }
+        StoreMode getStoreMode() const { return store_mode; }
+        bool usesStreamingStores() const;
+
+        static constexpr size_t kStreamingMinSpanBytes = 256;
+
+        // AUTO 模式的阈值（字节），默认为本机末级缓存大小（读取失败时为 32 MiB）
+        static size_t getStreamingThreshold();
+        static void setStreamingThreshold(size_t bytes);
+
         int getWidth() const { return width; }
         int getHeight() const { return height; }
+
+        // 惰性清屏的 Tile 边长（像素）
+        static constexpr int kClearTileSize = 64;
+        int getClearTilesX() const { return tiles_x; }
+        int getClearTilesY() const { return tiles_y; }
+
+        bool hasPendingClear() const { return pending_count != 0; }
+
+        // Tile (tile_x, tile_y) 是否仍处于待清除状态
+        bool isTileClearPending(int tile_x, int tile_y) const;
+
+        /**
+         * 放弃 Tile 的待清除状态而不填充。调用方必须保证随后会写入该 Tile 内的每一个像素，
+         * 否则未写入的像素将保留清屏之前的内容。
+         */
+        void discardTileClear(int tile_x, int tile_y);
+
+        // 立即填充所有待清除的 Tile
+        void resolveClear() const;
         
     private:
+        // 填充 [x0, x1) × [y0, y1) 范围内所有待清除的 Tile
+        void resolveRegion(int x0, int x1, int y0, int y1) const;
+        void resolveTile(size_t tile_index) const;
+
+        // 第 y 行首地址（自有像素或外部内存），不做边界检查
+        Color *rowAt(int y) const {
+            unsigned char *base = external_pixels ? external_pixels : reinterpret_cast<unsigned char *>(pixels.data());
+            return reinterpret_cast<Color *>(base + static_cast<size_t>(y) * row_stride);
+        }
+
         /**
          * [分辨率/尺寸] 帧缓冲的宽度和高度，表示像素的数量。
          * - 有效的 X 坐标（索引）范围是 [0, width - 1]。
@@ -57,7 +140,18 @@ namespace SoftRenderer {
          * 存储渲染结果，像素数组，大小 = width * height
          * 布局通常是行主序（Row-major）：pixels[y * width + x]
          */
-        std::vector<Color> pixels;
+        /// NOTE: 惰性清屏在只读访问（const getRow、保存）时也可能需要落地，因此像素和 Tile 状态声明为 mutable；
+        /// 与其他成员一样，FrameBuffer 不支持多线程同时写入。
+        mutable std::vector<Color> pixels;
+
+        int tiles_x, tiles_y;
+        Color clear_color;
+        mutable std::vector<unsigned char> tile_pending; // 每个 Tile 一个“待清除”标记
+        mutable size_t pending_count = 0;                 // 待清除 Tile 数，为 0 时跳过所有检查
+
+        unsigned char *external_pixels = nullptr; // 非空时像素位于调用方内存，pixels 为空
+        size_t row_stride;                        // 行跨度（字节）
+        StoreMode store_mode = StoreMode::AUTO;
     };
 } // namespace SoftRenderer
 
@@ -0,0 +1,43 @@
+//
+//  PPMStreamWriter.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <stdexcept>
+#include "PPMStreamWriter.hpp"
+
+namespace SoftRenderer {
+
+    PPMStreamWriter::PPMStreamWriter(const std::string &filename, int width, int height)
+        : ofs_(filename, std::ios::binary), width_(width), height_(height) {
+        if (!ofs_) {
+            throw std::runtime_error("无法打开输出文件: " + filename);
+        }
+        // 与 FrameBuffer::saveToPPM 相同的 P6 文件头
+        ofs_ << "P6 " << width_ << " " << height_ << " 255\n";
+    }
+
+    bool PPMStreamWriter::writeRows(const FrameBuffer &fb, int first_row, int row_count) {
+        if (fb.getWidth() != width_ || rows_written_ + row_count > height_ ||
+            first_row < 0 || first_row + row_count > fb.getHeight()) {
+            return false;
+        }
+        // Color 紧密排列（3 字节），一行像素就是一段连续的 RGB 字节，可以整行写出
+        const std::streamsize row_bytes = static_cast<std::streamsize>(width_) * sizeof(Color);
+        for (int y = first_row; y < first_row + row_count; ++y) {
+            ofs_.write(reinterpret_cast<const char *>(fb.getRow(y)), row_bytes);
+        }
+        rows_written_ += row_count;
+        return static_cast<bool>(ofs_);
+    }
+
+    bool PPMStreamWriter::finish() {
+        ofs_.flush();
+        bool ok = static_cast<bool>(ofs_) && rows_written_ == height_;
+        ofs_.close();
+        return ok;
+    }
+
+} // namespace SoftRenderer
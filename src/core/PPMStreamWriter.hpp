@@ -0,0 +1,45 @@
+//
+//  PPMStreamWriter.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef PPMStreamWriter_hpp
+#define PPMStreamWriter_hpp
+
+#include <string>
+#include <fstream>
+#include "FrameBuffer.hpp"
+
+namespace SoftRenderer {
+
+    /**
+     * 流式 PPM 写出：先写入完整图像的文件头，再按从上到下的顺序分批追加行。
+     * 用于条带渲染等“整张图放不进内存”的场景，内存中只需要保留当前这一批行。
+     */
+    class PPMStreamWriter {
+    public:
+        // 打开文件并写入文件头，失败时抛出 std::runtime_error
+        PPMStreamWriter(const std::string &filename, int width, int height);
+
+        /**
+         * 追加 fb 中 [first_row, first_row + row_count) 这些行，fb 的宽度必须等于图像宽度。
+         * @return 写入失败、宽度不匹配或超出图像高度时返回 false
+         */
+        bool writeRows(const FrameBuffer &fb, int first_row, int row_count);
+
+        int getRowsWritten() const { return rows_written_; }
+
+        // 刷新并关闭文件，只有所有行都已写入且没有发生错误时返回 true
+        bool finish();
+
+    private:
+        std::ofstream ofs_;
+        int width_, height_;
+        int rows_written_ = 0;
+    };
+
+} // namespace SoftRenderer
+
+#endif /* PPMStreamWriter_hpp */
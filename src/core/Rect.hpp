@@ -0,0 +1,50 @@
+//
+//  Rect.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef Rect_hpp
+#define Rect_hpp
+
+#include <algorithm>
+
+namespace SoftRenderer {
+
+    // 屏幕空间的整数矩形（像素坐标），覆盖 [x, x + width) × [y, y + height)
+    struct Rect {
+        int x = 0, y = 0;
+        int width = 0, height = 0;
+
+        Rect() = default;
+        Rect(int x, int y, int w, int h) : x(x), y(y), width(w), height(h) {}
+
+        int right() const { return x + width; }   // 不包含
+        int bottom() const { return y + height; } // 不包含
+        bool empty() const { return width <= 0 || height <= 0; }
+
+        bool intersects(const Rect &other) const {
+            return x < other.right() && other.x < right() && y < other.bottom() && other.y < bottom();
+        }
+
+        // 求交集，不相交时返回空矩形
+        Rect intersect(const Rect &other) const {
+            int x0 = std::max(x, other.x);
+            int y0 = std::max(y, other.y);
+            int x1 = std::min(right(), other.right());
+            int y1 = std::min(bottom(), other.bottom());
+            if (x1 <= x0 || y1 <= y0) {
+                return Rect();
+            }
+            return Rect(x0, y0, x1 - x0, y1 - y0);
+        }
+
+        bool operator==(const Rect &other) const {
+            return x == other.x && y == other.y && width == other.width && height == other.height;
+        }
+    };
+
+} // namespace SoftRenderer
+
+#endif /* Rect_hpp */
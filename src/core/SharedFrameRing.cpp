@@ -0,0 +1,371 @@
+//
+//  SharedFrameRing.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <new>
+#include <ctime>
+#include <cerrno>
+#include <chrono>
+#include <algorithm>
+#include <thread>
+#include <cstring>
+#include <stdexcept>
+#include <fstream>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "SharedFrameRing.hpp"
+
+namespace SoftRenderer {
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free &&
+                  std::atomic<int32_t>::is_always_lock_free,
+                  "共享内存中的索引必须是无锁原子量（跨进程不能依赖进程内的锁）");
+
+    namespace {
+        constexpr size_t kPageBytes = 4096;
+        constexpr size_t kRowAlign = 64;
+
+        size_t alignUp(size_t value, size_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        int64_t monotonicNanoseconds() {
+            timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+        }
+
+        size_t controlBytes(uint32_t slot_count) {
+            return alignUp(sizeof(SharedFrameRingHeader) + slot_count * sizeof(SharedFrameSlotHeader), kPageBytes);
+        }
+
+        // 进程是否仍然存活：不存在或已成为僵尸进程（已退出但父进程尚未回收）都视为已退出
+        bool processAlive(int32_t pid) {
+            if (pid <= 0) {
+                return false;
+            }
+            if (kill(pid, 0) != 0 && errno == ESRCH) {
+                return false;
+            }
+#if defined(__linux__)
+            // /proc/<pid>/stat 的第三个字段是进程状态，位于最后一个 ')' 之后（进程名可能包含括号）
+            std::ifstream stat("/proc/" + std::to_string(pid) + "/stat");
+            std::string line;
+            if (stat && std::getline(stat, line)) {
+                const size_t paren = line.rfind(')');
+                if (paren != std::string::npos && paren + 2 < line.size()) {
+                    const char state = line[paren + 2];
+                    return state != 'Z' && state != 'X';
+                }
+            }
+#endif
+            return true;
+        }
+
+        enum class WaitResult { READY, TIMEOUT, PEER_GONE };
+
+        constexpr auto kPeerCheckInterval = std::chrono::milliseconds(10);
+
+        /**
+         * 轮询 ready 直到返回 true、超时（timeout_ms < 0 表示不超时）或 peer_alive 返回 false。
+         * 先短暂让出 CPU，之后睡眠时间从 1 µs 倍增到 200 µs：帧间隔是毫秒级的，200 µs 的唤醒延迟可以接受。
+         * peer_alive 涉及系统调用，每 kPeerCheckInterval 检查一次。
+         */
+        template <typename Ready, typename PeerAlive>
+        WaitResult waitFor(Ready ready, PeerAlive peer_alive, int timeout_ms) {
+            const auto start = std::chrono::steady_clock::now();
+            const auto deadline = start + std::chrono::milliseconds(timeout_ms);
+            auto next_peer_check = start + kPeerCheckInterval;
+            std::chrono::microseconds sleep(1);
+            for (int attempt = 0;; ++attempt) {
+                if (ready()) {
+                    return WaitResult::READY;
+                }
+                const auto now = std::chrono::steady_clock::now();
+                if (now >= next_peer_check) {
+                    if (!peer_alive()) {
+                        return WaitResult::PEER_GONE;
+                    }
+                    next_peer_check = now + kPeerCheckInterval;
+                }
+                if (timeout_ms >= 0 && now >= deadline) {
+                    return WaitResult::TIMEOUT;
+                }
+                if (attempt < 16) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(sleep);
+                    sleep = std::min(sleep * 2, std::chrono::microseconds(200));
+                }
+            }
+        }
+
+        // 消费者尚未连接时不算断开：环满之前生产者本来就不需要消费者
+        bool consumerAlive(const SharedFrameRingHeader *header) {
+            const int32_t pid = header->consumer_pid.load(std::memory_order_acquire);
+            return pid == 0 || (pid > 0 && processAlive(pid));
+        }
+    }
+
+    SharedFrameMapping::~SharedFrameMapping() {
+        if (base_) {
+            munmap(base_, bytes_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    void SharedFrameMapping::map(int fd, size_t bytes) {
+        void *mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            const std::string reason = std::strerror(errno);
+            ::close(fd);
+            throw std::runtime_error("SharedFrameMapping: mmap 失败: " + reason);
+        }
+        fd_ = fd;
+        base_ = static_cast<unsigned char *>(mapping);
+        bytes_ = bytes;
+    }
+
+    SharedFrameSlotHeader *SharedFrameMapping::slotHeader(uint32_t slot) const {
+        return reinterpret_cast<SharedFrameSlotHeader *>(base_ + sizeof(SharedFrameRingHeader)) + slot;
+    }
+
+    unsigned char *SharedFrameMapping::slotPixels(uint32_t slot) const {
+        return base_ + header()->data_offset + slot * header()->slot_bytes;
+    }
+
+    SharedFrameProducer::SharedFrameProducer(const std::string &name, int width, int height, int slot_count)
+        : name_(name) {
+        if (width <= 0 || height <= 0 || slot_count < 2) {
+            throw std::invalid_argument("SharedFrameProducer: 尺寸必须大于0，槽数至少为2");
+        }
+        const size_t stride = alignUp(static_cast<size_t>(width) * sizeof(Color), kRowAlign);
+        const size_t slot_bytes = alignUp(stride * height, kPageBytes);
+        const size_t data_offset = controlBytes(static_cast<uint32_t>(slot_count));
+        const size_t total_bytes = data_offset + slot_bytes * slot_count;
+
+        int fd = -1;
+        if (name_.empty()) {
+#if defined(__linux__)
+            fd = memfd_create("softrenderer-frames", 0); // 不设 CLOEXEC：exec 出的子进程可以继承
+#else
+            throw std::invalid_argument("SharedFrameProducer: 此平台不支持匿名 memfd，请指定共享内存名");
+#endif
+        } else {
+            fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        }
+        if (fd < 0) {
+            throw std::runtime_error("SharedFrameProducer: 无法创建共享内存 " + name_ + ": " + std::strerror(errno));
+        }
+        if (ftruncate(fd, static_cast<off_t>(total_bytes)) != 0) {
+            const std::string reason = std::strerror(errno);
+            ::close(fd);
+            if (!name_.empty()) {
+                shm_unlink(name_.c_str());
+            }
+            throw std::runtime_error("SharedFrameProducer: 无法设置共享内存大小: " + reason);
+        }
+        try {
+            mapping_.map(fd, total_bytes);
+        } catch (...) {
+            if (!name_.empty()) {
+                shm_unlink(name_.c_str());
+            }
+            throw;
+        }
+
+        SharedFrameRingHeader *header = new (mapping_.header()) SharedFrameRingHeader();
+        header->magic.store(0, std::memory_order_relaxed);
+        header->version = SharedFrameRingHeader::kVersion;
+        header->width = static_cast<uint32_t>(width);
+        header->height = static_cast<uint32_t>(height);
+        header->stride = static_cast<uint32_t>(stride);
+        header->format = static_cast<uint32_t>(SharedFrameFormat::RGB24);
+        header->slot_count = static_cast<uint32_t>(slot_count);
+        header->slot_bytes = slot_bytes;
+        header->data_offset = data_offset;
+        header->total_bytes = total_bytes;
+        header->write_index.store(0, std::memory_order_relaxed);
+        header->read_index.store(0, std::memory_order_relaxed);
+        header->closed.store(0, std::memory_order_relaxed);
+        header->producer_pid.store(static_cast<int32_t>(getpid()), std::memory_order_relaxed);
+        header->consumer_pid.store(0, std::memory_order_relaxed);
+        for (int slot = 0; slot < slot_count; ++slot) {
+            new (mapping_.slotHeader(static_cast<uint32_t>(slot))) SharedFrameSlotHeader();
+            frames_.emplace_back(width, height, mapping_.slotPixels(static_cast<uint32_t>(slot)), stride);
+        }
+        // 魔数最后以 release 语义写入：消费者以 acquire 语义读到魔数时，其余字段都已就绪
+        header->magic.store(SharedFrameRingHeader::kMagic, std::memory_order_release);
+    }
+
+    SharedFrameProducer::~SharedFrameProducer() {
+        close();
+        if (!name_.empty()) {
+            shm_unlink(name_.c_str()); // 已打开的消费者仍保有映射
+        }
+    }
+
+    FrameBuffer *SharedFrameProducer::acquire(int timeout_ms) {
+        if (closed_) {
+            throw std::logic_error("SharedFrameProducer::acquire: 输出已结束");
+        }
+        SharedFrameRingHeader *header = mapping_.header();
+        const uint32_t slot = static_cast<uint32_t>(next_frame_ % frames_.size());
+        if (acquired_) {
+            return &frames_[slot];
+        }
+        const WaitResult result = waitFor([&] {
+            return next_frame_ - header->read_index.load(std::memory_order_acquire) < frames_.size();
+        }, [&] { return consumerAlive(header); }, timeout_ms);
+        if (result == WaitResult::PEER_GONE) {
+            throw std::runtime_error("SharedFrameProducer::acquire: 消费者已退出，环中的槽不会再被释放");
+        }
+        if (result == WaitResult::TIMEOUT) {
+            return nullptr;
+        }
+        mapping_.slotHeader(slot)->render_start_ns = monotonicNanoseconds();
+        acquired_ = true;
+        return &frames_[slot];
+    }
+
+    void SharedFrameProducer::publish() {
+        if (!acquired_) {
+            throw std::logic_error("SharedFrameProducer::publish: 没有已取得的槽");
+        }
+        const uint32_t slot = static_cast<uint32_t>(next_frame_ % frames_.size());
+        // 惰性清屏的状态在本进程的 FrameBuffer 对象里，消费者看不到，发布前必须落地到像素
+        frames_[slot].resolveClear();
+        SharedFrameSlotHeader *slot_header = mapping_.slotHeader(slot);
+        slot_header->frame_number = next_frame_;
+        slot_header->publish_ns = monotonicNanoseconds();
+        acquired_ = false;
+        ++next_frame_;
+        mapping_.header()->write_index.store(next_frame_, std::memory_order_release);
+    }
+
+    void SharedFrameProducer::close() {
+        if (!closed_) {
+            closed_ = true;
+            mapping_.header()->closed.store(1, std::memory_order_release);
+        }
+    }
+
+    SharedFrameConsumer::SharedFrameConsumer(const std::string &name) {
+        const int fd = shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) {
+            throw std::runtime_error("SharedFrameConsumer: 无法打开共享内存 " + name + ": " + std::strerror(errno));
+        }
+        attach(fd);
+    }
+
+    SharedFrameConsumer::SharedFrameConsumer(int fd) {
+        const int copy = dup(fd);
+        if (copy < 0) {
+            throw std::runtime_error(std::string("SharedFrameConsumer: 无法复制文件描述符: ") + std::strerror(errno));
+        }
+        attach(copy);
+    }
+
+    SharedFrameConsumer::~SharedFrameConsumer() {
+        if (mapping_.header()) {
+            mapping_.header()->consumer_pid.store(-1, std::memory_order_release);
+        }
+    }
+
+    void SharedFrameConsumer::attach(int fd) {
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SharedFrameRingHeader)) {
+            ::close(fd);
+            throw std::runtime_error("SharedFrameConsumer: 共享内存太小，不是共享帧环");
+        }
+        const size_t bytes = static_cast<size_t>(info.st_size);
+        mapping_.map(fd, bytes);
+
+        const SharedFrameRingHeader *header = mapping_.header();
+        if (header->magic.load(std::memory_order_acquire) != SharedFrameRingHeader::kMagic ||
+            header->version != SharedFrameRingHeader::kVersion) {
+            throw std::runtime_error("SharedFrameConsumer: 魔数或版本不符（不是共享帧环，或生产者尚未初始化完成）");
+        }
+        if (header->format != static_cast<uint32_t>(SharedFrameFormat::RGB24) || header->slot_count < 2 ||
+            header->total_bytes > bytes ||
+            header->data_offset < controlBytes(header->slot_count) ||
+            header->stride < static_cast<uint64_t>(header->width) * sizeof(Color) ||
+            header->slot_bytes < static_cast<uint64_t>(header->stride) * header->height ||
+            header->data_offset + header->slot_bytes * header->slot_count > header->total_bytes) {
+            throw std::runtime_error("SharedFrameConsumer: 共享帧环头部无效");
+        }
+        for (uint32_t slot = 0; slot < header->slot_count; ++slot) {
+            frames_.emplace_back(static_cast<int>(header->width), static_cast<int>(header->height),
+                                 mapping_.slotPixels(slot), header->stride);
+        }
+        mapping_.header()->consumer_pid.store(static_cast<int32_t>(getpid()), std::memory_order_release);
+    }
+
+    const SharedFrame *SharedFrameConsumer::acquire(int timeout_ms, bool latest) {
+        if (acquired_) {
+            return &current_;
+        }
+        SharedFrameRingHeader *header = mapping_.header();
+        const uint64_t read = header->read_index.load(std::memory_order_relaxed);
+        uint64_t written = 0;
+        const WaitResult result = waitFor([&] {
+            // 先读 closed 再读 write_index：看到 closed 时，生产者结束前发布的帧一定都可见
+            const bool closed = header->closed.load(std::memory_order_acquire) != 0;
+            written = header->write_index.load(std::memory_order_acquire);
+            return written > read || closed;
+        }, [&] { return processAlive(header->producer_pid.load(std::memory_order_relaxed)); }, timeout_ms);
+        if (result == WaitResult::PEER_GONE) {
+            // 生产者已退出：它退出前发布的帧仍然有效
+            written = header->write_index.load(std::memory_order_acquire);
+        }
+        if (result == WaitResult::TIMEOUT || written == read) {
+            return nullptr;
+        }
+
+        uint64_t frame = read;
+        if (latest && written - read > 1) {
+            // 跳过积压的帧：直接释放它们的槽
+            frame = written - 1;
+            skipped_ += frame - read;
+            header->read_index.store(frame, std::memory_order_release);
+        }
+        const uint32_t slot = static_cast<uint32_t>(frame % header->slot_count);
+        const SharedFrameSlotHeader *slot_header = mapping_.slotHeader(slot);
+        current_.frame_number = slot_header->frame_number;
+        current_.render_start_ns = slot_header->render_start_ns;
+        current_.publish_ns = slot_header->publish_ns;
+        current_.width = static_cast<int>(header->width);
+        current_.height = static_cast<int>(header->height);
+        current_.stride = header->stride;
+        current_.pixels = mapping_.slotPixels(slot);
+        current_.image = &frames_[slot];
+        acquired_ = true;
+        return &current_;
+    }
+
+    void SharedFrameConsumer::release() {
+        if (!acquired_) {
+            return;
+        }
+        acquired_ = false;
+        SharedFrameRingHeader *header = mapping_.header();
+        header->read_index.store(header->read_index.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool SharedFrameConsumer::isFinished() const {
+        const SharedFrameRingHeader *header = mapping_.header();
+        const bool ended = header->closed.load(std::memory_order_acquire) != 0 ||
+                           !processAlive(header->producer_pid.load(std::memory_order_relaxed));
+        return !acquired_ && ended &&
+               header->read_index.load(std::memory_order_relaxed) == header->write_index.load(std::memory_order_acquire);
+    }
+
+} // namespace SoftRenderer
@@ -0,0 +1,199 @@
+//
+//  SharedFrameRing.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef SharedFrameRing_hpp
+#define SharedFrameRing_hpp
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "FrameBuffer.hpp"
+
+/**
+ * 共享内存帧输出：编码器、预览等下游进程直接读取渲染结果，不经过 PPM 文件，也不拷贝像素。
+ *
+ * 共享内存（POSIX shm 或 memfd）布局：
+ *   ┌───────────────────────────────┐
+ *   │ SharedFrameRingHeader          │ 魔数、版本、宽高、行跨度、格式、槽数，生产者 / 消费者索引
+ *   │ SharedFrameSlotHeader × N      │ 每个槽的帧号、时间戳
+ *   ├───────────────────────────────┤ 4 KiB 对齐
+ *   │ 槽 0 像素（RGB24，行跨度 64 字节对齐） │
+ *   │ ...                           │
+ *   │ 槽 N-1 像素                    │
+ *   └───────────────────────────────┘
+ *
+ * 单生产者、单消费者，无锁：
+ *   write_index 只由生产者递增（已发布的帧数），read_index 只由消费者递增（已释放的帧数），
+ *   第 k 帧位于槽 k % N；write_index - read_index == N 时环已满，生产者等待消费者释放。
+ *   生产者以 release 语义发布 write_index，消费者以 acquire 语义读取，保证看到完整的像素和槽头。
+ *
+ * 等待（环满 / 环空）采用轮询加退避睡眠，不依赖跨进程的互斥量或条件变量。
+ * 头部记录双方的进程号，等待期间每 10 ms 检查一次对方是否仍然存活（要求双方在同一个 PID 命名空间）：
+ *   生产者等待空槽时消费者进程已退出（或消费者对象已析构）→ acquire 抛出 std::runtime_error；
+ *   消费者等待新帧时生产者进程已退出 → 视同生产者已结束，取完剩余的帧后 acquire 返回 nullptr。
+ * 消费者尚未连接时生产者照常等待（环满之前不需要消费者）。
+ * 时间戳为 CLOCK_MONOTONIC 纳秒，同一台机器上的进程之间可以直接比较。
+ */
+namespace SoftRenderer {
+
+    enum class SharedFrameFormat : uint32_t {
+        RGB24 = 1, // 与 FrameBuffer 相同：R、G、B 三字节紧凑排列
+    };
+
+    struct SharedFrameRingHeader {
+        static constexpr uint32_t kMagic = 0x52465253;  // "SRFR"
+        static constexpr uint32_t kVersion = 2;
+
+        std::atomic<uint32_t> magic;  // 生产者初始化完成后最后写入（release），消费者以 acquire 读取
+        uint32_t version;
+        uint32_t width, height;
+        uint32_t stride;           // 行跨度（字节）
+        uint32_t format;           // SharedFrameFormat
+        uint32_t slot_count;
+        uint32_t reserved;
+        uint64_t slot_bytes;       // 每个槽的字节数（4 KiB 对齐）
+        uint64_t data_offset;      // 槽 0 相对映射起点的偏移
+        uint64_t total_bytes;      // 共享内存总大小
+
+        alignas(64) std::atomic<uint64_t> write_index; // 生产者独占的缓存行
+        alignas(64) std::atomic<uint64_t> read_index;  // 消费者独占的缓存行
+        std::atomic<uint32_t> closed;                  // 生产者已结束输出
+        std::atomic<int32_t> producer_pid;             // 生产者进程号
+        std::atomic<int32_t> consumer_pid;             // 消费者进程号：0 表示尚未连接，-1 表示已断开
+    };
+
+    struct alignas(64) SharedFrameSlotHeader {
+        uint64_t frame_number;     // 生产者的帧序号（从 0 开始）
+        int64_t render_start_ns;   // acquire 时刻
+        int64_t publish_ns;        // publish 时刻
+    };
+
+    // 共享内存映射（生产者和消费者共用），拥有 fd 和映射
+    class SharedFrameMapping {
+    public:
+        SharedFrameMapping() = default;
+        ~SharedFrameMapping();
+        SharedFrameMapping(const SharedFrameMapping &) = delete;
+        SharedFrameMapping &operator=(const SharedFrameMapping &) = delete;
+
+        // 接管 fd 并映射前 bytes 字节（读写），失败时关闭 fd 并抛出 std::runtime_error
+        void map(int fd, size_t bytes);
+
+        int getFd() const { return fd_; }
+        SharedFrameRingHeader *header() const { return reinterpret_cast<SharedFrameRingHeader *>(base_); }
+        SharedFrameSlotHeader *slotHeader(uint32_t slot) const;
+        unsigned char *slotPixels(uint32_t slot) const;
+
+    private:
+        int fd_ = -1;
+        unsigned char *base_ = nullptr;
+        size_t bytes_ = 0;
+    };
+
+    class SharedFrameProducer {
+    public:
+        /**
+         * 创建共享帧环。
+         * @param name POSIX 共享内存名（如 "/softrenderer"，消费者按名打开，析构时 shm_unlink）；
+         *             为空时使用匿名 memfd（Linux），通过 getFd() 传给子进程或经 Unix socket 传递
+         * @param slot_count 槽数，2 为双缓冲，3 为三缓冲
+         * 参数无效时抛出 std::invalid_argument，共享内存创建失败（包括同名对象已存在）时抛出 std::runtime_error。
+         */
+        SharedFrameProducer(const std::string &name, int width, int height, int slot_count = 3);
+
+        // 标记输出结束（消费者的 acquire 随后返回 nullptr）并解除映射
+        ~SharedFrameProducer();
+
+        SharedFrameProducer(const SharedFrameProducer &) = delete;
+        SharedFrameProducer &operator=(const SharedFrameProducer &) = delete;
+
+        /**
+         * 取得下一个空闲槽，渲染器直接在返回的帧缓冲上绘制（零拷贝）。
+         * 环已满时等待消费者释放，timeout_ms < 0 表示一直等待；超时返回 nullptr，
+         * 等待期间消费者进程退出或已断开时抛出 std::runtime_error。
+         * 已取得但尚未发布时再次调用返回同一个槽。槽中是该槽上一次的内容，需要时由调用方清屏。
+         */
+        FrameBuffer *acquire(int timeout_ms = -1);
+
+        // 发布已取得的槽（先落地惰性清屏）；没有已取得的槽时抛出 std::logic_error
+        void publish();
+
+        // 标记输出结束，之后不能再 acquire
+        void close();
+
+        uint64_t getFramesPublished() const { return next_frame_; }
+        int getSlotCount() const { return static_cast<int>(frames_.size()); }
+        int getFd() const { return mapping_.getFd(); }
+        const std::string &getName() const { return name_; }
+
+    private:
+        std::string name_;
+        SharedFrameMapping mapping_;
+        std::vector<FrameBuffer> frames_; // 各槽像素上的视图
+        uint64_t next_frame_ = 0;
+        bool acquired_ = false;
+        bool closed_ = false;
+    };
+
+    // 消费者看到的一帧（指向共享内存，release 之前有效）
+    struct SharedFrame {
+        uint64_t frame_number = 0;
+        int64_t render_start_ns = 0;
+        int64_t publish_ns = 0;
+        int width = 0, height = 0;
+        size_t stride = 0;
+        const unsigned char *pixels = nullptr; // 第 0 行首地址，RGB24
+        const FrameBuffer *image = nullptr;    // 同一块内存的 FrameBuffer 视图
+    };
+
+    class SharedFrameConsumer {
+    public:
+        // 按名打开生产者创建的共享帧环；不存在或格式不符时抛出 std::runtime_error
+        explicit SharedFrameConsumer(const std::string &name);
+
+        // 从文件描述符打开（如继承的 memfd），fd 被复制，调用方仍负责关闭自己的 fd
+        explicit SharedFrameConsumer(int fd);
+
+        // 标记消费者已断开，等待空槽的生产者随即失败而不是一直等待
+        ~SharedFrameConsumer();
+
+        SharedFrameConsumer(const SharedFrameConsumer &) = delete;
+        SharedFrameConsumer &operator=(const SharedFrameConsumer &) = delete;
+
+        /**
+         * 取得下一帧。latest 为 true 时跳过所有积压的旧帧，只取最新的一帧（预览用）；
+         * 为 false 时按顺序逐帧取（编码用）。
+         * 没有新帧时等待，timeout_ms < 0 表示一直等待；超时或生产者已结束（包括进程已退出）且没有剩余帧时返回 nullptr。
+         * 已取得但尚未释放时再次调用返回同一帧。
+         */
+        const SharedFrame *acquire(int timeout_ms = -1, bool latest = false);
+
+        // 释放已取得的帧，其槽可以被生产者重用
+        void release();
+
+        // 生产者已结束（或进程已退出）且所有帧都已被取走
+        bool isFinished() const;
+
+        int getWidth() const { return static_cast<int>(mapping_.header()->width); }
+        int getHeight() const { return static_cast<int>(mapping_.header()->height); }
+        int getSlotCount() const { return static_cast<int>(mapping_.header()->slot_count); }
+        uint64_t getFramesSkipped() const { return skipped_; }
+
+    private:
+        void attach(int fd);
+
+        SharedFrameMapping mapping_;
+        std::vector<FrameBuffer> frames_;
+        SharedFrame current_;
+        bool acquired_ = false;
+        uint64_t skipped_ = 0;
+    };
+
+} // namespace SoftRenderer
+
+#endif /* SharedFrameRing_hpp */
@@ -0,0 +1,75 @@
+//
+//  YUVFrameBuffer.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include "YUVFrameBuffer.hpp"
+
+namespace SoftRenderer {
+
+    YUVFrameBuffer::YUVFrameBuffer(int w, int h, ColorSpaceStandard standard)
+        : width(w), height(h), standard(standard) {
+        if (w <= 0 || h <= 0 || w % 2 != 0 || h % 2 != 0) {
+            throw std::invalid_argument("YUVFrameBuffer 要求宽高为正偶数");
+        }
+        y_plane.resize(static_cast<size_t>(w) * h);
+        u_plane.resize(static_cast<size_t>(w / 2) * (h / 2));
+        v_plane.resize(u_plane.size());
+    }
+
+    void YUVFrameBuffer::clear(unsigned char y, unsigned char u, unsigned char v) {
+        std::fill(y_plane.begin(), y_plane.end(), y);
+        std::fill(u_plane.begin(), u_plane.end(), u);
+        std::fill(v_plane.begin(), v_plane.end(), v);
+    }
+
+    bool YUVFrameBuffer::saveToYUV(const std::string &filename) const {
+        std::ofstream ofs(filename, std::ios::binary);
+        if (!ofs) {
+            return false;
+        }
+        ofs.write(reinterpret_cast<const char *>(y_plane.data()), static_cast<std::streamsize>(y_plane.size()));
+        ofs.write(reinterpret_cast<const char *>(u_plane.data()), static_cast<std::streamsize>(u_plane.size()));
+        ofs.write(reinterpret_cast<const char *>(v_plane.data()), static_cast<std::streamsize>(v_plane.size()));
+        return static_cast<bool>(ofs);
+    }
+
+    void YUVFrameBuffer::setLuma(int x, int y, unsigned char value) {
+        if (x >= 0 && x < width && y >= 0 && y < height) {
+            y_plane[static_cast<size_t>(y) * width + x] = value;
+        }
+    }
+
+    void YUVFrameBuffer::setChroma(int cx, int cy, unsigned char u, unsigned char v) {
+        const int chroma_width = width / 2;
+        if (cx >= 0 && cx < chroma_width && cy >= 0 && cy < height / 2) {
+            size_t index = static_cast<size_t>(cy) * chroma_width + cx;
+            u_plane[index] = u;
+            v_plane[index] = v;
+        }
+    }
+
+    unsigned char YUVFrameBuffer::getLuma(int x, int y) const {
+        if (x < 0 || x >= width || y < 0 || y >= height) {
+            return 0;
+        }
+        return y_plane[static_cast<size_t>(y) * width + x];
+    }
+
+    void YUVFrameBuffer::getChroma(int cx, int cy, unsigned char &u, unsigned char &v) const {
+        const int chroma_width = width / 2;
+        if (cx < 0 || cx >= chroma_width || cy < 0 || cy >= height / 2) {
+            u = v = 128;
+            return;
+        }
+        size_t index = static_cast<size_t>(cy) * chroma_width + cx;
+        u = u_plane[index];
+        v = v_plane[index];
+    }
+
+} // namespace SoftRenderer
@@ -0,0 +1,71 @@
+//
+//  YUVFrameBuffer.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef YUVFrameBuffer_hpp
+#define YUVFrameBuffer_hpp
+
+#include <vector>
+#include <string>
+#include "texture/ColorSpace.hpp"
+
+/**
+ * YUV420（I420）渲染目标：输出直接交给视频编码器时使用。
+ *
+ *  RGB 目标：YUVTexture → yuvToRGB → FrameBuffer(RGB) → 外部 rgbToYUV → 编码器
+ *  YUV 目标：YUVTexture ───────────→ YUVFrameBuffer(I420) ───────────→ 编码器
+ *
+ * 标准一致时完全不做颜色空间转换；亮度按像素写入，色度按 2×2 像素块写入，
+ * 每像素写入带宽从 3 字节降到 1.5 字节。
+ */
+namespace SoftRenderer {
+
+    class YUVFrameBuffer {
+    public:
+        // 宽高必须为正偶数，否则抛出 std::invalid_argument
+        YUVFrameBuffer(int w, int h, ColorSpaceStandard standard = ColorSpaceStandard::BT601);
+
+        // 以 YUV 值清屏，默认黑色（Y=0，U=V=128）
+        void clear(unsigned char y = 0, unsigned char u = 128, unsigned char v = 128);
+
+        // 保存为裸 I420 文件（[Y][U][V] 三个平面连续存放），可直接被编码器或 YUVTexture 读取
+        bool saveToYUV(const std::string &filename) const;
+
+        // 写入亮度，(x, y) 为像素坐标，越界时忽略
+        void setLuma(int x, int y, unsigned char value);
+        // 写入色度，(cx, cy) 为色度平面坐标（覆盖像素 [2cx, 2cx+1] × [2cy, 2cy+1]），越界时忽略
+        void setChroma(int cx, int cy, unsigned char u, unsigned char v);
+
+        unsigned char getLuma(int x, int y) const;
+        void getChroma(int cx, int cy, unsigned char &u, unsigned char &v) const;
+
+        int getWidth() const { return width; }
+        int getHeight() const { return height; }
+        ColorSpaceStandard getColorSpace() const { return standard; }
+
+        const std::vector<unsigned char> &getYPlane() const { return y_plane; }
+        const std::vector<unsigned char> &getUPlane() const { return u_plane; }
+        const std::vector<unsigned char> &getVPlane() const { return v_plane; }
+
+        // 整行访问（y 为像素行，cy 为色度行），供按行批量填充/写出使用，不做越界检查
+        unsigned char *getYRow(int y) { return y_plane.data() + static_cast<size_t>(y) * width; }
+        unsigned char *getURow(int cy) { return u_plane.data() + static_cast<size_t>(cy) * (width / 2); }
+        unsigned char *getVRow(int cy) { return v_plane.data() + static_cast<size_t>(cy) * (width / 2); }
+        const unsigned char *getYRow(int y) const { return y_plane.data() + static_cast<size_t>(y) * width; }
+        const unsigned char *getURow(int cy) const { return u_plane.data() + static_cast<size_t>(cy) * (width / 2); }
+        const unsigned char *getVRow(int cy) const { return v_plane.data() + static_cast<size_t>(cy) * (width / 2); }
+
+    private:
+        int width, height;
+        ColorSpaceStandard standard;
+        std::vector<unsigned char> y_plane; // width × height
+        std::vector<unsigned char> u_plane; // (width / 2) × (height / 2)
+        std::vector<unsigned char> v_plane;
+    };
+
+} // namespace SoftRenderer
+
+#endif /* YUVFrameBuffer_hpp */
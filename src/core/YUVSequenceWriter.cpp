@@ -0,0 +1,84 @@
+//
+//  YUVSequenceWriter.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <stdexcept>
+#include "YUVSequenceWriter.hpp"
+
+namespace SoftRenderer {
+
+    YUVFileFormat yuvFileFormatFromPath(const std::string &path) {
+        auto ends_with = [&path](const std::string &suffix) {
+            return path.size() >= suffix.size() &&
+                   path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+        };
+        if (ends_with(".y4m")) {
+            return YUVFileFormat::Y4M;
+        }
+        if (ends_with(".nv12")) {
+            return YUVFileFormat::NV12;
+        }
+        return YUVFileFormat::I420;
+    }
+
+    YUVSequenceWriter::YUVSequenceWriter(const std::string &filename, int width, int height,
+                                         YUVFileFormat format, int fps)
+        : width_(width), height_(height), format_(format) {
+        if (width <= 0 || height <= 0 || width % 2 != 0 || height % 2 != 0 || fps <= 0) {
+            throw std::invalid_argument("YUVSequenceWriter 要求宽高为正偶数、帧率为正");
+        }
+        ofs_.open(filename, std::ios::binary);
+        if (!ofs_) {
+            throw std::runtime_error("无法打开输出文件: " + filename);
+        }
+        if (format_ == YUVFileFormat::Y4M) {
+            // C420jpeg：色度位于 2×2 块中心，与 YUVTexture 的色度采样位置一致
+            ofs_ << "YUV4MPEG2 W" << width_ << " H" << height_ << " F" << fps << ":1 Ip A1:1 C420jpeg\n";
+        }
+        if (format_ == YUVFileFormat::NV12) {
+            uv_row_.resize(static_cast<size_t>(width_));
+        }
+    }
+
+    bool YUVSequenceWriter::writeFrame(const YUVFrameBuffer &frame) {
+        if (frame.getWidth() != width_ || frame.getHeight() != height_) {
+            return false;
+        }
+        auto write_plane = [this](const std::vector<unsigned char> &plane) {
+            ofs_.write(reinterpret_cast<const char *>(plane.data()), static_cast<std::streamsize>(plane.size()));
+        };
+
+        if (format_ == YUVFileFormat::Y4M) {
+            ofs_ << "FRAME\n";
+        }
+        write_plane(frame.getYPlane());
+        if (format_ == YUVFileFormat::NV12) {
+            const int chroma_width = width_ / 2;
+            for (int cy = 0; cy < height_ / 2; ++cy) {
+                const unsigned char *u = frame.getURow(cy);
+                const unsigned char *v = frame.getVRow(cy);
+                for (int cx = 0; cx < chroma_width; ++cx) {
+                    uv_row_[2 * cx] = u[cx];
+                    uv_row_[2 * cx + 1] = v[cx];
+                }
+                ofs_.write(reinterpret_cast<const char *>(uv_row_.data()), static_cast<std::streamsize>(uv_row_.size()));
+            }
+        } else {
+            write_plane(frame.getUPlane());
+            write_plane(frame.getVPlane());
+        }
+        ++frames_written_;
+        return static_cast<bool>(ofs_);
+    }
+
+    bool YUVSequenceWriter::finish() {
+        ofs_.flush();
+        bool ok = static_cast<bool>(ofs_);
+        ofs_.close();
+        return ok;
+    }
+
+} // namespace SoftRenderer
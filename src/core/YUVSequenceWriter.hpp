@@ -0,0 +1,55 @@
+//
+//  YUVSequenceWriter.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef YUVSequenceWriter_hpp
+#define YUVSequenceWriter_hpp
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include "YUVFrameBuffer.hpp"
+
+namespace SoftRenderer {
+
+    enum class YUVFileFormat {
+        I420,   // 裸 I420：[Y][U][V] 逐帧连续存放，YUVTexture 可直接读取
+        NV12,   // 裸 NV12：[Y][UV 交织]
+        Y4M,    // YUV4MPEG2（4:2:0），文件头记录宽高和帧率，播放器/编码器可直接打开
+    };
+
+    // 按扩展名推断格式：.y4m → Y4M，.nv12 → NV12，其余 → I420
+    YUVFileFormat yuvFileFormatFromPath(const std::string &path);
+
+    /**
+     * 逐帧写出 YUV 序列。与 PPMStreamWriter 一样先打开文件（Y4M 写入序列头），再追加帧，
+     * 内存中只需要保留当前帧。
+     */
+    class YUVSequenceWriter {
+    public:
+        // 打开文件，失败时抛出 std::runtime_error；宽高必须为正偶数（否则抛出 std::invalid_argument）
+        YUVSequenceWriter(const std::string &filename, int width, int height,
+                          YUVFileFormat format = YUVFileFormat::I420, int fps = 30);
+
+        // 追加一帧，frame 的尺寸必须与序列一致
+        bool writeFrame(const YUVFrameBuffer &frame);
+
+        int getFramesWritten() const { return frames_written_; }
+
+        // 刷新并关闭文件，没有发生错误时返回 true
+        bool finish();
+
+    private:
+        std::ofstream ofs_;
+        int width_, height_;
+        YUVFileFormat format_;
+        int frames_written_ = 0;
+        std::vector<unsigned char> uv_row_; // NV12 交织行的中转缓冲
+    };
+
+} // namespace SoftRenderer
+
+#endif /* YUVSequenceWriter_hpp */
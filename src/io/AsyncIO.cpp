@@ -0,0 +1,628 @@
+//
+//  AsyncIO.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <deque>
+#include <thread>
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "AsyncIO.hpp"
+
+#if defined(__linux__) && defined(SOFTRENDERER_HAVE_IO_URING)
+    #include <sys/mman.h>
+    #include <sys/uio.h>
+    #include <sys/syscall.h>
+    #include <linux/io_uring.h>
+#endif
+
+namespace SoftRenderer {
+
+    // ========== IOBuffer / IOBufferPool ==========
+
+    IOBuffer::IOBuffer(IOBuffer &&other) noexcept { *this = std::move(other); }
+
+    IOBuffer &IOBuffer::operator=(IOBuffer &&other) noexcept {
+        if (this != &other) {
+            release();
+            pool_ = std::move(other.pool_);
+            index_ = other.index_;
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            owned_ = std::move(other.owned_);
+            other.index_ = -1;
+            other.data_ = nullptr;
+            other.size_ = other.capacity_ = 0;
+        }
+        return *this;
+    }
+
+    IOBuffer::~IOBuffer() { release(); }
+
+    void IOBuffer::resize(size_t size) {
+        if (size > capacity_) {
+            throw std::invalid_argument("IOBuffer::resize 超出缓冲容量");
+        }
+        size_ = size;
+    }
+
+    void IOBuffer::release() {
+        if (pool_) {
+            pool_->release(index_);
+            pool_.reset();
+        }
+        index_ = -1;
+        data_ = nullptr;
+        size_ = capacity_ = 0;
+        owned_.reset();
+    }
+
+    IOBufferPool::IOBufferPool(size_t buffer_size, size_t buffer_count)
+        : buffer_size_(buffer_size), buffer_count_(buffer_count) {
+        if (buffer_size == 0 || buffer_count == 0) {
+            throw std::invalid_argument("IOBufferPool: 缓冲大小和数量必须大于0");
+        }
+        // 按页对齐：O_DIRECT 和 io_uring 固定缓冲都偏好页对齐的地址
+        const size_t page = 4096;
+        buffer_size_ = (buffer_size + page - 1) / page * page;
+        void *arena = nullptr;
+        if (posix_memalign(&arena, page, buffer_size_ * buffer_count_) != 0) {
+            throw std::bad_alloc();
+        }
+        arena_ = static_cast<unsigned char *>(arena);
+        for (size_t i = buffer_count_; i > 0; --i) {
+            free_list_.push_back(static_cast<int>(i - 1));
+        }
+    }
+
+    IOBufferPool::~IOBufferPool() { std::free(arena_); }
+
+    IOBuffer IOBufferPool::acquire(size_t size) {
+        IOBuffer buffer;
+        if (size > buffer_size_) {
+            buffer.owned_.reset(new unsigned char[size]);
+            buffer.data_ = buffer.owned_.get();
+            buffer.size_ = buffer.capacity_ = size;
+            return buffer;
+        }
+
+        std::shared_ptr<IOBufferPool> self = weak_from_this().lock();
+        if (!self) {
+            throw std::logic_error("IOBufferPool 必须由 std::shared_ptr 持有");
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        available_.wait(lock, [this] { return !free_list_.empty(); });
+        buffer.index_ = free_list_.back();
+        free_list_.pop_back();
+        lock.unlock();
+
+        buffer.pool_ = std::move(self);
+        buffer.data_ = getBufferData(buffer.index_);
+        buffer.size_ = size;
+        buffer.capacity_ = buffer_size_;
+        return buffer;
+    }
+
+    void IOBufferPool::release(int index) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_list_.push_back(index);
+        }
+        available_.notify_one();
+    }
+
+    // ========== 请求与后端 ==========
+
+    struct AsyncIO::Request {
+        enum class Kind { READ, WRITE };
+
+        Kind kind = Kind::READ;
+        std::string path;
+        int fd = -1;
+        size_t offset = 0;   // 文件偏移
+        size_t done = 0;     // 已完成的字节数（处理短读/短写）
+        IOBuffer buffer;
+        IOCallback callback;
+    };
+
+    class AsyncIO::Backend {
+    public:
+        explicit Backend(AsyncIO &owner) : owner_(owner) {}
+        virtual ~Backend() = default;
+        virtual void submit(std::unique_ptr<Request> request) = 0;
+
+    protected:
+        void finish(std::unique_ptr<Request> request, const std::string &error) {
+            owner_.complete(std::move(request), error);
+        }
+
+    private:
+        AsyncIO &owner_;
+    };
+
+    namespace {
+        std::string errorMessage(const std::string &what, const std::string &path, int err) {
+            return what + " " + path + ": " + std::strerror(err);
+        }
+
+        // 线程池后端：每个工作线程用 pread / pwrite 同步完成一个请求
+        class ThreadPoolBackend : public AsyncIO::Backend {
+        public:
+            ThreadPoolBackend(AsyncIO &owner, int threads) : Backend(owner) {
+                threads = std::max(1, threads);
+                for (int i = 0; i < threads; ++i) {
+                    workers_.emplace_back([this] { workerLoop(); });
+                }
+            }
+
+            ~ThreadPoolBackend() override {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stop_ = true;
+                }
+                ready_.notify_all();
+                for (auto &worker : workers_) {
+                    worker.join();
+                }
+            }
+
+            void submit(std::unique_ptr<AsyncIO::Request> request) override {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    queue_.push_back(std::move(request));
+                }
+                ready_.notify_one();
+            }
+
+        private:
+            void workerLoop() {
+                while (true) {
+                    std::unique_ptr<AsyncIO::Request> request;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        ready_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+                        if (queue_.empty()) {
+                            return;
+                        }
+                        request = std::move(queue_.front());
+                        queue_.pop_front();
+                    }
+                    std::string error = run(*request);
+                    finish(std::move(request), error);
+                }
+            }
+
+            static std::string run(AsyncIO::Request &request) {
+                const bool is_read = request.kind == AsyncIO::Request::Kind::READ;
+                while (request.done < request.buffer.size()) {
+                    unsigned char *data = request.buffer.data() + request.done;
+                    size_t remaining = request.buffer.size() - request.done;
+                    off_t offset = static_cast<off_t>(request.offset + request.done);
+                    ssize_t n = is_read ? ::pread(request.fd, data, remaining, offset)
+                                        : ::pwrite(request.fd, data, remaining, offset);
+                    if (n < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        return errorMessage(is_read ? "读取失败" : "写入失败", request.path, errno);
+                    }
+                    if (n == 0) {
+                        return is_read ? "文件长度不足: " + request.path : "写入失败: " + request.path;
+                    }
+                    request.done += static_cast<size_t>(n);
+                }
+                return std::string();
+            }
+
+            std::vector<std::thread> workers_;
+            std::deque<std::unique_ptr<AsyncIO::Request>> queue_;
+            std::mutex mutex_;
+            std::condition_variable ready_;
+            bool stop_ = false;
+        };
+
+#if defined(__linux__) && defined(SOFTRENDERER_HAVE_IO_URING)
+        /**
+         * io_uring 后端（直接使用系统调用，不依赖 liburing）：
+         * 提交线程在 sq_mutex_ 保护下填写 SQE 并推进 SQ tail；单个收割线程等待并消费 CQE。
+         * 在途请求数不超过 SQ 深度，保证 CQ（深度为 SQ 的两倍）不会溢出。
+         */
+        class IoUringBackend : public AsyncIO::Backend {
+        public:
+            IoUringBackend(AsyncIO &owner, unsigned queue_depth, const IOBufferPool &pool) : Backend(owner) {
+                io_uring_params params;
+                std::memset(&params, 0, sizeof(params));
+                ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, std::max(1u, queue_depth), &params));
+                if (ring_fd_ < 0) {
+                    throw std::runtime_error(std::string("io_uring_setup 失败: ") + std::strerror(errno));
+                }
+                entries_ = params.sq_entries;
+
+                // 映射 SQ / CQ 环和 SQE 数组
+                sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+                if (single_mmap) {
+                    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+                }
+                sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                ring_fd_, IORING_OFF_SQ_RING);
+                if (sq_ring_ == MAP_FAILED) {
+                    sq_ring_ = nullptr;
+                    cleanup();
+                    throw std::runtime_error("io_uring SQ 环映射失败");
+                }
+                cq_ring_ = single_mmap ? sq_ring_
+                                       : mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                              ring_fd_, IORING_OFF_CQ_RING);
+                if (cq_ring_ == MAP_FAILED) {
+                    cq_ring_ = nullptr;
+                    cleanup();
+                    throw std::runtime_error("io_uring CQ 环映射失败");
+                }
+                sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+                void *sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                  ring_fd_, IORING_OFF_SQES);
+                if (sqes == MAP_FAILED) {
+                    cleanup();
+                    throw std::runtime_error("io_uring SQE 数组映射失败");
+                }
+                sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+                unsigned char *sq = static_cast<unsigned char *>(sq_ring_);
+                sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+                sq_mask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+                sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+                unsigned char *cq = static_cast<unsigned char *>(cq_ring_);
+                cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+                cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+                cq_mask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+                cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+                // 注册池内缓冲为固定缓冲，省去每次 I/O 的页面固定（pin）开销；失败（如 memlock 限制）时退回普通读写
+                std::vector<iovec> iovecs(pool.getBufferCount());
+                for (size_t i = 0; i < iovecs.size(); ++i) {
+                    iovecs[i].iov_base = pool.getBufferData(static_cast<int>(i));
+                    iovecs[i].iov_len = pool.getBufferSize();
+                }
+                fixed_buffers_ = syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_BUFFERS,
+                                         iovecs.data(), static_cast<unsigned>(iovecs.size())) == 0;
+
+                reaper_ = std::thread([this] { reapLoop(); });
+            }
+
+            ~IoUringBackend() override {
+                // AsyncIO 析构时已等待所有请求完成，此处提交一个 user_data 为 0 的 NOP 通知收割线程退出
+                {
+                    std::unique_lock<std::mutex> lock(sq_mutex_);
+                    slot_free_.wait(lock, [this] { return pending_ < entries_; });
+                    io_uring_sqe &sqe = nextSqeLocked();
+                    sqe.opcode = IORING_OP_NOP;
+                    sqe.user_data = 0;
+                    pushSqeLocked();
+                }
+                reaper_.join();
+                cleanup();
+            }
+
+            void submit(std::unique_ptr<AsyncIO::Request> request) override {
+                std::unique_lock<std::mutex> lock(sq_mutex_);
+                slot_free_.wait(lock, [this] { return pending_ < entries_; });
+                queueLocked(request.release());
+            }
+
+        private:
+            io_uring_sqe &nextSqeLocked() {
+                const unsigned index = *sq_tail_ & sq_mask_;
+                io_uring_sqe &sqe = sqes_[index];
+                std::memset(&sqe, 0, sizeof(sqe));
+                return sqe;
+            }
+
+            void pushSqeLocked() {
+                const unsigned tail = *sq_tail_;
+                sq_array_[tail & sq_mask_] = tail & sq_mask_;
+                __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+                ++pending_;
+                while (syscall(__NR_io_uring_enter, ring_fd_, 1, 0, 0, nullptr, 0) < 0 && errno == EINTR) {
+                }
+            }
+
+            // 为请求剩余的部分填写一个 SQE：池内缓冲用固定缓冲操作码，其余用普通读写
+            void queueLocked(AsyncIO::Request *request) {
+                const bool is_read = request->kind == AsyncIO::Request::Kind::READ;
+                const size_t remaining = request->buffer.size() - request->done;
+                const int pool_index = request->buffer.getPoolIndex();
+
+                io_uring_sqe &sqe = nextSqeLocked();
+                if (fixed_buffers_ && pool_index >= 0) {
+                    sqe.opcode = is_read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+                    sqe.buf_index = static_cast<uint16_t>(pool_index);
+                } else {
+                    sqe.opcode = is_read ? IORING_OP_READ : IORING_OP_WRITE;
+                }
+                sqe.fd = request->fd;
+                sqe.off = request->offset + request->done;
+                sqe.addr = reinterpret_cast<uint64_t>(request->buffer.data() + request->done);
+                sqe.len = static_cast<uint32_t>(std::min<size_t>(remaining, 1u << 30));
+                sqe.user_data = reinterpret_cast<uint64_t>(request);
+                pushSqeLocked();
+            }
+
+            void reapLoop() {
+                while (true) {
+                    const unsigned head = *cq_head_;
+                    if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+                        syscall(__NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                        continue;
+                    }
+                    const io_uring_cqe cqe = cqes_[head & cq_mask_];
+                    __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+
+                    if (cqe.user_data == 0) {
+                        return; // 退出通知
+                    }
+
+                    auto *request = reinterpret_cast<AsyncIO::Request *>(cqe.user_data);
+                    const bool is_read = request->kind == AsyncIO::Request::Kind::READ;
+                    std::string error;
+                    bool resubmit = false;
+                    if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+                        resubmit = true;
+                    } else if (cqe.res < 0) {
+                        error = errorMessage(is_read ? "读取失败" : "写入失败", request->path, -cqe.res);
+                    } else if (cqe.res == 0 && request->done < request->buffer.size()) {
+                        error = is_read ? "文件长度不足: " + request->path : "写入失败: " + request->path;
+                    } else {
+                        request->done += static_cast<size_t>(cqe.res);
+                        resubmit = request->done < request->buffer.size(); // 短读/短写，继续剩余部分
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock(sq_mutex_);
+                        --pending_;
+                        if (resubmit) {
+                            queueLocked(request);
+                            continue;
+                        }
+                    }
+                    slot_free_.notify_one();
+                    finish(std::unique_ptr<AsyncIO::Request>(request), error);
+                }
+            }
+
+            void cleanup() {
+                if (sqes_) {
+                    munmap(sqes_, sqes_size_);
+                }
+                if (cq_ring_ && cq_ring_ != sq_ring_) {
+                    munmap(cq_ring_, cq_ring_size_);
+                }
+                if (sq_ring_) {
+                    munmap(sq_ring_, sq_ring_size_);
+                }
+                if (ring_fd_ >= 0) {
+                    close(ring_fd_);
+                }
+                sqes_ = nullptr;
+                sq_ring_ = cq_ring_ = nullptr;
+                ring_fd_ = -1;
+            }
+
+            int ring_fd_ = -1;
+            unsigned entries_ = 0;
+            bool fixed_buffers_ = false;
+
+            void *sq_ring_ = nullptr;
+            void *cq_ring_ = nullptr;
+            size_t sq_ring_size_ = 0, cq_ring_size_ = 0, sqes_size_ = 0;
+            io_uring_sqe *sqes_ = nullptr;
+            unsigned *sq_tail_ = nullptr, *sq_array_ = nullptr;
+            unsigned sq_mask_ = 0;
+            unsigned *cq_head_ = nullptr, *cq_tail_ = nullptr;
+            unsigned cq_mask_ = 0;
+            io_uring_cqe *cqes_ = nullptr;
+
+            std::mutex sq_mutex_;
+            std::condition_variable slot_free_;
+            unsigned pending_ = 0; // 已提交、尚未收割的 SQE 数
+            std::thread reaper_;
+        };
+#endif
+    } // namespace
+
+    // ========== AsyncIO ==========
+
+    AsyncIO::AsyncIO(const AsyncIOOptions &options)
+        : pool_(std::make_shared<IOBufferPool>(options.buffer_size, options.buffer_count)) {
+        if (options.backend != IOBackend::THREAD_POOL) {
+#if defined(__linux__) && defined(SOFTRENDERER_HAVE_IO_URING)
+            try {
+                backend_ = std::make_unique<IoUringBackend>(*this, options.queue_depth, *pool_);
+                backend_kind_ = IOBackend::IO_URING;
+            } catch (const std::runtime_error &) {
+                if (options.backend == IOBackend::IO_URING) {
+                    throw;
+                }
+            }
+#else
+            if (options.backend == IOBackend::IO_URING) {
+                throw std::runtime_error("AsyncIO: 编译时未启用 io_uring 支持");
+            }
+#endif
+        }
+        if (!backend_) {
+            backend_ = std::make_unique<ThreadPoolBackend>(*this, options.worker_threads);
+            backend_kind_ = IOBackend::THREAD_POOL;
+        }
+    }
+
+    AsyncIO::~AsyncIO() {
+        drain();
+        backend_.reset();
+    }
+
+    void AsyncIO::submitRead(const std::string &path, size_t offset, size_t length, IOCallback callback) {
+        auto request = std::make_unique<Request>();
+        request->kind = Request::Kind::READ;
+        request->path = path;
+        request->offset = offset;
+        request->callback = std::move(callback);
+        in_flight_.fetch_add(1, std::memory_order_acq_rel);
+
+        request->fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (request->fd < 0) {
+            complete(std::move(request), errorMessage("无法打开文件", path, errno));
+            return;
+        }
+        if (length == kWholeFile) {
+            struct stat st;
+            if (fstat(request->fd, &st) != 0 || static_cast<size_t>(st.st_size) < offset) {
+                complete(std::move(request), "文件长度不足: " + path);
+                return;
+            }
+            length = static_cast<size_t>(st.st_size) - offset;
+        }
+
+        request->buffer = pool_->acquire(length);
+        if (length == 0) {
+            complete(std::move(request), std::string());
+            return;
+        }
+        submit(std::move(request));
+    }
+
+    void AsyncIO::submitWrite(const std::string &path, IOBuffer buffer, IOCallback callback) {
+        auto request = std::make_unique<Request>();
+        request->kind = Request::Kind::WRITE;
+        request->path = path;
+        request->buffer = std::move(buffer);
+        request->callback = std::move(callback);
+        in_flight_.fetch_add(1, std::memory_order_acq_rel);
+
+        request->fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (request->fd < 0) {
+            complete(std::move(request), errorMessage("无法创建文件", path, errno));
+            return;
+        }
+        if (request->buffer.empty()) {
+            complete(std::move(request), std::string());
+            return;
+        }
+        submit(std::move(request));
+    }
+
+    void AsyncIO::submit(std::unique_ptr<Request> request) {
+        backend_->submit(std::move(request));
+    }
+
+    void AsyncIO::complete(std::unique_ptr<Request> request, const std::string &error) {
+        if (request->fd >= 0) {
+            ::close(request->fd);
+            request->fd = -1;
+        }
+        if (request->callback) {
+            IOResult result;
+            result.ok = error.empty();
+            result.error = error;
+            result.path = std::move(request->path);
+            result.buffer = std::move(request->buffer);
+            request->callback(std::move(result));
+        }
+        request.reset(); // 回调未接管的缓冲在此归还到池
+
+        // 加锁后再递减，避免 drain() 在检查计数与进入等待之间错过通知
+        {
+            std::lock_guard<std::mutex> lock(drain_mutex_);
+            in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+        }
+        drained_.notify_all();
+    }
+
+    void AsyncIO::drain() {
+        std::unique_lock<std::mutex> lock(drain_mutex_);
+        drained_.wait(lock, [this] { return in_flight_.load(std::memory_order_acquire) == 0; });
+    }
+
+    std::future<IOBuffer> AsyncIO::read(const std::string &path, size_t offset, size_t length) {
+        auto promise = std::make_shared<std::promise<IOBuffer>>();
+        std::future<IOBuffer> future = promise->get_future();
+        submitRead(path, offset, length, [promise](IOResult &&result) {
+            if (result.ok) {
+                promise->set_value(std::move(result.buffer));
+            } else {
+                promise->set_exception(std::make_exception_ptr(std::runtime_error(result.error)));
+            }
+        });
+        return future;
+    }
+
+    std::future<void> AsyncIO::write(const std::string &path, IOBuffer buffer) {
+        auto promise = std::make_shared<std::promise<void>>();
+        std::future<void> future = promise->get_future();
+        submitWrite(path, std::move(buffer), [promise](IOResult &&result) {
+            if (result.ok) {
+                promise->set_value();
+            } else {
+                promise->set_exception(std::make_exception_ptr(std::runtime_error(result.error)));
+            }
+        });
+        return future;
+    }
+
+    // ========== 纹理 / 帧缓冲的便捷封装 ==========
+
+    std::future<YUVTexture> readYUVTextureAsync(AsyncIO &io, const std::string &path, int w, int h, int frame_index) {
+        if (w <= 0 || h <= 0 || frame_index < 0) {
+            throw std::invalid_argument("readYUVTextureAsync: 尺寸必须为正数，帧序号不能为负数");
+        }
+        const size_t frame_size = YUVTexture::frameSize(w, h);
+        auto promise = std::make_shared<std::promise<YUVTexture>>();
+        std::future<YUVTexture> future = promise->get_future();
+
+        io.submitRead(path, frame_size * static_cast<size_t>(frame_index), frame_size,
+                      [promise, w, h](IOResult &&result) {
+            if (!result.ok) {
+                promise->set_exception(std::make_exception_ptr(std::runtime_error(result.error)));
+                return;
+            }
+            try {
+                // I420 布局：[Y][U][V]
+                const size_t y_size = static_cast<size_t>(w) * h;
+                const size_t uv_size = static_cast<size_t>(w / 2) * (h / 2);
+                const unsigned char *data = result.buffer.data();
+                promise->set_value(YUVTexture(w, h,
+                                              std::vector<unsigned char>(data, data + y_size),
+                                              std::vector<unsigned char>(data + y_size, data + y_size + uv_size),
+                                              std::vector<unsigned char>(data + y_size + uv_size, data + y_size + uv_size * 2)));
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        });
+        return future;
+    }
+
+    std::future<void> writePPMAsync(AsyncIO &io, const FrameBuffer &fb, const std::string &path) {
+        // 与 saveToPPM 相同的文件头，像素按行整段拷贝（Color 紧凑排列为 3 字节）
+        const std::string header = "P6 " + std::to_string(fb.getWidth()) + " " + std::to_string(fb.getHeight()) + " 255\n";
+        const size_t row_bytes = static_cast<size_t>(fb.getWidth()) * sizeof(Color);
+        IOBuffer buffer = io.acquireBuffer(header.size() + row_bytes * fb.getHeight());
+
+        std::memcpy(buffer.data(), header.data(), header.size());
+        unsigned char *out = buffer.data() + header.size();
+        for (int y = 0; y < fb.getHeight(); ++y) {
+            std::memcpy(out + row_bytes * y, fb.getRow(y), row_bytes);
+        }
+        return io.write(path, std::move(buffer));
+    }
+
+} // namespace SoftRenderer
@@ -0,0 +1,198 @@
+//
+//  AsyncIO.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef AsyncIO_hpp
+#define AsyncIO_hpp
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <future>
+#include <cstddef>
+#include <functional>
+#include <condition_variable>
+#include "core/FrameBuffer.hpp"
+#include "texture/YUVTexture.hpp"
+
+/**
+ * 异步批量文件 I/O：批处理上百个文件时，YUVTexture 构造中的 ifstream 读取和 saveToPPM 中的 ofstream
+ * 写入都会让线程阻塞在系统调用里。AsyncIO 让多个读写同时在途，渲染循环提交写出后立即继续下一帧。
+ *
+ * 提交（submitRead / submitWrite，任意线程）
+ *     ↓
+ * 后端
+ *     ├── io_uring：一个提交队列 + 一个收割线程，池内缓冲区注册为固定缓冲（READ_FIXED / WRITE_FIXED）
+ *     └── 线程池：内核不支持 io_uring（或编译时没有 linux/io_uring.h）时的回退，工作线程执行 pread / pwrite
+ *     ↓
+ * 完成回调（在收割线程或工作线程上执行，应尽量轻量）
+ *
+ * 缓冲区来自可复用的缓冲池：池满时 acquireBuffer 阻塞，直到有请求完成并归还缓冲，天然形成背压。
+ */
+namespace SoftRenderer {
+
+    class IOBufferPool;
+
+    // 池化缓冲区（只能移动）：析构时自动归还到池。超过池内缓冲大小的请求使用单独分配的内存。
+    // 缓冲持有池的共享所有权，比创建它的 AsyncIO 活得更久也不会访问已释放的内存。
+    class IOBuffer {
+    public:
+        IOBuffer() = default;
+        IOBuffer(IOBuffer &&other) noexcept;
+        IOBuffer &operator=(IOBuffer &&other) noexcept;
+        ~IOBuffer();
+
+        IOBuffer(const IOBuffer &) = delete;
+        IOBuffer &operator=(const IOBuffer &) = delete;
+
+        unsigned char *data() { return data_; }
+        const unsigned char *data() const { return data_; }
+        size_t size() const { return size_; }
+        size_t capacity() const { return capacity_; }
+        bool empty() const { return size_ == 0; }
+
+        // 调整有效长度，不能超过 capacity()
+        void resize(size_t size);
+
+        // 在池中的下标（即 io_uring 固定缓冲的下标），单独分配的缓冲为 -1
+        int getPoolIndex() const { return index_; }
+
+    private:
+        friend class IOBufferPool;
+        void release();
+
+        std::shared_ptr<IOBufferPool> pool_;
+        int index_ = -1;
+        unsigned char *data_ = nullptr;
+        size_t size_ = 0;
+        size_t capacity_ = 0;
+        std::unique_ptr<unsigned char[]> owned_;
+    };
+
+    // 缓冲池必须由 std::shared_ptr 持有（std::make_shared），借出的缓冲借此延长池的生命周期
+    class IOBufferPool : public std::enable_shared_from_this<IOBufferPool> {
+    public:
+        // 一次性分配 buffer_count 个 buffer_size 字节的缓冲（按页对齐），生命周期内地址不变
+        IOBufferPool(size_t buffer_size, size_t buffer_count);
+        ~IOBufferPool();
+
+        IOBufferPool(const IOBufferPool &) = delete;
+        IOBufferPool &operator=(const IOBufferPool &) = delete;
+
+        /**
+         * 取得一个有效长度为 size 的缓冲。size 不超过 buffer_size 时从池中取，池空则阻塞等待归还；
+         * 否则单独分配（不阻塞，也不能用作 io_uring 固定缓冲）。池不由 shared_ptr 持有时抛出 std::logic_error。
+         */
+        IOBuffer acquire(size_t size);
+
+        size_t getBufferSize() const { return buffer_size_; }
+        size_t getBufferCount() const { return buffer_count_; }
+        unsigned char *getBufferData(int index) const { return arena_ + static_cast<size_t>(index) * buffer_size_; }
+
+    private:
+        friend class IOBuffer;
+        void release(int index);
+
+        size_t buffer_size_;
+        size_t buffer_count_;
+        unsigned char *arena_ = nullptr;
+        std::vector<int> free_list_;
+        std::mutex mutex_;
+        std::condition_variable available_;
+    };
+
+    enum class IOBackend {
+        AUTO,        // 优先 io_uring，初始化失败时回退到线程池
+        IO_URING,
+        THREAD_POOL,
+    };
+
+    struct AsyncIOOptions {
+        IOBackend backend = IOBackend::AUTO;
+        unsigned queue_depth = 64;          // io_uring 提交队列深度（同时在途的最大请求数）
+        int worker_threads = 4;             // 线程池后端的工作线程数
+        size_t buffer_size = 25u << 20;     // 池内单个缓冲大小，默认可容纳一帧 4K RGB PPM（约 24.9 MB）
+        size_t buffer_count = 8;
+    };
+
+    struct IOResult {
+        bool ok = false;
+        std::string error;   // ok 为 false 时的错误描述
+        std::string path;
+        IOBuffer buffer;     // 读请求：读到的数据；写请求：已写出的缓冲（随结果析构归还到池）
+    };
+
+    using IOCallback = std::function<void(IOResult &&result)>;
+
+    class AsyncIO {
+    public:
+        // length 取该值时读取从 offset 到文件末尾的全部内容
+        static constexpr size_t kWholeFile = static_cast<size_t>(-1);
+
+        explicit AsyncIO(const AsyncIOOptions &options = AsyncIOOptions());
+
+        // 等待所有在途请求完成后关闭后端
+        ~AsyncIO();
+
+        AsyncIO(const AsyncIO &) = delete;
+        AsyncIO &operator=(const AsyncIO &) = delete;
+
+        // 从缓冲池取得写缓冲，填好数据后交给 submitWrite
+        IOBuffer acquireBuffer(size_t size) { return pool_->acquire(size); }
+
+        /**
+         * 异步读取 path 中 [offset, offset + length)。文件在调用线程中打开，打开失败时回调立即以错误结果执行。
+         * 文件长度不足时以错误结束（不返回部分数据）。
+         */
+        void submitRead(const std::string &path, size_t offset, size_t length, IOCallback callback);
+
+        // 异步写出：创建/截断 path 并写入 buffer 的全部内容。调用返回后 buffer 归 AsyncIO 所有。
+        void submitWrite(const std::string &path, IOBuffer buffer, IOCallback callback = nullptr);
+
+        // 基于回调的 future 封装，错误以 std::runtime_error 的形式在 get() 时抛出
+        std::future<IOBuffer> read(const std::string &path, size_t offset = 0, size_t length = kWholeFile);
+        std::future<void> write(const std::string &path, IOBuffer buffer);
+
+        // 阻塞直到当前所有在途请求完成（包括回调执行完毕）
+        void drain();
+
+        IOBackend getBackend() const { return backend_kind_; }
+        size_t getInFlight() const { return in_flight_.load(std::memory_order_acquire); }
+
+        // 后端内部使用的请求描述
+        struct Request;
+        class Backend;
+
+    private:
+        void submit(std::unique_ptr<Request> request);
+        void complete(std::unique_ptr<Request> request, const std::string &error);
+
+        std::shared_ptr<IOBufferPool> pool_;
+        IOBackend backend_kind_ = IOBackend::THREAD_POOL;
+        std::unique_ptr<Backend> backend_;
+
+        std::atomic<size_t> in_flight_{0};
+        std::mutex drain_mutex_;
+        std::condition_variable drained_;
+    };
+
+    /**
+     * 异步读取一帧 I420 纹理（与 YUVTexture(filename, w, h, frame_index) 读取的数据相同），
+     * 平面拆分在 I/O 完成线程上进行。
+     */
+    std::future<YUVTexture> readYUVTextureAsync(AsyncIO &io, const std::string &path, int w, int h, int frame_index = 0);
+
+    /**
+     * 把 fb 序列化为 P6 PPM（与 FrameBuffer::saveToPPM 的输出字节一致）后异步写出。
+     * 函数返回时像素已拷贝进 I/O 缓冲，调用方可以立即复用 fb 渲染下一帧。
+     */
+    std::future<void> writePPMAsync(AsyncIO &io, const FrameBuffer &fb, const std::string &path);
+
+} // namespace SoftRenderer
+
+#endif /* AsyncIO_hpp */
@@ -28,6 +28,7 @@
 #include <texture/YUVTexture.hpp>
 #include <shaders/Transform2DShader.hpp>
 #include <rasterization/Rasterizer.hpp>
+#include <tuning/AutoTuner.hpp>
 
 // 获取项目根目录
 std::string getProjectRoot() {
@@ -276,6 +277,19 @@ int main(int argc, char* argv[]) {
 
         SoftRenderer::YUVTexture texture(input_file, 640, 480);
         texture.setFilterMode(SoftRenderer::TextureFilter::BILINEAR); // 使用双线性过滤
+
+        // 第二个参数指定调优配置文件时，按本机的调优配置设置光栅化器和静态纹理的布局（该尺寸还没有记录时先校准
+        // 并写入该文件）；不指定时使用默认配置，不读写任何文件。条带、延迟、多线程渲染器也按同一份配置构造，需要时从 tuned 取用
+        SoftRenderer::Rasterizer rasterizer;
+        std::unique_ptr<SoftRenderer::TunedRenderers> tuned;
+        if (argc > 2) {
+            tuned = std::make_unique<SoftRenderer::TunedRenderers>(argv[2], fb.getWidth(), fb.getHeight(),
+                                                                   texture.getWidth(), texture.getHeight(), rasterizer);
+        } else {
+            tuned = std::make_unique<SoftRenderer::TunedRenderers>(SoftRenderer::TuningConfig(), fb.getWidth(),
+                                                                   fb.getHeight(), rasterizer);
+        }
+        tuned->prepareStaticTexture(texture);
         
         // 3. 创建和配置顶点着色器
         auto vertex_shader = std::make_unique<SoftRenderer::Transform2DShader>();
@@ -309,12 +323,11 @@ int main(int argc, char* argv[]) {
             original_vertices.size()
         );
 
-        // 6. 创建光栅化器并渲染变换后的三角形
-        SoftRenderer::Rasterizer rasterizer;
-        
+        // 6. 用调优后的光栅化器渲染变换后的三角形
         // 使用变换后的顶点进行渲染！
-        rasterizer.drawTexturedTriangle(fb, transformed_vertices[0], transformed_vertices[1], transformed_vertices[2], texture);
-        rasterizer.drawTexturedTriangle(fb, transformed_vertices[3], transformed_vertices[4], transformed_vertices[5], texture);
+        // 两个三角形拼成的是整张图像经过仿射变换后的平行四边形，按四边形绘制（v0 → v1 → v4 → v2 沿边界排列），
+        // 光栅化器会自动选择三趟剪切的快速路径
+        rasterizer.drawTexturedQuad(fb, transformed_vertices[0], transformed_vertices[1], transformed_vertices[4], transformed_vertices[2], texture);
         
         // 绘制纯色三角形，debug code
 //        rasterizer.drawSolidTriangle(fb, quad[0], quad[1], quad[2], {255, 0, 0});
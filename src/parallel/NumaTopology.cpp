@@ -0,0 +1,125 @@
+//
+//  NumaTopology.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <cctype>
+#include <thread>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include "NumaTopology.hpp"
+
+namespace SoftRenderer {
+
+    int NumaTopology::getCpuCount() const {
+        size_t count = 0;
+        for (const std::vector<int> &cpus : nodes) {
+            count += cpus.size();
+        }
+        return static_cast<int>(count);
+    }
+
+    NumaTopology NumaTopology::detect() {
+        NumaTopology topology;
+#if defined(__linux__)
+        // online 与 cpulist 格式相同（如 "0-1"），节点编号可能不连续
+        auto readLine = [](const std::string &path) {
+            std::ifstream file(path);
+            std::string line;
+            std::getline(file, line);
+            return line;
+        };
+        try {
+            for (int node : parseCpuList(readLine("/sys/devices/system/node/online"))) {
+                std::vector<int> cpus = parseCpuList(readLine("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"));
+                if (!cpus.empty()) {
+                    topology.nodes.push_back(std::move(cpus));
+                }
+            }
+        } catch (const std::invalid_argument &) {
+            topology.nodes.clear();
+        }
+#endif
+        if (topology.nodes.empty()) {
+            const int cpus = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+            topology = simulate(1, cpus);
+            topology.simulated = false;
+        }
+        return topology;
+    }
+
+    NumaTopology NumaTopology::simulate(int node_count, int cpus_per_node) {
+        if (node_count <= 0 || cpus_per_node <= 0) {
+            throw std::invalid_argument("NumaTopology::simulate: 节点数和每节点 CPU 数必须为正");
+        }
+        NumaTopology topology;
+        topology.simulated = true;
+        topology.nodes.resize(node_count);
+        for (int node = 0; node < node_count; ++node) {
+            for (int i = 0; i < cpus_per_node; ++i) {
+                topology.nodes[node].push_back(node * cpus_per_node + i);
+            }
+        }
+        return topology;
+    }
+
+    NumaTopology NumaTopology::limit(int cpu_count) const {
+        if (cpu_count <= 0 || cpu_count >= getCpuCount()) {
+            return *this;
+        }
+        NumaTopology topology;
+        topology.simulated = simulated;
+        std::vector<std::vector<int>> kept(nodes.size());
+        int taken = 0;
+        for (size_t index = 0; taken < cpu_count; ++index) {
+            for (size_t node = 0; node < nodes.size() && taken < cpu_count; ++node) {
+                if (index < nodes[node].size()) {
+                    kept[node].push_back(nodes[node][index]);
+                    ++taken;
+                }
+            }
+        }
+        for (std::vector<int> &cpus : kept) {
+            if (!cpus.empty()) {
+                topology.nodes.push_back(std::move(cpus));
+            }
+        }
+        return topology;
+    }
+
+    std::vector<int> NumaTopology::parseCpuList(const std::string &text) {
+        std::vector<int> cpus;
+        std::istringstream ranges(text);
+        std::string range;
+        while (std::getline(ranges, range, ',')) {
+            range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+            if (range.empty()) {
+                continue;
+            }
+            const size_t dash = range.find('-');
+            try {
+                size_t consumed = 0;
+                const int first = std::stoi(range.substr(0, dash), &consumed);
+                int last = first;
+                if (dash != std::string::npos) {
+                    last = std::stoi(range.substr(dash + 1), &consumed);
+                    consumed += dash + 1;
+                }
+                if (consumed != range.size() || first < 0 || last < first) {
+                    throw std::invalid_argument(range);
+                }
+                for (int cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            } catch (const std::logic_error &) {
+                throw std::invalid_argument("cpulist 格式错误: " + text);
+            }
+        }
+        return cpus;
+    }
+
+} // namespace SoftRenderer
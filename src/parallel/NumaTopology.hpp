@@ -0,0 +1,52 @@
+//
+//  NumaTopology.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef NumaTopology_hpp
+#define NumaTopology_hpp
+
+#include <string>
+#include <vector>
+
+/**
+ * NUMA 拓扑：每个节点包含哪些 CPU。多路服务器上，线程访问另一个节点上的内存要经过节点间互联，
+ * 带宽更低、延迟更高；WorkerPool 按节点对工作线程分组，帧缓冲和临时缓冲由所属节点的线程首次触碰
+ * （Linux 默认的 first-touch 策略会把物理页分配在首次写入它的 CPU 所在节点上）。
+ *
+ * 单节点的开发机上可以用 simulate() 构造模拟拓扑，调度（本节点优先、再跨节点窃取）的行为与真实多节点一致，
+ * 只是内存实际上都在同一个节点。
+ */
+namespace SoftRenderer {
+
+    struct NumaTopology {
+        std::vector<std::vector<int>> nodes; // nodes[i] 为节点 i 的 CPU 编号
+        bool simulated = false;
+
+        int getNodeCount() const { return static_cast<int>(nodes.size()); }
+        int getCpuCount() const;
+
+        /**
+         * 读取本机拓扑（Linux：/sys/devices/system/node/node<i>/cpulist）。
+         * 读取失败或非 Linux 时返回单节点，包含 hardware_concurrency 个 CPU。
+         */
+        static NumaTopology detect();
+
+        // 模拟拓扑：node_count 个节点，每个节点 cpus_per_node 个 CPU，编号连续（绑核时对实际 CPU 数取模）
+        static NumaTopology simulate(int node_count, int cpus_per_node);
+
+        /**
+         * 只保留 cpu_count 个 CPU 的拓扑（AutoTuner 调优的工作线程数）：各节点轮流取一个 CPU，节点间的线程数尽量均衡，
+         * 没有 CPU 的节点去掉。cpu_count ≤ 0 或不少于现有 CPU 数时返回原拓扑。
+         */
+        NumaTopology limit(int cpu_count) const;
+
+        // 解析 cpulist 格式（如 "0-3,8-11"），格式错误抛出 std::invalid_argument
+        static std::vector<int> parseCpuList(const std::string &text);
+    };
+
+} // namespace SoftRenderer
+
+#endif /* NumaTopology_hpp */
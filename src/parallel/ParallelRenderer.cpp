@@ -0,0 +1,149 @@
+//
+//  ParallelRenderer.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include "ParallelRenderer.hpp"
+
+namespace SoftRenderer {
+
+    NodeLocalFrameBuffer::NodeLocalFrameBuffer(int width, int height, WorkerPool &pool, int band_rows)
+        : band_rows_(band_rows),
+          band_count_(band_rows > 0 && height > 0 ? (height + band_rows - 1) / band_rows : 0),
+          node_count_(pool.getNodeCount()),
+          pixels_(width > 0 && height > 0 ? new unsigned char[static_cast<size_t>(width) * height * sizeof(Color)] : nullptr),
+          frame_buffer_(width, height, pixels_.get(), static_cast<size_t>(std::max(width, 0)) * sizeof(Color)) {
+        if (band_rows_ <= 0) {
+            throw std::invalid_argument("NodeLocalFrameBuffer: 条带高度必须大于0");
+        }
+        // 首次触碰：每个条带只由所属节点的线程清零，禁止窃取
+        const size_t row_bytes = static_cast<size_t>(width) * sizeof(Color);
+        pool.run(static_cast<size_t>(band_count_),
+                 [this](size_t band) { return getBandNode(static_cast<int>(band)); },
+                 [&](size_t band, int) {
+                     const int y0 = static_cast<int>(band) * band_rows_;
+                     const int y1 = std::min(y0 + band_rows_, height);
+                     std::memset(pixels_.get() + static_cast<size_t>(y0) * row_bytes, 0, static_cast<size_t>(y1 - y0) * row_bytes);
+                 }, false);
+    }
+
+    ParallelRenderer::ParallelRenderer(WorkerPool &pool) : pool_(pool), rasterizers_(pool.getWorkerCount()) {
+        pool_.runOnEachWorker([this](int worker) { rasterizers_[worker].reset(new Rasterizer()); });
+    }
+
+    void ParallelRenderer::drawTexturedTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2,
+                                                const YUVTexture &texture) {
+        Triangle triangle;
+        triangle.v0 = v0;
+        triangle.v1 = v1;
+        triangle.v2 = v2;
+        triangle.texture = &texture;
+        submit(triangle);
+    }
+
+    void ParallelRenderer::drawSolidTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Color &color) {
+        Triangle triangle;
+        triangle.v0 = v0;
+        triangle.v1 = v1;
+        triangle.v2 = v2;
+        triangle.color = color;
+        submit(triangle);
+    }
+
+    void ParallelRenderer::submit(const Triangle &triangle) {
+        // 帧缓冲高度在 render 时才确定，分箱推迟到 render
+        triangles_.push_back(triangle);
+    }
+
+    void ParallelRenderer::clearTriangles() {
+        triangles_.clear();
+        binned_count_ = 0;
+        for (std::vector<uint32_t> &bin : bins_) {
+            bin.clear();
+        }
+    }
+
+    void ParallelRenderer::setColorLUT(const ColorLUT *lut) {
+        for (std::unique_ptr<Rasterizer> &rasterizer : rasterizers_) {
+            rasterizer->setColorLUT(lut);
+        }
+    }
+
+    void ParallelRenderer::rebin(int height, int band_rows) {
+        if (height != binned_height_ || band_rows != binned_rows_) {
+            binned_height_ = height;
+            binned_rows_ = band_rows;
+            binned_count_ = 0;
+            bins_.assign((height + band_rows - 1) / band_rows, std::vector<uint32_t>());
+        }
+        // 只需为上次 render 之后提交的三角形分箱；与 Rasterizer 相同的包围盒取整方式
+        for (; binned_count_ < triangles_.size(); ++binned_count_) {
+            const Triangle &triangle = triangles_[binned_count_];
+            int min_y = static_cast<int>(std::floor(std::min({triangle.v0.y, triangle.v1.y, triangle.v2.y})));
+            int max_y = static_cast<int>(std::ceil(std::max({triangle.v0.y, triangle.v1.y, triangle.v2.y})));
+            min_y = std::max(min_y, 0);
+            max_y = std::min(max_y, height - 1);
+            for (int band = min_y / band_rows; min_y <= max_y && band <= max_y / band_rows; ++band) {
+                bins_[band].push_back(static_cast<uint32_t>(binned_count_));
+            }
+        }
+    }
+
+    void ParallelRenderer::renderBands(FrameBuffer &target, const Color &clear_color, int band_rows,
+                                       const std::function<int(size_t)> &band_node) {
+        const int width = target.getWidth();
+        const int height = target.getHeight();
+        rebin(height, band_rows);
+
+        // 惰性清屏的 Tile 状态是共享的，不能被多个线程同时落地：先在调用线程上放弃所有待清除 Tile，
+        // 之后每个条带自己填充清屏色，工作线程之间只写互不重叠的行
+        for (int ty = 0; ty < target.getClearTilesY(); ++ty) {
+            for (int tx = 0; tx < target.getClearTilesX(); ++tx) {
+                target.discardTileClear(tx, ty);
+            }
+        }
+
+        pool_.run(bins_.size(), band_node, [&](size_t band, int worker) {
+            const int y0 = static_cast<int>(band) * band_rows;
+            const int y1 = std::min(y0 + band_rows, height);
+            for (int y = y0; y < y1; ++y) {
+                target.fillSpan(y, 0, width, clear_color);
+            }
+
+            Rasterizer &rasterizer = *rasterizers_[worker];
+            rasterizer.setScissor(Rect(0, y0, width, y1 - y0));
+            for (uint32_t index : bins_[band]) {
+                const Triangle &tri = triangles_[index];
+                if (tri.texture) {
+                    rasterizer.drawTexturedTriangle(target, tri.v0, tri.v1, tri.v2, *tri.texture);
+                } else {
+                    rasterizer.drawSolidTriangle(target, tri.v0, tri.v1, tri.v2, tri.color);
+                }
+            }
+            rasterizer.clearScissor();
+        });
+    }
+
+    void ParallelRenderer::render(NodeLocalFrameBuffer &target, const Color &clear_color) {
+        renderBands(target.get(), clear_color, target.getBandRows(),
+                    [&target](size_t band) { return target.getBandNode(static_cast<int>(band)); });
+    }
+
+    void ParallelRenderer::render(FrameBuffer &target, const Color &clear_color, int band_rows) {
+        if (band_rows <= 0) {
+            throw std::invalid_argument("ParallelRenderer::render: 条带高度必须大于0");
+        }
+        const int band_count = (target.getHeight() + band_rows - 1) / band_rows;
+        const int node_count = pool_.getNodeCount();
+        renderBands(target, clear_color, band_rows, [band_count, node_count](size_t band) {
+            return static_cast<int>(static_cast<int64_t>(band) * node_count / band_count);
+        });
+    }
+
+} // namespace SoftRenderer
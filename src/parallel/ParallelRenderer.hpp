@@ -0,0 +1,100 @@
+//
+//  ParallelRenderer.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef ParallelRenderer_hpp
+#define ParallelRenderer_hpp
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "WorkerPool.hpp"
+#include "rasterization/Rasterizer.hpp"
+
+/**
+ * 多线程条带渲染：与 BandRenderer 相同的按 y 分箱，但整张帧缓冲常驻内存，各条带由 WorkerPool 并行绘制。
+ *
+ * 条带按行号连续地分给各 NUMA 节点（节点 0 负责最上面的若干条带，依此类推）。
+ * NodeLocalFrameBuffer 的像素内存由各条带所属节点的线程首次写入，物理页因此落在该节点上；
+ * 之后每帧的条带任务也优先交给同一节点的线程，只有本节点任务领完时才跨节点窃取。
+ */
+namespace SoftRenderer {
+
+    /**
+     * 按节点就近放置的帧缓冲：分配时不初始化，由 pool 中各节点的线程逐条带清零（首次触碰），
+     * 之后通过 get() 作为普通 FrameBuffer 使用。
+     */
+    class NodeLocalFrameBuffer {
+    public:
+        NodeLocalFrameBuffer(int width, int height, WorkerPool &pool, int band_rows = 64);
+
+        FrameBuffer &get() { return frame_buffer_; }
+        const FrameBuffer &get() const { return frame_buffer_; }
+
+        int getBandRows() const { return band_rows_; }
+        int getBandCount() const { return band_count_; }
+        int getNodeCount() const { return node_count_; }
+
+        // 条带 band 的像素所在节点
+        int getBandNode(int band) const { return static_cast<int>(static_cast<int64_t>(band) * node_count_ / band_count_); }
+
+    private:
+        int band_rows_, band_count_, node_count_;
+        std::unique_ptr<unsigned char[]> pixels_; // 故意不做值初始化，首次写入发生在工作线程中
+        FrameBuffer frame_buffer_;
+    };
+
+    class ParallelRenderer {
+    public:
+        // 每个工作线程在自己的线程上创建各自的 Rasterizer；pool 需存活到 ParallelRenderer 析构
+        explicit ParallelRenderer(WorkerPool &pool);
+
+        // 提交三角形（全图坐标），纹理需存活到 render 结束；纹理在渲染期间只读，可以被多个线程同时采样
+        void drawTexturedTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const YUVTexture &texture);
+        void drawSolidTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Color &color);
+
+        // 清空已提交的三角形，开始新的一帧
+        void clearTriangles();
+
+        // 并行渲染到按节点放置的帧缓冲，条带划分与其首次触碰时一致
+        void render(NodeLocalFrameBuffer &target, const Color &clear_color = Color(0, 0, 0));
+
+        // 并行渲染到普通帧缓冲：条带高度 band_rows，条带按行号连续地分给各节点
+        void render(FrameBuffer &target, const Color &clear_color = Color(0, 0, 0), int band_rows = 64);
+
+        // 设置 3D LUT 调色（见 Rasterizer::setColorLUT），作用于所有工作线程，lut 需存活到 render 结束
+        void setColorLUT(const ColorLUT *lut);
+
+        // 上一次 render 中在本节点执行 / 被其他节点窃取的条带数
+        WorkerPool::RunStats getLastRunStats() const { return pool_.getLastRunStats(); }
+
+    private:
+        struct Triangle {
+            Vertex v0, v1, v2;
+            const YUVTexture *texture = nullptr; // nullptr 表示纯色
+            Color color;
+        };
+
+        void submit(const Triangle &triangle);
+
+        // 按 band_rows 重新分箱（条带高度与上次不同时）
+        void rebin(int height, int band_rows);
+
+        void renderBands(FrameBuffer &target, const Color &clear_color, int band_rows,
+                         const std::function<int(size_t)> &band_node);
+
+        WorkerPool &pool_;
+        std::vector<std::unique_ptr<Rasterizer>> rasterizers_; // 每个工作线程一个
+        std::vector<Triangle> triangles_;
+
+        int binned_height_ = 0, binned_rows_ = 0;
+        size_t binned_count_ = 0;                 // 已分箱的三角形数
+        std::vector<std::vector<uint32_t>> bins_; // 每个条带内按提交顺序排列的三角形下标
+    };
+
+} // namespace SoftRenderer
+
+#endif /* ParallelRenderer_hpp */
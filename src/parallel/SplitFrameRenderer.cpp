@@ -0,0 +1,398 @@
+//
+//  SplitFrameRenderer.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <cmath>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include "SplitFrameRenderer.hpp"
+
+namespace SoftRenderer {
+
+    namespace {
+        enum MessageType : uint32_t {
+            kFrame = 1,    // 协调者 → 工作进程：一帧的场景
+            kShutdown = 2, // 协调者 → 工作进程：退出
+            kDone = 3,     // 工作进程 → 协调者：区域已完成，负载为帧号
+            kError = 4,    // 工作进程 → 协调者：渲染失败，负载为错误信息
+        };
+
+        struct MessageHeader {
+            uint32_t type;
+            uint32_t size; // 负载字节数
+        };
+
+        struct FrameHeader {
+            uint64_t frame;
+            int32_t region[4]; // x, y, width, height
+            uint8_t clear[4];
+            uint32_t texture_count;  // 本消息中新增的纹理引用数
+            uint32_t triangle_count;
+        };
+
+        struct TextureHeader {
+            int32_t id, width, height, frame_index, filter;
+            uint32_t name_length;
+        };
+
+#if defined(MSG_NOSIGNAL)
+        constexpr int kSendFlags = MSG_NOSIGNAL; // 对端已退出时返回 EPIPE 而不是触发 SIGPIPE
+#else
+        constexpr int kSendFlags = 0;
+#endif
+
+        bool writeAll(int socket, const void *data, size_t size) {
+            const char *bytes = static_cast<const char *>(data);
+            while (size > 0) {
+                const ssize_t written = send(socket, bytes, size, kSendFlags);
+                if (written < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (written <= 0) {
+                    return false;
+                }
+                bytes += written;
+                size -= static_cast<size_t>(written);
+            }
+            return true;
+        }
+
+        // 读满 size 字节；对端关闭或出错时返回 false
+        bool readAll(int socket, void *data, size_t size) {
+            char *bytes = static_cast<char *>(data);
+            while (size > 0) {
+                const ssize_t got = recv(socket, bytes, size, 0);
+                if (got < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (got <= 0) {
+                    return false;
+                }
+                bytes += got;
+                size -= static_cast<size_t>(got);
+            }
+            return true;
+        }
+
+        bool sendMessage(int socket, uint32_t type, const void *payload, size_t size) {
+            const MessageHeader header{type, static_cast<uint32_t>(size)};
+            return writeAll(socket, &header, sizeof(header)) && (size == 0 || writeAll(socket, payload, size));
+        }
+
+        template <typename T>
+        void append(std::vector<unsigned char> &out, const T &value) {
+            const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+
+        // 按顺序读取负载，越界时抛出 std::runtime_error
+        class PayloadReader {
+        public:
+            explicit PayloadReader(const std::vector<unsigned char> &data) : data_(data) {}
+
+            template <typename T>
+            T read() {
+                T value;
+                std::memcpy(&value, take(sizeof(T)), sizeof(T));
+                return value;
+            }
+
+            const unsigned char *take(size_t size) {
+                if (size > data_.size() - offset_) {
+                    throw std::runtime_error("SplitFrameRenderer: 场景消息不完整");
+                }
+                const unsigned char *p = data_.data() + offset_;
+                offset_ += size;
+                return p;
+            }
+
+        private:
+            const std::vector<unsigned char> &data_;
+            size_t offset_ = 0;
+        };
+    }
+
+    SplitFrameRenderer::SplitFrameRenderer(int width, int height, int worker_count)
+        : width_(width), height_(height) {
+        if (width_ <= 0 || height_ <= 0 || worker_count <= 0 || worker_count > height_) {
+            throw std::invalid_argument("SplitFrameRenderer: 尺寸必须大于0，工作进程数必须在 [1, height] 之内");
+        }
+        bytes_ = static_cast<size_t>(width_) * height_ * sizeof(Color);
+        void *mapping = mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error(std::string("SplitFrameRenderer: 共享内存分配失败: ") + std::strerror(errno));
+        }
+        pixels_ = static_cast<unsigned char *>(mapping);
+        frame_buffer_.reset(new FrameBuffer(width_, height_, pixels_, static_cast<size_t>(width_) * sizeof(Color)));
+
+        for (int i = 0; i < worker_count; ++i) {
+            Worker worker;
+            const int y0 = static_cast<int>(static_cast<int64_t>(height_) * i / worker_count);
+            const int y1 = static_cast<int>(static_cast<int64_t>(height_) * (i + 1) / worker_count);
+            worker.region = Rect(0, y0, width_, y1 - y0);
+
+            int sockets[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0) {
+                const std::string reason = std::strerror(errno);
+                shutdownWorkers();
+                munmap(pixels_, bytes_);
+                throw std::runtime_error("SplitFrameRenderer: socketpair 失败: " + reason);
+            }
+            const pid_t pid = fork();
+            if (pid < 0) {
+                const std::string reason = std::strerror(errno);
+                close(sockets[0]);
+                close(sockets[1]);
+                shutdownWorkers();
+                munmap(pixels_, bytes_);
+                throw std::runtime_error("SplitFrameRenderer: fork 失败: " + reason);
+            }
+            if (pid == 0) {
+                // 子进程：关闭协调者一端和之前工作进程的 socket，否则协调者退出时其他工作进程收不到 EOF
+                close(sockets[0]);
+                for (const Worker &previous : workers_) {
+                    close(previous.socket);
+                }
+                workerMain(sockets[1], pixels_, width_, height_);
+            }
+            close(sockets[1]);
+            worker.pid = pid;
+            worker.socket = sockets[0];
+            workers_.push_back(worker);
+        }
+    }
+
+    SplitFrameRenderer::~SplitFrameRenderer() {
+        shutdownWorkers();
+        if (pixels_) {
+            munmap(pixels_, bytes_);
+        }
+    }
+
+    void SplitFrameRenderer::shutdownWorkers() {
+        for (Worker &worker : workers_) {
+            sendMessage(worker.socket, kShutdown, nullptr, 0);
+            close(worker.socket);
+        }
+        for (Worker &worker : workers_) {
+            int status = 0;
+            while (waitpid(worker.pid, &status, 0) < 0 && errno == EINTR) {
+            }
+        }
+        workers_.clear();
+    }
+
+    int SplitFrameRenderer::addTexture(const std::string &filename, int width, int height, int frame_index,
+                                       TextureFilter filter) {
+        TextureRef ref;
+        ref.filename = filename;
+        ref.width = width;
+        ref.height = height;
+        ref.frame_index = frame_index;
+        ref.filter = filter;
+        textures_.push_back(ref);
+        return static_cast<int>(textures_.size()) - 1;
+    }
+
+    void SplitFrameRenderer::drawTexturedTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, int texture) {
+        if (texture < 0 || texture >= static_cast<int>(textures_.size())) {
+            throw std::invalid_argument("SplitFrameRenderer::drawTexturedTriangle: 未注册的纹理编号");
+        }
+        WireTriangle triangle;
+        const Vertex *vertices[3] = {&v0, &v1, &v2};
+        for (int i = 0; i < 3; ++i) {
+            triangle.v[i][0] = vertices[i]->x;
+            triangle.v[i][1] = vertices[i]->y;
+            triangle.v[i][2] = vertices[i]->u;
+            triangle.v[i][3] = vertices[i]->v;
+        }
+        triangle.texture = texture;
+        triangles_.push_back(triangle);
+    }
+
+    void SplitFrameRenderer::drawSolidTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Color &color) {
+        WireTriangle triangle;
+        const Vertex *vertices[3] = {&v0, &v1, &v2};
+        for (int i = 0; i < 3; ++i) {
+            triangle.v[i][0] = vertices[i]->x;
+            triangle.v[i][1] = vertices[i]->y;
+            triangle.v[i][2] = vertices[i]->u;
+            triangle.v[i][3] = vertices[i]->v;
+        }
+        triangle.color[0] = color.r;
+        triangle.color[1] = color.g;
+        triangle.color[2] = color.b;
+        triangles_.push_back(triangle);
+    }
+
+    void SplitFrameRenderer::clearTriangles() {
+        triangles_.clear();
+    }
+
+    void SplitFrameRenderer::render(const Color &clear_color) {
+        if (failed_) {
+            throw std::runtime_error("SplitFrameRenderer: 之前的渲染失败，工作进程状态未知");
+        }
+        const uint64_t frame = frame_index_++;
+        last_scene_bytes_ = 0;
+
+        // 1. 按区域分箱并发送（与 Rasterizer 相同的包围盒取整方式判断三角形落在哪些行）
+        std::vector<unsigned char> payload;
+        std::vector<const WireTriangle *> selected;
+        for (Worker &worker : workers_) {
+            selected.clear();
+            for (const WireTriangle &triangle : triangles_) {
+                const int min_y = static_cast<int>(std::floor(std::min({triangle.v[0][1], triangle.v[1][1], triangle.v[2][1]})));
+                const int max_y = static_cast<int>(std::ceil(std::max({triangle.v[0][1], triangle.v[1][1], triangle.v[2][1]})));
+                if (max_y >= worker.region.y && min_y < worker.region.bottom()) {
+                    selected.push_back(&triangle);
+                }
+            }
+
+            FrameHeader header{};
+            header.frame = frame;
+            header.region[0] = worker.region.x;
+            header.region[1] = worker.region.y;
+            header.region[2] = worker.region.width;
+            header.region[3] = worker.region.height;
+            header.clear[0] = clear_color.r;
+            header.clear[1] = clear_color.g;
+            header.clear[2] = clear_color.b;
+            header.texture_count = static_cast<uint32_t>(textures_.size() - worker.textures_sent);
+            header.triangle_count = static_cast<uint32_t>(selected.size());
+
+            payload.clear();
+            append(payload, header);
+            for (size_t id = worker.textures_sent; id < textures_.size(); ++id) {
+                const TextureRef &ref = textures_[id];
+                const TextureHeader texture{static_cast<int32_t>(id), ref.width, ref.height, ref.frame_index,
+                                            static_cast<int32_t>(ref.filter), static_cast<uint32_t>(ref.filename.size())};
+                append(payload, texture);
+                payload.insert(payload.end(), ref.filename.begin(), ref.filename.end());
+            }
+            for (const WireTriangle *triangle : selected) {
+                append(payload, *triangle);
+            }
+            if (!sendMessage(worker.socket, kFrame, payload.data(), payload.size())) {
+                failed_ = true;
+                throw std::runtime_error("SplitFrameRenderer: 无法向工作进程 " + std::to_string(worker.pid) + " 发送场景");
+            }
+            worker.textures_sent = textures_.size();
+            last_scene_bytes_ += sizeof(MessageHeader) + payload.size();
+        }
+
+        // 2. 等待所有区域完成（先收齐所有回复，再报告第一个错误）
+        std::string error;
+        for (Worker &worker : workers_) {
+            MessageHeader header{};
+            std::vector<unsigned char> reply;
+            if (!readAll(worker.socket, &header, sizeof(header))) {
+                error = error.empty() ? "工作进程 " + std::to_string(worker.pid) + " 意外退出" : error;
+                continue;
+            }
+            reply.resize(header.size);
+            if (header.size > 0 && !readAll(worker.socket, reply.data(), reply.size())) {
+                error = error.empty() ? "工作进程 " + std::to_string(worker.pid) + " 意外退出" : error;
+                continue;
+            }
+            if (header.type == kError) {
+                error = error.empty() ? "工作进程 " + std::to_string(worker.pid) + ": " + std::string(reply.begin(), reply.end()) : error;
+            } else if (header.type != kDone || reply.size() != sizeof(uint64_t) ||
+                       PayloadReader(reply).read<uint64_t>() != frame) {
+                error = error.empty() ? "工作进程 " + std::to_string(worker.pid) + " 的回复无效" : error;
+            }
+        }
+        if (!error.empty()) {
+            failed_ = true;
+            throw std::runtime_error("SplitFrameRenderer: " + error);
+        }
+    }
+
+    void SplitFrameRenderer::workerMain(int socket, unsigned char *pixels, int width, int height) {
+        FrameBuffer fb(width, height, pixels, static_cast<size_t>(width) * sizeof(Color));
+        Rasterizer rasterizer;
+        std::vector<TextureRef> refs;
+        std::vector<std::unique_ptr<YUVTexture>> textures; // 第一次使用时按引用加载
+        std::vector<unsigned char> payload;
+
+        while (true) {
+            MessageHeader header{};
+            if (!readAll(socket, &header, sizeof(header)) || header.type == kShutdown) {
+                _exit(0); // 协调者已退出或要求退出；_exit 不执行从父进程继承的析构和 atexit
+            }
+            payload.resize(header.size);
+            if (header.size > 0 && !readAll(socket, payload.data(), payload.size())) {
+                _exit(0);
+            }
+
+            try {
+                if (header.type != kFrame) {
+                    throw std::runtime_error("未知消息类型 " + std::to_string(header.type));
+                }
+                PayloadReader reader(payload);
+                const FrameHeader frame = reader.read<FrameHeader>();
+                for (uint32_t i = 0; i < frame.texture_count; ++i) {
+                    const TextureHeader texture = reader.read<TextureHeader>();
+                    const unsigned char *name = reader.take(texture.name_length);
+                    if (texture.id < 0) {
+                        throw std::runtime_error("纹理编号无效");
+                    }
+                    TextureRef ref;
+                    ref.filename.assign(reinterpret_cast<const char *>(name), texture.name_length);
+                    ref.width = texture.width;
+                    ref.height = texture.height;
+                    ref.frame_index = texture.frame_index;
+                    ref.filter = static_cast<TextureFilter>(texture.filter);
+                    refs.resize(std::max(refs.size(), static_cast<size_t>(texture.id) + 1));
+                    textures.resize(refs.size());
+                    refs[texture.id] = ref;
+                }
+
+                const Rect region(frame.region[0], frame.region[1], frame.region[2], frame.region[3]);
+                fb.clearRect(region, Color(frame.clear[0], frame.clear[1], frame.clear[2]));
+                rasterizer.setScissor(region);
+                for (uint32_t i = 0; i < frame.triangle_count; ++i) {
+                    const WireTriangle triangle = reader.read<WireTriangle>();
+                    const Vertex v0(triangle.v[0][0], triangle.v[0][1], triangle.v[0][2], triangle.v[0][3]);
+                    const Vertex v1(triangle.v[1][0], triangle.v[1][1], triangle.v[1][2], triangle.v[1][3]);
+                    const Vertex v2(triangle.v[2][0], triangle.v[2][1], triangle.v[2][2], triangle.v[2][3]);
+                    if (triangle.texture < 0) {
+                        rasterizer.drawSolidTriangle(fb, v0, v1, v2, Color(triangle.color[0], triangle.color[1], triangle.color[2]));
+                        continue;
+                    }
+                    if (static_cast<size_t>(triangle.texture) >= refs.size() || refs[triangle.texture].filename.empty()) {
+                        throw std::runtime_error("引用了未定义的纹理 " + std::to_string(triangle.texture));
+                    }
+                    std::unique_ptr<YUVTexture> &texture = textures[triangle.texture];
+                    if (!texture) {
+                        const TextureRef &ref = refs[triangle.texture];
+                        texture.reset(new YUVTexture(ref.filename, ref.width, ref.height, ref.frame_index));
+                        texture->setFilterMode(ref.filter);
+                    }
+                    rasterizer.drawTexturedTriangle(fb, v0, v1, v2, *texture);
+                }
+                rasterizer.clearScissor();
+
+                if (!sendMessage(socket, kDone, &frame.frame, sizeof(frame.frame))) {
+                    _exit(0);
+                }
+            } catch (const std::exception &e) {
+                rasterizer.clearScissor();
+                const std::string message = e.what();
+                if (!sendMessage(socket, kError, message.data(), message.size())) {
+                    _exit(0);
+                }
+            }
+        }
+    }
+
+} // namespace SoftRenderer
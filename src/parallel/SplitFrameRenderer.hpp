@@ -0,0 +1,120 @@
+//
+//  SplitFrameRenderer.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef SplitFrameRenderer_hpp
+#define SplitFrameRenderer_hpp
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <sys/types.h>
+#include "rasterization/Rasterizer.hpp"
+
+/**
+ * 多进程分屏渲染（Split-Frame Rendering）：超大拼接屏输出一个进程画不过来时，由协调者把帧缓冲按行切成若干区域，
+ * 每个区域交给一个本机工作进程光栅化。
+ *
+ * 构造：协调者分配共享内存帧缓冲（MAP_SHARED），fork 出 worker_count 个工作进程，每个进程一对 Unix socket
+ *     ↓
+ * 每帧 render()：
+ *     ├── 三角形按区域分箱，场景（屏幕空间顶点、纹理引用、清屏色）序列化后经 socket 发给各工作进程
+ *     ├── 工作进程在共享帧缓冲上清除并绘制自己的区域（裁剪矩形 = 区域），完成后回复
+ *     └── 协调者等到所有区域完成，帧缓冲中即为拼好的整帧：像素不经过 socket，也没有拼接拷贝
+ *
+ * 纹理按引用传递（文件路径 + 尺寸 + 帧号 + 过滤方式），工作进程第一次用到时自己加载并缓存。
+ * 顶点是顶点着色器（及 uniforms）处理之后的屏幕空间坐标，uniforms 不单独传输。
+ * 工作进程由 fork 产生：应在启动其他线程之前构造 SplitFrameRenderer（fork 只复制调用线程）。
+ */
+namespace SoftRenderer {
+
+    class SplitFrameRenderer {
+    public:
+        /**
+         * @param width 输出宽度
+         * @param height 输出高度
+         * @param worker_count 工作进程数（区域数），不超过 height
+         * 共享内存或进程创建失败时抛出 std::runtime_error。
+         */
+        SplitFrameRenderer(int width, int height, int worker_count);
+
+        // 通知所有工作进程退出并回收，释放共享内存
+        ~SplitFrameRenderer();
+
+        SplitFrameRenderer(const SplitFrameRenderer &) = delete;
+        SplitFrameRenderer &operator=(const SplitFrameRenderer &) = delete;
+
+        // 注册纹理引用，返回纹理编号；工作进程按引用自行加载（文件需对工作进程可读）
+        int addTexture(const std::string &filename, int width, int height, int frame_index = 0,
+                       TextureFilter filter = TextureFilter::NEAREST);
+
+        // 提交三角形（全图坐标），texture 为 addTexture 返回的编号
+        void drawTexturedTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, int texture);
+        void drawSolidTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Color &color);
+
+        // 清空已提交的三角形，开始新的一帧
+        void clearTriangles();
+
+        /**
+         * 分发本帧并阻塞到所有区域完成。工作进程报告错误（如纹理加载失败）或意外退出时抛出 std::runtime_error，
+         * 之后该对象不能再渲染。
+         */
+        void render(const Color &clear_color = Color(0, 0, 0));
+
+        // 共享内存上的整帧结果（render 返回后有效）
+        FrameBuffer &getFrameBuffer() { return *frame_buffer_; }
+        const FrameBuffer &getFrameBuffer() const { return *frame_buffer_; }
+
+        int getWorkerCount() const { return static_cast<int>(workers_.size()); }
+        const Rect &getRegion(int worker) const { return workers_[worker].region; }
+        pid_t getWorkerPid(int worker) const { return workers_[worker].pid; }
+
+        // 上一帧发给各工作进程的字节数之和（场景数据量）
+        size_t getLastSceneBytes() const { return last_scene_bytes_; }
+
+    private:
+        struct TextureRef {
+            std::string filename;
+            int width = 0, height = 0, frame_index = 0;
+            TextureFilter filter = TextureFilter::NEAREST;
+        };
+
+        // 线上格式的三角形（平凡可复制）
+        struct WireTriangle {
+            float v[3][4];        // x, y, u, v
+            int32_t texture = -1; // -1 表示纯色
+            uint8_t color[4] = {0, 0, 0, 0};
+        };
+
+        struct Worker {
+            pid_t pid = -1;
+            int socket = -1;
+            Rect region;
+            size_t textures_sent = 0; // 已发送过的纹理引用数
+        };
+
+        // 工作进程主循环（在子进程中运行，不返回）
+        [[noreturn]] static void workerMain(int socket, unsigned char *pixels, int width, int height);
+
+        void shutdownWorkers();
+
+        int width_, height_;
+        size_t bytes_ = 0;
+        unsigned char *pixels_ = nullptr; // 共享内存映射
+        std::unique_ptr<FrameBuffer> frame_buffer_;
+
+        std::vector<Worker> workers_;
+        std::vector<TextureRef> textures_;
+        std::vector<WireTriangle> triangles_;
+        uint64_t frame_index_ = 0;
+        size_t last_scene_bytes_ = 0;
+        bool failed_ = false;
+    };
+
+} // namespace SoftRenderer
+
+#endif /* SplitFrameRenderer_hpp */
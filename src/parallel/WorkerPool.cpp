@@ -0,0 +1,184 @@
+//
+//  WorkerPool.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <algorithm>
+#include <stdexcept>
+#include "WorkerPool.hpp"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace SoftRenderer {
+
+    namespace {
+        /**
+         * 把调用线程绑定到 cpu，失败时保持不绑定。模拟拓扑的编号不是真实 CPU，对实际 CPU 数取模；
+         * 真实拓扑直接使用检测到的编号。目标 CPU 不在进程的亲和性掩码内（taskset、cgroup cpuset）时不绑定。
+         */
+        void pinCurrentThread(int cpu, bool simulated) {
+#if defined(__linux__)
+            if (simulated) {
+                cpu %= static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+            }
+            // 工作线程的亲和性掩码继承自创建它的线程，即进程允许使用的 CPU
+            cpu_set_t allowed;
+            CPU_ZERO(&allowed);
+            if (cpu < 0 || cpu >= CPU_SETSIZE || sched_getaffinity(0, sizeof(allowed), &allowed) != 0 ||
+                !CPU_ISSET(cpu, &allowed)) {
+                return;
+            }
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+            (void)cpu;
+            (void)simulated;
+#endif
+        }
+    }
+
+    WorkerPool::WorkerPool(const NumaTopology &topology, bool pin_threads)
+        : topology_(topology), queues_(std::max(1, topology.getNodeCount())) {
+        if (topology_.getCpuCount() == 0) {
+            throw std::invalid_argument("WorkerPool: 拓扑中没有 CPU");
+        }
+        // 先确定每个工作线程的节点，再启动线程（线程启动后会读取 worker_node_）
+        std::vector<int> worker_cpu;
+        for (int node = 0; node < topology_.getNodeCount(); ++node) {
+            for (int cpu : topology_.nodes[node]) {
+                worker_node_.push_back(node);
+                worker_cpu.push_back(cpu);
+            }
+        }
+        workers_.reserve(worker_cpu.size());
+        for (size_t worker = 0; worker < worker_cpu.size(); ++worker) {
+            const int cpu = worker_cpu[worker];
+            workers_.emplace_back([this, worker, cpu, pin_threads] { workerLoop(static_cast<int>(worker), cpu, pin_threads); });
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        batch_ready_.notify_all();
+        for (std::thread &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    bool WorkerPool::claim(int node, size_t &task) {
+        NodeQueue &queue = queues_[node];
+        if (queue.next.load(std::memory_order_relaxed) >= queue.tasks.size()) {
+            return false;
+        }
+        const size_t index = queue.next.fetch_add(1, std::memory_order_relaxed);
+        if (index >= queue.tasks.size()) {
+            return false;
+        }
+        task = queue.tasks[index];
+        return true;
+    }
+
+    void WorkerPool::workerLoop(int worker, int cpu, bool pin) {
+        if (pin) {
+            pinCurrentThread(cpu, topology_.simulated);
+        }
+        const int node = worker_node_[worker];
+        const int node_count = static_cast<int>(queues_.size());
+        uint64_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                batch_ready_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) {
+                    return;
+                }
+                seen = generation_;
+            }
+
+            try {
+                if (per_worker_) {
+                    (*per_worker_fn_)(worker);
+                } else {
+                    size_t task = 0;
+                    // 先领取本节点的任务，再按节点顺序窃取
+                    while (claim(node, task)) {
+                        (*body_)(task, worker);
+                        local_tasks_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    for (int step = 1; allow_steal_ && step < node_count; ++step) {
+                        const int victim = (node + step) % node_count;
+                        while (claim(victim, task)) {
+                            (*body_)(task, worker);
+                            stolen_tasks_.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--active_workers_ == 0) {
+                batch_done_.notify_all();
+            }
+        }
+    }
+
+    void WorkerPool::dispatch(bool per_worker) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        per_worker_ = per_worker;
+        error_ = nullptr;
+        local_tasks_.store(0, std::memory_order_relaxed);
+        stolen_tasks_.store(0, std::memory_order_relaxed);
+        active_workers_ = workers_.size();
+        ++generation_;
+        batch_ready_.notify_all();
+        batch_done_.wait(lock, [this] { return active_workers_ == 0; });
+
+        stats_.local_tasks = local_tasks_.load(std::memory_order_relaxed);
+        stats_.stolen_tasks = stolen_tasks_.load(std::memory_order_relaxed);
+        if (error_) {
+            std::exception_ptr error = error_;
+            error_ = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    void WorkerPool::run(size_t task_count, const std::function<int(size_t)> &task_node,
+                         const std::function<void(size_t, int)> &body, bool allow_steal) {
+        const int node_count = static_cast<int>(queues_.size());
+        for (NodeQueue &queue : queues_) {
+            queue.tasks.clear();
+            queue.next.store(0, std::memory_order_relaxed);
+        }
+        for (size_t task = 0; task < task_count; ++task) {
+            const int node = task_node(task);
+            if (node < 0 || node >= node_count) {
+                throw std::invalid_argument("WorkerPool::run: 任务的归属节点越界");
+            }
+            queues_[node].tasks.push_back(task);
+        }
+        body_ = &body;
+        allow_steal_ = allow_steal;
+        dispatch(false);
+    }
+
+    void WorkerPool::runOnEachWorker(const std::function<void(int)> &fn) {
+        per_worker_fn_ = &fn;
+        dispatch(true);
+    }
+
+} // namespace SoftRenderer
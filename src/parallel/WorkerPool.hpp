@@ -0,0 +1,108 @@
+//
+//  WorkerPool.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef WorkerPool_hpp
+#define WorkerPool_hpp
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+#include "NumaTopology.hpp"
+
+/**
+ * 按 NUMA 节点分组的工作线程池：拓扑中的每个 CPU 一个工作线程，并绑定到该 CPU（Linux）。
+ *
+ * 调度：每批任务按归属节点分成若干队列，工作线程先领取本节点的任务（访问本节点内存），
+ * 本节点的任务领完后再从其他节点的队列窃取，避免某个节点提前空闲。领取只是对队列下标做原子加法，没有锁。
+ * 首次触碰内存的任务应禁止窃取（allow_steal = false），保证物理页落在正确的节点上。
+ */
+namespace SoftRenderer {
+
+    class WorkerPool {
+    public:
+        /**
+         * @param topology 工作线程的分组；模拟拓扑的 CPU 编号绑核时对实际 CPU 数取模，
+         *                 不在进程亲和性掩码内的 CPU 不绑定
+         * @param pin_threads 是否把工作线程绑定到拓扑中的 CPU（非 Linux 平台忽略）
+         */
+        explicit WorkerPool(const NumaTopology &topology = NumaTopology::detect(), bool pin_threads = true);
+
+        // 结束并回收所有工作线程（run 是阻塞的，析构时没有进行中的批次）
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool &) = delete;
+        WorkerPool &operator=(const WorkerPool &) = delete;
+
+        int getWorkerCount() const { return static_cast<int>(workers_.size()); }
+        int getNodeCount() const { return topology_.getNodeCount(); }
+        int getWorkerNode(int worker) const { return worker_node_[worker]; }
+        const NumaTopology &getTopology() const { return topology_; }
+
+        /**
+         * 执行一批任务并阻塞到全部完成：task_node(i) 返回任务 i 的归属节点，body(i, worker) 在某个工作线程上执行。
+         * 同一批任务不能从工作线程内部再次调用 run。任务抛出的第一个异常在所有任务结束后重新抛出。
+         */
+        void run(size_t task_count, const std::function<int(size_t task)> &task_node,
+                 const std::function<void(size_t task, int worker)> &body, bool allow_steal = true);
+
+        // 在每个工作线程上各执行一次 fn(worker)，用于让工作线程首次触碰（分配）自己的临时缓冲
+        void runOnEachWorker(const std::function<void(int worker)> &fn);
+
+        // 上一批任务中在本节点执行 / 被其他节点窃取的任务数
+        struct RunStats {
+            size_t local_tasks = 0;
+            size_t stolen_tasks = 0;
+        };
+        RunStats getLastRunStats() const { return stats_; }
+
+    private:
+        // 一个节点的任务队列：tasks 在提交时填好，next 为下一个待领取的下标
+        struct NodeQueue {
+            std::vector<size_t> tasks;
+            std::atomic<size_t> next{0};
+        };
+
+        void workerLoop(int worker, int cpu, bool pin);
+
+        // 从 node 的队列领取一个任务，队列为空时返回 false
+        bool claim(int node, size_t &task);
+
+        // 执行一批任务（阻塞）；per_worker 为 true 时每个工作线程执行一次 per_worker_fn
+        void dispatch(bool per_worker);
+
+        NumaTopology topology_;
+        std::vector<std::thread> workers_;
+        std::vector<int> worker_node_;
+        std::vector<NodeQueue> queues_;
+
+        // 当前批次（由 mutex_ 保护的代数发布，工作线程看到新代数后开始工作）
+        std::mutex mutex_;
+        std::condition_variable batch_ready_;
+        std::condition_variable batch_done_;
+        uint64_t generation_ = 0;
+        bool stop_ = false;
+        size_t active_workers_ = 0;
+        bool allow_steal_ = true;
+        bool per_worker_ = false;
+        const std::function<void(size_t, int)> *body_ = nullptr;
+        const std::function<void(int)> *per_worker_fn_ = nullptr;
+
+        std::atomic<size_t> local_tasks_{0};
+        std::atomic<size_t> stolen_tasks_{0};
+        std::exception_ptr error_;
+        RunStats stats_;
+    };
+
+} // namespace SoftRenderer
+
+#endif /* WorkerPool_hpp */
@@ -0,0 +1,201 @@
+//
+//  PostProcessor.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include "PostProcessor.hpp"
+
+namespace SoftRenderer {
+
+    namespace {
+        constexpr int kMaxRadius = 8;
+        constexpr int kWeightOne = 4096; // Q12
+        constexpr int kBlock = 768;      // 行内分块的字节数（256 像素），累加器 3 KB
+    }
+
+    PostProcessor::PostProcessor(const PostProcessSettings &settings) : settings_(settings) {
+        if (!(settings_.sigma > 0.0f) || settings_.amount < 0.0f || !(settings_.threshold > 0.0f)) {
+            throw std::invalid_argument("PostProcessor: sigma、threshold 必须为正，amount 不能为负");
+        }
+        if (!isEnabled()) {
+            return;
+        }
+
+        radius_ = std::clamp(static_cast<int>(std::ceil(2.5f * settings_.sigma)), 1, kMaxRadius);
+
+        // 高斯权重量化为 Q12，舍入误差补到中心权重上，保证总和精确为 1（平坦区域输出不变）
+        std::vector<double> gaussian(2 * radius_ + 1);
+        double sum = 0.0;
+        for (int k = -radius_; k <= radius_; ++k) {
+            gaussian[k + radius_] = std::exp(-(k * k) / (2.0 * settings_.sigma * settings_.sigma));
+            sum += gaussian[k + radius_];
+        }
+        weights_.resize(gaussian.size());
+        int32_t total = 0;
+        for (size_t i = 0; i < gaussian.size(); ++i) {
+            weights_[i] = static_cast<int32_t>(std::lround(gaussian[i] / sum * kWeightOne));
+            total += weights_[i];
+        }
+        weights_[radius_] += kWeightOne - total;
+
+        amount_q8_ = static_cast<int>(std::lround(std::min(settings_.amount, kMaxUnsharpAmount) * 256.0f));
+        threshold_q8_ = std::max(1, static_cast<int>(std::lround(settings_.threshold * 256.0f)));
+    }
+
+    void PostProcessor::filterRowHorizontal(const Color *row, int width, uint16_t *out) {
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(row);
+        const int n = width * 3;
+        const int edge = std::min(n, 3 * radius_);
+
+        // 两端各 r 个像素需要钳制到首/尾像素，逐元素处理
+        auto clamped = [&](int i) {
+            const int pixel = i / 3, channel = i % 3;
+            uint32_t sum = 0;
+            for (int k = -radius_; k <= radius_; ++k) {
+                const int x = std::clamp(pixel + k, 0, width - 1);
+                sum += static_cast<uint32_t>(weights_[k + radius_]) * bytes[3 * x + channel];
+            }
+            out[i] = static_cast<uint16_t>((sum + 8) >> 4);
+        };
+        for (int i = 0; i < edge; ++i) {
+            clamped(i);
+        }
+
+        // 内部：按块累加，块累加器留在 L1 中；同一通道相邻像素相距 3 字节
+        uint32_t accum[kBlock];
+        for (int block = edge; block < n - edge; block += kBlock) {
+            const int count = std::min(kBlock, n - edge - block);
+            std::fill(accum, accum + count, 0u);
+            for (int k = -radius_; k <= radius_; ++k) {
+                const uint32_t w = static_cast<uint32_t>(weights_[k + radius_]);
+                const uint8_t *shifted = bytes + block + 3 * k;
+                for (int i = 0; i < count; ++i) {
+                    accum[i] += w * shifted[i];
+                }
+            }
+            // Q12 × 8 位 → 保留 8 位小数
+            for (int i = 0; i < count; ++i) {
+                out[block + i] = static_cast<uint16_t>((accum[i] + 8) >> 4);
+            }
+        }
+
+        for (int i = std::max(edge, n - edge); i < n; ++i) {
+            clamped(i);
+        }
+    }
+
+    void PostProcessor::combineRow(const uint16_t *const *window, const Color *source, int width, Color *out) {
+        const int n = width * 3;
+        const uint8_t *src = reinterpret_cast<const uint8_t *>(source);
+        uint8_t *dst = reinterpret_cast<uint8_t *>(out);
+        uint32_t accum[kBlock];
+        for (int block = 0; block < n; block += kBlock) {
+            const int count = std::min(kBlock, n - block);
+            std::fill(accum, accum + count, 0u);
+            for (int k = 0; k <= 2 * radius_; ++k) {
+                const uint32_t w = static_cast<uint32_t>(weights_[k]);
+                const uint16_t *row = window[k] + block;
+                for (int i = 0; i < count; ++i) {
+                    accum[i] += w * row[i];
+                }
+            }
+            combineBlock(accum, src + block, count, dst + block);
+        }
+    }
+
+    void PostProcessor::combineBlock(const uint32_t *accum, const uint8_t *src, int n, uint8_t *dst) const {
+        // 逐元素读取源字节、写回同一下标，原地处理（out == source）也是安全的
+        switch (settings_.filter) {
+        case PostFilter::GAUSSIAN_BLUR:
+            for (int i = 0; i < n; ++i) {
+                const int blur = static_cast<int>((accum[i] + 2048) >> 12); // 8 位小数
+                dst[i] = static_cast<uint8_t>((blur + 128) >> 8);
+            }
+            break;
+        case PostFilter::UNSHARP_MASK:
+            for (int i = 0; i < n; ++i) {
+                const int blur = static_cast<int>((accum[i] + 2048) >> 12);
+                const int sharp = src[i] * 256;
+                const int value = sharp + (((sharp - blur) * amount_q8_ + 128) >> 8);
+                dst[i] = static_cast<uint8_t>(std::clamp((value + 128) >> 8, 0, 255));
+            }
+            break;
+        case PostFilter::DENOISE: {
+            const float inv_threshold = 1.0f / static_cast<float>(threshold_q8_);
+            for (int i = 0; i < n; ++i) {
+                const float blur = static_cast<float>((accum[i] + 2048) >> 12);
+                const float value = static_cast<float>(src[i]) * 256.0f;
+                const float diff = blur - value;
+                const float weight = std::max(0.0f, 1.0f - std::abs(diff) * inv_threshold);
+                dst[i] = static_cast<uint8_t>(std::clamp(static_cast<int>(value + diff * weight + 128.0f) >> 8, 0, 255));
+            }
+            break;
+        }
+        case PostFilter::NONE:
+            if (dst != src) {
+                std::memcpy(dst, src, static_cast<size_t>(n));
+            }
+            break;
+        }
+    }
+
+    void PostProcessor::process(const FrameBuffer &src, int context_begin, int context_end,
+                                int first_row, int row_count, FrameBuffer &dst, int dst_row) {
+        const int width = src.getWidth();
+        if (dst.getWidth() != width) {
+            throw std::invalid_argument("PostProcessor::process: 源与目标宽度不一致");
+        }
+        context_begin = std::max(context_begin, 0);
+        context_end = std::min(context_end, src.getHeight());
+        if (row_count <= 0 || first_row < context_begin || first_row + row_count > context_end ||
+            dst_row < 0 || dst_row + row_count > dst.getHeight()) {
+            throw std::invalid_argument("PostProcessor::process: 行范围无效");
+        }
+
+        if (!isEnabled()) {
+            if (&src != &dst || first_row != dst_row) {
+                for (int i = 0; i < row_count; ++i) {
+                    std::memcpy(dst.getRow(dst_row + i), src.getRow(first_row + i), static_cast<size_t>(width) * sizeof(Color));
+                }
+            }
+            return;
+        }
+
+        const int taps = 2 * radius_ + 1;
+        const size_t n = static_cast<size_t>(width) * 3;
+        ring_.resize(taps * n);
+        auto slot = [&](int logical_row) {
+            return &ring_[static_cast<size_t>(((logical_row % taps) + taps) % taps) * n];
+        };
+        auto source_row = [&](int y) {
+            return src.getRow(std::clamp(y, context_begin, context_end - 1));
+        };
+
+        // 预填充第一个输出行的窗口；之后每输出一行，只对新进入窗口的一行做水平卷积
+        for (int y = first_row - radius_; y <= first_row + radius_; ++y) {
+            filterRowHorizontal(source_row(y), width, slot(y));
+        }
+        const uint16_t *window[2 * kMaxRadius + 1];
+        for (int y = first_row; y < first_row + row_count; ++y) {
+            for (int k = 0; k < taps; ++k) {
+                window[k] = slot(y - radius_ + k);
+            }
+            // 原地处理时第 y 行在这里被覆盖；下一行要读取的 y + r + 1 行还没有被写过
+            combineRow(window, src.getRow(y), width, dst.getRow(dst_row + (y - first_row)));
+            if (y + 1 < first_row + row_count) {
+                filterRowHorizontal(source_row(y + radius_ + 1), width, slot(y + radius_ + 1));
+            }
+        }
+    }
+
+    void PostProcessor::apply(FrameBuffer &fb) {
+        process(fb, 0, fb.getHeight(), 0, fb.getHeight(), fb, 0);
+    }
+
+} // namespace SoftRenderer
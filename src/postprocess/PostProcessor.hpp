@@ -0,0 +1,92 @@
+//
+//  PostProcessor.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef PostProcessor_hpp
+#define PostProcessor_hpp
+
+#include <vector>
+#include <cstdint>
+#include "core/FrameBuffer.hpp"
+
+/**
+ * 可分离后处理（锐化 / 模糊 / 降噪）：三种效果共用同一个可分离高斯模糊，只是最后的合成公式不同。
+ *
+ * 逐行流式处理，每个源行只读一次：
+ *   源行 → 水平卷积（RGB 交错，步长 3）→ 环形缓冲（2r + 1 行，16 位定点）
+ *                                            ↓ 窗口凑齐
+ *                     垂直卷积 → 与源行合成（锐化 / 模糊 / 降噪）→ 输出行
+ *
+ * 环形缓冲只有 (2r + 1) × width × 6 字节，一直留在缓存中；不需要为整帧分配中间图像。
+ * 行内循环都是定长权重的乘加，编译器可自动向量化。
+ *
+ * 块/条带边界：处理一段行时需要上下各 getApron() 行的上下文（由调用方多渲染出来），
+ * 超出上下文范围的行和列钳制到边缘（与纹理采样的 CLAMP_TO_EDGE 一致）。
+ */
+namespace SoftRenderer {
+
+    enum class PostFilter {
+        NONE,
+        GAUSSIAN_BLUR,   // 高斯模糊
+        UNSHARP_MASK,    // 反锐化掩模：src + amount × (src - blur)，抵消双线性（smoothstep）放大的发软
+        DENOISE,         // 简单降噪：与模糊结果相差小于 threshold 的像素向模糊结果靠拢，边缘（差值大）保持不变
+    };
+
+    // 锐化强度上限：Q8 定点下 (sharp - blur) × amount 最大约 255 × 16 × 256，远在 int 范围内
+    constexpr float kMaxUnsharpAmount = 16.0f;
+
+    struct PostProcessSettings {
+        PostFilter filter = PostFilter::NONE;
+        float sigma = 1.0f;       // 高斯标准差（像素），半径取 ceil(2.5 σ)，最大 8
+        float amount = 0.8f;      // UNSHARP_MASK 的锐化强度，超过 kMaxUnsharpAmount 时按最大值处理
+        float threshold = 12.0f;  // DENOISE 的阈值（0~255 色阶），差值达到阈值的像素不做平滑
+    };
+
+    class PostProcessor {
+    public:
+        // 参数无效（σ ≤ 0、amount < 0、threshold ≤ 0）时抛出 std::invalid_argument
+        explicit PostProcessor(const PostProcessSettings &settings = PostProcessSettings());
+
+        bool isEnabled() const { return settings_.filter != PostFilter::NONE; }
+
+        // 边界上下文需要的行数/列数（卷积半径），NONE 时为 0
+        int getApron() const { return isEnabled() ? radius_ : 0; }
+
+        const PostProcessSettings &getSettings() const { return settings_; }
+
+        /**
+         * 处理 src 的 [first_row, first_row + row_count) 行，结果写入 dst 从 dst_row 开始的行。
+         * [context_begin, context_end) 是 src 中可用作上下文的行（应包含处理行及其上下 getApron() 行），
+         * 超出部分钳制到边缘。src 与 dst 宽度必须相同；允许原地处理（同一个 FrameBuffer 且 dst_row == first_row）。
+         */
+        void process(const FrameBuffer &src, int context_begin, int context_end,
+                     int first_row, int row_count, FrameBuffer &dst, int dst_row);
+
+        // 对整帧原地处理（一次读写）
+        void apply(FrameBuffer &fb);
+
+    private:
+        // 源行 → 水平卷积结果（8 位小数的定点数）
+        void filterRowHorizontal(const Color *row, int width, uint16_t *out);
+
+        // 垂直卷积 window[0..2r] 并与源行合成为输出行
+        void combineRow(const uint16_t *const *window, const Color *source, int width, Color *out);
+
+        // 垂直卷积结果（20 位小数）与源字节合成
+        void combineBlock(const uint32_t *accum, const uint8_t *src, int n, uint8_t *dst) const;
+
+        PostProcessSettings settings_;
+        int radius_ = 0;
+        std::vector<int32_t> weights_;   // 2r + 1 个 Q12 权重，和为 4096
+        int amount_q8_ = 0;              // 锐化强度，8 位小数，不超过 kMaxUnsharpAmount
+        int threshold_q8_ = 0;           // 降噪阈值，8 位小数
+
+        std::vector<uint16_t> ring_;     // (2r + 1) 行水平卷积结果
+    };
+
+} // namespace SoftRenderer
+
+#endif /* PostProcessor_hpp */
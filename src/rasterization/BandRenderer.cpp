@@ -0,0 +1,130 @@
+//
+//  BandRenderer.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "core/PPMStreamWriter.hpp"
+#include "BandRenderer.hpp"
+
+namespace SoftRenderer {
+
+    BandRenderer::BandRenderer(int width, int height, int band_height)
+        : width_(width), height_(height), band_height_(band_height) {
+        if (width_ <= 0 || height_ <= 0 || band_height_ <= 0) {
+            throw std::invalid_argument("BandRenderer: 宽、高和条带高度必须大于0");
+        }
+        band_height_ = std::min(band_height_, height_);
+        bins_.resize((height_ + band_height_ - 1) / band_height_);
+    }
+
+    void BandRenderer::drawTexturedTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2,
+                                            const YUVTexture &texture) {
+        Triangle triangle;
+        triangle.v0 = v0;
+        triangle.v1 = v1;
+        triangle.v2 = v2;
+        triangle.texture = &texture;
+        submit(triangle);
+    }
+
+    void BandRenderer::drawSolidTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Color &color) {
+        Triangle triangle;
+        triangle.v0 = v0;
+        triangle.v1 = v1;
+        triangle.v2 = v2;
+        triangle.color = color;
+        submit(triangle);
+    }
+
+    void BandRenderer::submit(const Triangle &triangle) {
+        // 与 Rasterizer 相同的包围盒取整方式，决定三角形落在哪些条带
+        int min_y = static_cast<int>(std::floor(std::min({triangle.v0.y, triangle.v1.y, triangle.v2.y})));
+        int max_y = static_cast<int>(std::ceil(std::max({triangle.v0.y, triangle.v1.y, triangle.v2.y})));
+        min_y = std::max(min_y, 0);
+        max_y = std::min(max_y, height_ - 1);
+        if (min_y > max_y) {
+            return;
+        }
+
+        const uint32_t index = static_cast<uint32_t>(triangles_.size());
+        triangles_.push_back(triangle);
+        for (int band = min_y / band_height_; band <= max_y / band_height_; ++band) {
+            bins_[band].push_back(index);
+        }
+    }
+
+    bool BandRenderer::render(const BandCallback &on_band, const Color &clear_color) {
+        const int apron = post_process_.getApron();
+        FrameBuffer band_fb(width_, band_height_);
+        // 开启后处理时先渲染到带上下文行的缓冲，处理结果再写入 band_fb
+        FrameBuffer post_fb(width_, post_process_.isEnabled() ? band_height_ + 2 * apron : 1);
+        FrameBuffer &render_fb = post_process_.isEnabled() ? post_fb : band_fb;
+
+        for (size_t band = 0; band < bins_.size(); ++band) {
+            const int band_y = static_cast<int>(band) * band_height_;
+            const int rows = std::min(band_height_, height_ - band_y);
+
+            // 需要光栅化的全图行 [context_begin, context_end)，render_fb 的第 0 行对应全图第 band_y - apron 行
+            const int context_begin = std::max(0, band_y - apron);
+            const int context_end = std::min(height_, band_y + rows + apron);
+            const int origin_y = band_y - apron;
+            const float offset_y = static_cast<float>(origin_y);
+
+            // 上下文行可能落在相邻条带，合并这些条带的下标列表（保持提交顺序，去重）
+            const std::vector<uint32_t> *indices = &bins_[band];
+            const size_t first_bin = static_cast<size_t>(context_begin / band_height_);
+            const size_t last_bin = static_cast<size_t>((context_end - 1) / band_height_);
+            if (first_bin != last_bin) {
+                merged_bin_.clear();
+                for (size_t bin = first_bin; bin <= last_bin; ++bin) {
+                    merged_bin_.insert(merged_bin_.end(), bins_[bin].begin(), bins_[bin].end());
+                }
+                std::sort(merged_bin_.begin(), merged_bin_.end());
+                merged_bin_.erase(std::unique(merged_bin_.begin(), merged_bin_.end()), merged_bin_.end());
+                indices = &merged_bin_;
+            }
+
+            render_fb.clear(clear_color);
+            // 最后一个条带可能不满，只允许写入有效行
+            rasterizer_.setScissor(Rect(0, context_begin - origin_y, width_, context_end - context_begin));
+
+            for (uint32_t index : *indices) {
+                // 平移到条带坐标系，UV 不变
+                Triangle tri = triangles_[index];
+                tri.v0.y -= offset_y;
+                tri.v1.y -= offset_y;
+                tri.v2.y -= offset_y;
+                if (tri.texture) {
+                    rasterizer_.drawTexturedTriangle(render_fb, tri.v0, tri.v1, tri.v2, *tri.texture);
+                } else {
+                    rasterizer_.drawSolidTriangle(render_fb, tri.v0, tri.v1, tri.v2, tri.color);
+                }
+            }
+            rasterizer_.clearScissor();
+
+            if (post_process_.isEnabled()) {
+                post_process_.process(render_fb, context_begin - origin_y, context_end - origin_y,
+                                      band_y - origin_y, rows, band_fb, 0);
+            }
+
+            if (!on_band(band_fb, band_y, rows)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool BandRenderer::renderToPPM(const std::string &filename, const Color &clear_color) {
+        PPMStreamWriter writer(filename, width_, height_);
+        bool ok = render([&writer](const FrameBuffer &band, int, int rows) {
+            return writer.writeRows(band, 0, rows);
+        }, clear_color);
+        return writer.finish() && ok;
+    }
+
+} // namespace SoftRenderer
@@ -0,0 +1,92 @@
+//
+//  BandRenderer.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef BandRenderer_hpp
+#define BandRenderer_hpp
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <functional>
+#include "Rasterizer.hpp"
+#include "postprocess/PostProcessor.hpp"
+
+/**
+ * 条带（Band/Strip）渲染：印刷、全景图等超大输出（例如 40000×20000）整张 FrameBuffer 放不进内存。
+ *
+ * 提交三角形 → 按 y 范围分箱（Binning）到各条带
+ *     ↓
+ * 逐条带：清屏 → 只绘制落在本条带的三角形（顶点平移到条带坐标系）→ 交给回调写出
+ *     ↓
+ * 条带缓冲复用，峰值内存 = width × band_height × 3 字节，与图像高度无关
+ *
+ * 可选后处理（setPostProcess）：条带光栅化完成后立即做锐化/模糊/降噪，再交给回调写出，
+ * 不需要对整张输出再读写一遍。卷积需要条带上下各 apron 行的上下文，这些行随条带一起多光栅化
+ * （每条带多画 2 × apron 行），条带边界处的结果与整帧处理逐字节一致。
+ */
+namespace SoftRenderer {
+
+    class BandRenderer {
+    public:
+        /**
+         * @param width 输出图像宽度
+         * @param height 输出图像高度
+         * @param band_height 每个条带的行数，决定峰值内存
+         */
+        BandRenderer(int width, int height, int band_height = 256);
+
+        // 提交三角形（全图坐标），纹理需存活到 render 结束
+        void drawTexturedTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const YUVTexture &texture);
+        void drawSolidTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Color &color);
+
+        /**
+         * 条带完成回调：band 为条带缓冲，其前 rows 行对应全图的 [band_y, band_y + rows) 行。
+         * 返回 false 时中止渲染。
+         */
+        using BandCallback = std::function<bool(const FrameBuffer &band, int band_y, int rows)>;
+
+        // 从上到下依次渲染所有条带，全部成功返回 true
+        bool render(const BandCallback &on_band, const Color &clear_color = Color(0, 0, 0));
+
+        // 设置后处理，在 render 中逐条带执行；filter 为 NONE 时关闭
+        void setPostProcess(const PostProcessSettings &settings) { post_process_ = PostProcessor(settings); }
+
+        // 设置 3D LUT 调色（见 Rasterizer::setColorLUT），lut 需存活到 render 结束
+        void setColorLUT(const ColorLUT *lut) { rasterizer_.setColorLUT(lut); }
+
+        // 渲染并流式写出为 PPM 文件
+        bool renderToPPM(const std::string &filename, const Color &clear_color = Color(0, 0, 0));
+
+        int getBandCount() const { return static_cast<int>(bins_.size()); }
+
+        // 条带缓冲占用的字节数（即像素数据的峰值内存）；开启后处理时另有一个带上下文行的渲染缓冲
+        size_t getBandBytes() const {
+            const int apron = post_process_.getApron();
+            size_t rows = post_process_.isEnabled() ? 2 * static_cast<size_t>(band_height_) + 2 * apron : band_height_;
+            return static_cast<size_t>(width_) * rows * sizeof(Color);
+        }
+
+    private:
+        struct Triangle {
+            Vertex v0, v1, v2;
+            const YUVTexture *texture = nullptr; // nullptr 表示纯色
+            Color color;
+        };
+
+        void submit(const Triangle &triangle);
+
+        int width_, height_, band_height_;
+        std::vector<Triangle> triangles_;
+        std::vector<std::vector<uint32_t>> bins_; // 每个条带内按提交顺序排列的三角形下标
+        Rasterizer rasterizer_;
+        PostProcessor post_process_;
+        std::vector<uint32_t> merged_bin_; // 上下文行跨越多个条带时合并后的三角形下标
+    };
+
+} // namespace SoftRenderer
+
+#endif /* BandRenderer_hpp */
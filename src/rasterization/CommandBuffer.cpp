@@ -0,0 +1,233 @@
+//
+//  CommandBuffer.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "CommandBuffer.hpp"
+
+namespace SoftRenderer {
+
+    namespace {
+        // 闭区间像素包围盒：与 Rasterizer 相同的取整方式，再向外扩 1 像素（剪切路径的边缘像素可能越出取整后的范围）
+        struct PixelBounds {
+            int min_x, max_x, min_y, max_y;
+
+            bool overlaps(const PixelBounds &other) const {
+                return min_x <= other.max_x && other.min_x <= max_x && min_y <= other.max_y && other.min_y <= max_y;
+            }
+
+            void merge(const PixelBounds &other) {
+                min_x = std::min(min_x, other.min_x);
+                max_x = std::max(max_x, other.max_x);
+                min_y = std::min(min_y, other.min_y);
+                max_y = std::max(max_y, other.max_y);
+            }
+        };
+
+        PixelBounds boundsOf(const Vertex *v, int count) {
+            float min_x = v[0].x, max_x = v[0].x, min_y = v[0].y, max_y = v[0].y;
+            for (int i = 1; i < count; ++i) {
+                min_x = std::min(min_x, v[i].x);
+                max_x = std::max(max_x, v[i].x);
+                min_y = std::min(min_y, v[i].y);
+                max_y = std::max(max_y, v[i].y);
+            }
+            return PixelBounds{static_cast<int>(std::floor(min_x)) - 1, static_cast<int>(std::ceil(max_x)) + 1,
+                               static_cast<int>(std::floor(min_y)) - 1, static_cast<int>(std::ceil(max_y)) + 1};
+        }
+
+        // 回放期间的过滤方式覆盖：析构时恢复光栅化器原来的设置（绘制抛出异常时也恢复）
+        class FilterOverrideScope {
+        public:
+            explicit FilterOverrideScope(Rasterizer &rasterizer)
+                : rasterizer_(rasterizer), had_override_(rasterizer.hasFilterOverride()),
+                  previous_(rasterizer.getFilterOverride()) {}
+
+            ~FilterOverrideScope() {
+                if (had_override_) {
+                    rasterizer_.setFilterOverride(previous_);
+                } else {
+                    rasterizer_.clearFilterOverride();
+                }
+            }
+
+            FilterOverrideScope(const FilterOverrideScope &) = delete;
+            FilterOverrideScope &operator=(const FilterOverrideScope &) = delete;
+
+        private:
+            Rasterizer &rasterizer_;
+            bool had_override_;
+            TextureFilter previous_;
+        };
+    }
+
+    void CommandBuffer::reset() {
+        commands_.clear();
+        uniforms_.clear();
+        current_uniforms_ = -1;
+        has_filter_ = false;
+        compiled_commands_.clear();
+        batches_.clear();
+        compiled_ = false;
+    }
+
+    int CommandBuffer::setUniforms(const Transform2DUniforms &uniforms) {
+        if (!uniforms.isValid()) {
+            throw std::invalid_argument("CommandBuffer::setUniforms: scale 必须大于0");
+        }
+        uniforms_.push_back(uniforms);
+        current_uniforms_ = static_cast<int>(uniforms_.size()) - 1;
+        return current_uniforms_;
+    }
+
+    void CommandBuffer::updateUniforms(int block, const Transform2DUniforms &uniforms) {
+        if (block < 0 || block >= static_cast<int>(uniforms_.size())) {
+            throw std::invalid_argument("CommandBuffer::updateUniforms: uniforms 块编号无效");
+        }
+        if (!uniforms.isValid()) {
+            throw std::invalid_argument("CommandBuffer::updateUniforms: scale 必须大于0");
+        }
+        uniforms_[block] = uniforms;
+        compiled_ = false;
+    }
+
+    void CommandBuffer::record(Command &command, const Vertex *vertices, int vertex_count) {
+        std::copy(vertices, vertices + vertex_count, command.v);
+        command.uniforms = current_uniforms_;
+        if (command.texture) {
+            command.filter = has_filter_ ? filter_ : command.texture->getFilterMode();
+        }
+        commands_.push_back(command);
+        compiled_ = false;
+    }
+
+    void CommandBuffer::drawTexturedTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const YUVTexture &texture) {
+        const Vertex vertices[3] = {v0, v1, v2};
+        Command command;
+        command.kind = Kind::TRIANGLE;
+        command.texture = &texture;
+        record(command, vertices, 3);
+    }
+
+    void CommandBuffer::drawTexturedQuad(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Vertex &v3,
+                                         const YUVTexture &texture) {
+        const Vertex vertices[4] = {v0, v1, v2, v3};
+        Command command;
+        command.kind = Kind::QUAD;
+        command.texture = &texture;
+        record(command, vertices, 4);
+    }
+
+    void CommandBuffer::drawSolidTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Color &color) {
+        const Vertex vertices[3] = {v0, v1, v2};
+        Command command;
+        command.kind = Kind::SOLID;
+        command.color = color;
+        record(command, vertices, 3);
+    }
+
+    void CommandBuffer::compile() {
+        std::vector<Transform2DShader> shaders(uniforms_.size());
+        for (size_t i = 0; i < uniforms_.size(); ++i) {
+            shaders[i].setUniforms(uniforms_[i]);
+        }
+
+        struct PendingBatch {
+            const YUVTexture *texture;
+            TextureFilter filter;
+            PixelBounds bounds;               // 批次内所有命令包围盒的并集
+            std::vector<uint32_t> commands;
+        };
+        std::vector<PendingBatch> pending;
+        std::vector<CompiledCommand> transformed(commands_.size());
+
+        for (size_t index = 0; index < commands_.size(); ++index) {
+            const Command &command = commands_[index];
+            const int vertex_count = command.kind == Kind::QUAD ? 4 : 3;
+            CompiledCommand &out = transformed[index];
+            out.kind = command.kind;
+            out.color = command.color;
+            for (int i = 0; i < vertex_count; ++i) {
+                out.v[i] = command.uniforms >= 0 ? shaders[command.uniforms].processVertex(command.v[i]) : command.v[i];
+            }
+            const PixelBounds bounds = boundsOf(out.v, vertex_count);
+
+            /**
+             * 从最后一个批次向前找同状态的批次：并入批次 j 意味着本命令移到 j 之后所有批次的前面执行，
+             * 因此途经的批次都不能与它相交；遇到相交的批次即停止，另起新批次。
+             */
+            int target = -1;
+            const int last = static_cast<int>(pending.size()) - 1;
+            for (int j = last; j >= 0 && j > last - kMergeWindow; --j) {
+                if (pending[j].texture == command.texture && pending[j].filter == command.filter) {
+                    target = j;
+                    break;
+                }
+                if (pending[j].bounds.overlaps(bounds)) {
+                    break;
+                }
+            }
+            if (target < 0) {
+                pending.push_back(PendingBatch{command.texture, command.filter, bounds, {}});
+                target = static_cast<int>(pending.size()) - 1;
+            } else {
+                pending[target].bounds.merge(bounds);
+            }
+            pending[target].commands.push_back(static_cast<uint32_t>(index));
+        }
+
+        compiled_commands_.clear();
+        compiled_commands_.reserve(commands_.size());
+        batches_.clear();
+        batches_.reserve(pending.size());
+        for (const PendingBatch &batch : pending) {
+            batches_.push_back(Batch{batch.texture, batch.filter, compiled_commands_.size(), batch.commands.size()});
+            for (uint32_t index : batch.commands) {
+                compiled_commands_.push_back(transformed[index]);
+            }
+        }
+        compiled_ = true;
+    }
+
+    void CommandBuffer::replay(Rasterizer &rasterizer, FrameBuffer &fb) const {
+        if (!compiled_) {
+            throw std::logic_error("CommandBuffer::replay: 录制或修改之后需要先调用 compile");
+        }
+        FilterOverrideScope scope(rasterizer);
+        for (const Batch &batch : batches_) {
+            if (batch.texture) {
+                rasterizer.setFilterOverride(batch.filter);
+            }
+            for (size_t i = batch.first; i < batch.first + batch.count; ++i) {
+                const CompiledCommand &command = compiled_commands_[i];
+                switch (command.kind) {
+                    case Kind::TRIANGLE:
+                        rasterizer.drawTexturedTriangle(fb, command.v[0], command.v[1], command.v[2], *batch.texture);
+                        break;
+                    case Kind::QUAD:
+                        rasterizer.drawTexturedQuad(fb, command.v[0], command.v[1], command.v[2], command.v[3], *batch.texture);
+                        break;
+                    case Kind::SOLID:
+                        rasterizer.drawSolidTriangle(fb, command.v[0], command.v[1], command.v[2], command.color);
+                        break;
+                }
+            }
+        }
+    }
+
+    size_t CommandBuffer::getRecordedStateChanges() const {
+        size_t changes = 0;
+        for (size_t i = 0; i < commands_.size(); ++i) {
+            if (i == 0 || commands_[i].texture != commands_[i - 1].texture || commands_[i].filter != commands_[i - 1].filter) {
+                ++changes;
+            }
+        }
+        return changes;
+    }
+
+} // namespace SoftRenderer
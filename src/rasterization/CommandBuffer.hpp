@@ -0,0 +1,121 @@
+//
+//  CommandBuffer.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef CommandBuffer_hpp
+#define CommandBuffer_hpp
+
+#include <vector>
+#include <cstdint>
+#include "Rasterizer.hpp"
+#include "shaders/Transform2DShader.hpp"
+
+/**
+ * 命令缓冲：先录制绘制命令（顶点、uniforms、纹理、过滤方式），编译时按状态排序合并，之后可以反复回放。
+ *
+ * 录制（对象空间顶点 + 当前 uniforms 块 + 当前过滤方式）
+ *     ↓
+ * compile()
+ *     ├── 用各自的 Transform2DUniforms 变换顶点，计算屏幕包围盒
+ *     ├── 按状态（纹理 + 过滤方式）合并成批次：命令向前并入同状态的批次，
+ *     │   但不能越过与它包围盒相交的命令（这些像素的覆盖顺序必须保持，后画的覆盖先画的）
+ *     └── 展开为批次列表
+ *     ↓
+ * replay(rasterizer, fb)：逐批次设置状态并绘制，同一纹理的三角形连续绘制，纹理数据留在缓存中
+ *     （过滤方式通过 Rasterizer::setFilterOverride 传给光栅化器，纹理本身不被修改）
+ *
+ * 静态场景录制一次、编译一次，之后每帧只回放；只有变换变化时用 updateUniforms 修改 uniforms 块并重新编译，
+ * 不需要重新录制。编译后的命令缓冲和其中的纹理都只读，多个线程可以各自用自己的 Rasterizer
+ * （例如设置不同的裁剪矩形）同时回放到同一个帧缓冲的不同区域。
+ */
+namespace SoftRenderer {
+
+    class CommandBuffer {
+    public:
+        // 编译时向前查找可并入批次的最大距离（批次数），限制编译开销
+        static constexpr int kMergeWindow = 64;
+
+        // 清空所有命令和 uniforms 块
+        void reset();
+
+        /**
+         * 新增一个 uniforms 块并设为当前块，之后录制的命令的顶点都经过它变换，返回块编号。
+         * 没有设置过 uniforms 的命令按屏幕坐标原样绘制。scale 不为正时抛出 std::invalid_argument。
+         */
+        int setUniforms(const Transform2DUniforms &uniforms);
+
+        // 修改已录制的 uniforms 块（例如动画），命令缓冲需要重新编译
+        void updateUniforms(int block, const Transform2DUniforms &uniforms);
+
+        /**
+         * 之后录制的纹理绘制使用的过滤方式。没有设置时使用录制那一刻纹理自身的过滤方式。
+         * 回放按录制的过滤方式采样，与纹理当前的过滤模式无关。
+         */
+        void setFilter(TextureFilter filter) { filter_ = filter; has_filter_ = true; }
+        void clearFilter() { has_filter_ = false; }
+
+        // 录制绘制命令，纹理由调用方持有，需存活到不再回放
+        void drawTexturedTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const YUVTexture &texture);
+        void drawTexturedQuad(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Vertex &v3, const YUVTexture &texture);
+        void drawSolidTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Color &color);
+
+        // 变换顶点、排序合并；录制或修改 uniforms 之后、回放之前调用
+        void compile();
+        bool isCompiled() const { return compiled_; }
+
+        /**
+         * 按编译后的顺序绘制到 fb（使用 rasterizer 当前的裁剪矩形、LUT 等设置）；未编译时抛出 std::logic_error。
+         * 回放期间临时设置 rasterizer 的过滤方式覆盖，返回前恢复原来的设置。
+         */
+        void replay(Rasterizer &rasterizer, FrameBuffer &fb) const;
+
+        size_t getCommandCount() const { return commands_.size(); }
+        size_t getBatchCount() const { return batches_.size(); }
+
+        // 按录制顺序执行时的状态切换次数（相邻命令状态不同计一次），用于和 getBatchCount 对比排序效果
+        size_t getRecordedStateChanges() const;
+
+    private:
+        enum class Kind : uint8_t { TRIANGLE, QUAD, SOLID };
+
+        struct Command {
+            Kind kind = Kind::TRIANGLE;
+            Vertex v[4];
+            int uniforms = -1;             // -1 表示不变换
+            const YUVTexture *texture = nullptr; // 纯色为 nullptr
+            TextureFilter filter = TextureFilter::NEAREST;
+            Color color;
+        };
+
+        // 编译结果：变换后的顶点，按批次连续存放
+        struct CompiledCommand {
+            Kind kind;
+            Vertex v[4];
+            Color color;
+        };
+
+        struct Batch {
+            const YUVTexture *texture;
+            TextureFilter filter;
+            size_t first, count; // compiled_commands_ 中的区间
+        };
+
+        void record(Command &command, const Vertex *vertices, int vertex_count);
+
+        std::vector<Command> commands_;
+        std::vector<Transform2DUniforms> uniforms_;
+        int current_uniforms_ = -1;
+        TextureFilter filter_ = TextureFilter::NEAREST;
+        bool has_filter_ = false;
+
+        std::vector<CompiledCommand> compiled_commands_;
+        std::vector<Batch> batches_;
+        bool compiled_ = false;
+    };
+
+} // namespace SoftRenderer
+
+#endif /* CommandBuffer_hpp */
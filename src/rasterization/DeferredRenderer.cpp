@@ -0,0 +1,216 @@
+//
+//  DeferredRenderer.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <algorithm>
+#include <stdexcept>
+#include "texture/ColorSpace.hpp"
+#include "DeferredRenderer.hpp"
+#include "Interpolator.hpp"
+#include "TriangleSetup.hpp"
+
+namespace SoftRenderer {
+
+    void VisibilityBuffer::reset(int w, int h) {
+        width = w;
+        height = h;
+        size_t count = static_cast<size_t>(w) * h;
+        triangle_id.assign(count, kEmpty);
+        w0.resize(count);
+        w1.resize(count);
+    }
+
+    DeferredRenderer::DeferredRenderer(int tile_size) : tile_size_(tile_size) {
+        if (tile_size_ <= 0) {
+            throw std::invalid_argument("DeferredRenderer: tile_size 必须大于0");
+        }
+    }
+
+    void DeferredRenderer::beginFrame(int width, int height) {
+        visibility_.reset(width, height);
+        triangles_.clear();
+    }
+
+    void DeferredRenderer::drawTexturedTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2,
+                                                const YUVTexture &texture) {
+        Triangle triangle;
+        triangle.v0 = v0;
+        triangle.v1 = v1;
+        triangle.v2 = v2;
+        triangle.texture = &texture;
+        rasterizeCoverage(triangle);
+    }
+
+    void DeferredRenderer::drawSolidTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2,
+                                             const Color &color) {
+        Triangle triangle;
+        triangle.v0 = v0;
+        triangle.v1 = v1;
+        triangle.v2 = v2;
+        triangle.color = color;
+        rasterizeCoverage(triangle);
+    }
+
+    void DeferredRenderer::rasterizeCoverage(const Triangle &triangle) {
+        TriangleSetup setup(triangle.v0, triangle.v1, triangle.v2);
+        if (!setup.valid) {
+            return;
+        }
+
+        Rect area = setup.bounds.intersect(Rect(0, 0, visibility_.width, visibility_.height));
+        if (area.empty()) {
+            return;
+        }
+
+        triangles_.push_back(triangle);
+        const uint32_t id = static_cast<uint32_t>(triangles_.size()); // 从 1 开始
+
+        // 按行遍历，可见性缓冲同样是行主序
+        for (int y = area.y; y < area.bottom(); ++y) {
+            size_t row = static_cast<size_t>(y) * visibility_.width;
+            for (int x = area.x; x < area.right(); ++x) {
+                float w0, w1, w2;
+                if (setup.coverage(x, y, w0, w1, w2)) {
+                    visibility_.triangle_id[row + x] = id;
+                    visibility_.w0[row + x] = w0;
+                    visibility_.w1[row + x] = w1;
+                }
+            }
+        }
+    }
+
+    void DeferredRenderer::resolve(FrameBuffer &fb) const {
+        if (fb.getWidth() != visibility_.width || fb.getHeight() != visibility_.height) {
+            throw std::invalid_argument("DeferredRenderer: FrameBuffer 尺寸与 beginFrame 不一致");
+        }
+
+        // 一个批次 = 一个 Tile 内使用同一纹理的所有可见像素（SoA）
+        struct Batch {
+            const YUVTexture *texture = nullptr;
+            std::vector<int> x, y;
+            std::vector<uint32_t> id;
+            std::vector<float> w0, w1;
+            std::vector<float> u, v;
+            std::vector<unsigned char> y_val, u_val, v_val;
+
+            void clear() {
+                x.clear(); y.clear(); id.clear(); w0.clear(); w1.clear();
+            }
+        };
+        std::vector<Batch> batches; // 在所有 Tile 间复用，避免反复分配
+
+        for (int tile_y = 0; tile_y < visibility_.height; tile_y += tile_size_) {
+            for (int tile_x = 0; tile_x < visibility_.width; tile_x += tile_size_) {
+                Rect tile = Rect(tile_x, tile_y, tile_size_, tile_size_)
+                                .intersect(Rect(0, 0, visibility_.width, visibility_.height));
+                for (auto &batch : batches) {
+                    batch.clear();
+                }
+
+                // 1. 收集：按纹理分组（一个 Tile 内纹理种类很少，线性查找即可）
+                size_t batch_cache = 0; // 相邻像素通常属于同一批次
+                for (int y = tile.y; y < tile.bottom(); ++y) {
+                    size_t row = static_cast<size_t>(y) * visibility_.width;
+                    for (int x = tile.x; x < tile.right(); ++x) {
+                        uint32_t id = visibility_.triangle_id[row + x];
+                        if (id == VisibilityBuffer::kEmpty) {
+                            continue;
+                        }
+                        const YUVTexture *texture = triangles_[id - 1].texture;
+                        if (batch_cache >= batches.size() || batches[batch_cache].texture != texture) {
+                            batch_cache = 0;
+                            while (batch_cache < batches.size() && batches[batch_cache].texture != texture) {
+                                ++batch_cache;
+                            }
+                            if (batch_cache == batches.size()) {
+                                batches.emplace_back();
+                                batches.back().texture = texture;
+                            }
+                        }
+                        Batch &batch = batches[batch_cache];
+                        batch.x.push_back(x);
+                        batch.y.push_back(y);
+                        batch.id.push_back(id);
+                        batch.w0.push_back(visibility_.w0[row + x]);
+                        batch.w1.push_back(visibility_.w1[row + x]);
+                    }
+                }
+
+                // 2. 逐批次着色
+                for (auto &batch : batches) {
+                    const size_t count = batch.id.size();
+                    if (count == 0) {
+                        continue;
+                    }
+
+                    if (!batch.texture) {
+                        for (size_t i = 0; i < count; ++i) {
+                            const Color &color = triangles_[batch.id[i] - 1].color;
+                            fb.setPixel(batch.x[i], batch.y[i], color_lut_ ? color_lut_->apply(color) : color);
+                        }
+                        continue;
+                    }
+
+                    batch.u.resize(count);
+                    batch.v.resize(count);
+                    batch.y_val.resize(count);
+                    batch.u_val.resize(count);
+                    batch.v_val.resize(count);
+
+                    // 2.1 属性插值
+                    for (size_t i = 0; i < count; ++i) {
+                        const Triangle &tri = triangles_[batch.id[i] - 1];
+                        float w0 = batch.w0[i];
+                        float w1 = batch.w1[i];
+                        float w2 = 1.0f - w0 - w1;
+                        Interpolator::interpolateUV(w0, w1, w2, tri.v0, tri.v1, tri.v2, batch.u[i], batch.v[i]);
+                    }
+
+                    // 纹理开启了 RGB 缓存：直接采样预转换的颜色
+                    if (batch.texture->hasRGBCache()) {
+                        for (size_t i = 0; i < count; ++i) {
+                            const Color rgb = batch.texture->sampleRGB(batch.u[i], batch.v[i]);
+                            fb.setPixel(batch.x[i], batch.y[i], color_lut_ ? color_lut_->apply(rgb) : rgb);
+                        }
+                        continue;
+                    }
+
+                    // 2.2 纹理采样（同一纹理连续采样，纹理数据留在缓存中）
+                    if (batch.texture->getFilterMode() == TextureFilter::BILINEAR) {
+                        // 与立即模式相同的定点双线性（sampleBilinearQuad 每个像素的结果只取决于自己的 UV），
+                        // 按 4 个一组采样，末组不足 4 个时重复最后一个像素补齐
+                        for (size_t i = 0; i < count; i += 4) {
+                            float quad_u[4], quad_v[4];
+                            unsigned char y_val[4], u_val[4], v_val[4];
+                            for (size_t k = 0; k < 4; ++k) {
+                                const size_t index = std::min(i + k, count - 1);
+                                quad_u[k] = batch.u[index];
+                                quad_v[k] = batch.v[index];
+                            }
+                            batch.texture->sampleBilinearQuad(quad_u, quad_v, y_val, u_val, v_val);
+                            for (size_t k = 0; k < 4 && i + k < count; ++k) {
+                                batch.y_val[i + k] = y_val[k];
+                                batch.u_val[i + k] = u_val[k];
+                                batch.v_val[i + k] = v_val[k];
+                            }
+                        }
+                    } else {
+                        for (size_t i = 0; i < count; ++i) {
+                            batch.texture->sampleYUV(batch.u[i], batch.v[i], batch.y_val[i], batch.u_val[i], batch.v_val[i]);
+                        }
+                    }
+
+                    // 2.3 色彩空间转换 + 调色 + 写入
+                    for (size_t i = 0; i < count; ++i) {
+                        const Color rgb = yuvToRGB(batch.y_val[i], batch.u_val[i], batch.v_val[i], batch.texture->getColorSpace());
+                        fb.setPixel(batch.x[i], batch.y[i], color_lut_ ? color_lut_->apply(rgb) : rgb);
+                    }
+                }
+            }
+        }
+    }
+
+} // namespace SoftRenderer
@@ -0,0 +1,87 @@
+//
+//  DeferredRenderer.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef DeferredRenderer_hpp
+#define DeferredRenderer_hpp
+
+#include <vector>
+#include <cstdint>
+#include "geometry/Vertex.hpp"
+#include "core/FrameBuffer.hpp"
+#include "texture/YUVTexture.hpp"
+#include "texture/ColorLUT.hpp"
+
+/**
+ * 延迟纹理（Deferred Texturing）：把“覆盖”和“着色”拆成两个阶段。
+ *
+ * 阶段 1：可见性（Visibility Pass）—— drawTexturedTriangle / drawSolidTriangle
+ *     └── 只写入每个像素的三角形 ID 和重心坐标 (w0, w1)，后画的三角形直接覆盖前面的记录
+ *     ↓
+ * 阶段 2：着色（Shading Pass）—— resolve(fb)
+ *     ├── 逐 Tile 收集可见像素，按纹理分组成批次（SoA 数组）
+ *     ├── 每个批次：插值 UV → 采样 YUV → YUV→RGB，每一步都是对连续数组的简单循环，便于编译器向量化
+ *     │   （双线性与立即模式同用定点的 sampleBilinearQuad，结果与 Rasterizer 逐像素一致）
+ *     ├── 调色（可选）← ColorLUT::apply()
+ *     └── 写入 FrameBuffer
+ *
+ * 重叠绘制（Overdraw）只消耗廉价的覆盖写入，每个可见像素只做一次纹理采样和色彩空间转换。
+ */
+namespace SoftRenderer {
+
+    // 可见性缓冲：SoA 布局，每像素 4 字节 ID + 8 字节重心坐标
+    struct VisibilityBuffer {
+        static constexpr uint32_t kEmpty = 0; // 三角形 ID 从 1 开始，0 表示没有覆盖
+
+        int width = 0, height = 0;
+        std::vector<uint32_t> triangle_id;
+        std::vector<float> w0; // 第三个重心坐标由 1 - w0 - w1 得到，不存储
+        std::vector<float> w1;
+
+        void reset(int w, int h);
+    };
+
+    class DeferredRenderer {
+    public:
+        explicit DeferredRenderer(int tile_size = 32);
+
+        // 开始新的一帧，清空可见性缓冲和三角形列表
+        void beginFrame(int width, int height);
+
+        // 可见性阶段：只记录覆盖，纹理需存活到 resolve() 结束
+        void drawTexturedTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const YUVTexture &texture);
+        void drawSolidTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Color &color);
+
+        /**
+         * 着色阶段：对可见像素做批量着色并写入帧缓冲。未被覆盖的像素保持 fb 原有内容。
+         * @throws std::invalid_argument fb 尺寸与 beginFrame 不一致时
+         */
+        void resolve(FrameBuffer &fb) const;
+
+        // 设置 3D LUT 调色（见 Rasterizer::setColorLUT），在 resolve 写入像素之前查表，lut 需存活到 resolve 结束
+        void setColorLUT(const ColorLUT *lut) { color_lut_ = lut; }
+        const ColorLUT *getColorLUT() const { return color_lut_; }
+
+        const VisibilityBuffer &getVisibilityBuffer() const { return visibility_; }
+
+    private:
+        struct Triangle {
+            Vertex v0, v1, v2;
+            const YUVTexture *texture = nullptr; // nullptr 表示纯色
+            Color color;
+        };
+
+        void rasterizeCoverage(const Triangle &triangle);
+
+        int tile_size_;
+        VisibilityBuffer visibility_;
+        std::vector<Triangle> triangles_;
+        const ColorLUT *color_lut_ = nullptr;
+    };
+
+} // namespace SoftRenderer
+
+#endif /* DeferredRenderer_hpp */
@@ -0,0 +1,183 @@
+//
+//  IncrementalRenderer.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <cmath>
+#include <stdexcept>
+#include "IncrementalRenderer.hpp"
+
+namespace SoftRenderer {
+
+    namespace {
+        bool sameVertex(const Vertex &a, const Vertex &b) {
+            return a.x == b.x && a.y == b.y && a.u == b.u && a.v == b.v;
+        }
+
+        bool sameColor(const Color &a, const Color &b) {
+            return a.r == b.r && a.g == b.g && a.b == b.b;
+        }
+    } // namespace
+
+    bool DrawItem::operator==(const DrawItem &other) const {
+        return sameVertex(v0, other.v0) && sameVertex(v1, other.v1) && sameVertex(v2, other.v2) &&
+               texture == other.texture && filter == other.filter && sameColor(color, other.color);
+    }
+
+    IncrementalRenderer::IncrementalRenderer(int tile_size) : tile_size_(tile_size) {
+        if (tile_size_ <= 0) {
+            throw std::invalid_argument("IncrementalRenderer: tile_size 必须大于0");
+        }
+    }
+
+    void IncrementalRenderer::beginFrame() {
+        current_items_.clear();
+        dirty_textures_.clear();
+    }
+
+    void IncrementalRenderer::drawTexturedTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2,
+                                                   const YUVTexture &texture) {
+        DrawItem item;
+        item.v0 = v0;
+        item.v1 = v1;
+        item.v2 = v2;
+        item.texture = &texture;
+        item.filter = texture.getFilterMode();
+        current_items_.push_back(item);
+    }
+
+    void IncrementalRenderer::drawSolidTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2,
+                                                const Color &color) {
+        DrawItem item;
+        item.v0 = v0;
+        item.v1 = v1;
+        item.v2 = v2;
+        item.color = color;
+        current_items_.push_back(item);
+    }
+
+    void IncrementalRenderer::markTextureDirty(const YUVTexture &texture) {
+        dirty_textures_.insert(&texture);
+    }
+
+    Rect IncrementalRenderer::boundsOf(const DrawItem &item) {
+        int min_x = static_cast<int>(std::floor(std::min({item.v0.x, item.v1.x, item.v2.x})));
+        int max_x = static_cast<int>(std::ceil(std::max({item.v0.x, item.v1.x, item.v2.x})));
+        int min_y = static_cast<int>(std::floor(std::min({item.v0.y, item.v1.y, item.v2.y})));
+        int max_y = static_cast<int>(std::ceil(std::max({item.v0.y, item.v1.y, item.v2.y})));
+        return Rect(min_x, min_y, max_x - min_x + 1, max_y - min_y + 1);
+    }
+
+    void IncrementalRenderer::markDamage(const Rect &bounds) {
+        Rect clipped = bounds.intersect(Rect(0, 0, fb_width_, fb_height_));
+        if (clipped.empty()) {
+            return;
+        }
+        int tx0 = clipped.x / tile_size_;
+        int tx1 = (clipped.right() - 1) / tile_size_;
+        int ty0 = clipped.y / tile_size_;
+        int ty1 = (clipped.bottom() - 1) / tile_size_;
+        for (int ty = ty0; ty <= ty1; ++ty) {
+            for (int tx = tx0; tx <= tx1; ++tx) {
+                tile_dirty_[ty * tiles_x_ + tx] = 1;
+            }
+        }
+    }
+
+    void IncrementalRenderer::buildDirtyRects(int fb_width, int fb_height) {
+        dirty_rects_.clear();
+        dirty_tile_count_ = 0;
+        for (int ty = 0; ty < tiles_y_; ++ty) {
+            int tx = 0;
+            while (tx < tiles_x_) {
+                if (!tile_dirty_[ty * tiles_x_ + tx]) {
+                    ++tx;
+                    continue;
+                }
+                int run_begin = tx;
+                while (tx < tiles_x_ && tile_dirty_[ty * tiles_x_ + tx]) {
+                    ++tx;
+                }
+                dirty_tile_count_ += tx - run_begin;
+
+                Rect run(run_begin * tile_size_, ty * tile_size_,
+                         (tx - run_begin) * tile_size_, tile_size_);
+                dirty_rects_.push_back(run.intersect(Rect(0, 0, fb_width, fb_height)));
+            }
+        }
+    }
+
+    const std::vector<Rect> &IncrementalRenderer::endFrame(FrameBuffer &fb, const Color &clear_color) {
+        // 1. 帧缓冲尺寸或清屏颜色变化时，上一帧的内容不可复用
+        if (fb.getWidth() != fb_width_ || fb.getHeight() != fb_height_ ||
+            !sameColor(clear_color, last_clear_color_)) {
+            force_full_redraw_ = true;
+        }
+        fb_width_ = fb.getWidth();
+        fb_height_ = fb.getHeight();
+        last_clear_color_ = clear_color;
+        tiles_x_ = (fb_width_ + tile_size_ - 1) / tile_size_;
+        tiles_y_ = (fb_height_ + tile_size_ - 1) / tile_size_;
+
+        // 2. 计算损伤区域
+        if (force_full_redraw_) {
+            tile_dirty_.assign(static_cast<size_t>(tiles_x_) * tiles_y_, 1);
+        } else {
+            tile_dirty_.assign(static_cast<size_t>(tiles_x_) * tiles_y_, 0);
+
+            // 按下标逐项比较：任何一项变化，其旧位置需要擦除、新位置需要绘制
+            size_t common = std::min(previous_items_.size(), current_items_.size());
+            for (size_t i = 0; i < common; ++i) {
+                const DrawItem &prev = previous_items_[i];
+                const DrawItem &curr = current_items_[i];
+                bool texture_changed = curr.texture && dirty_textures_.count(curr.texture);
+                if (prev != curr || texture_changed) {
+                    markDamage(boundsOf(prev));
+                    markDamage(boundsOf(curr));
+                }
+            }
+            // 新增或删除的三角形
+            for (size_t i = common; i < previous_items_.size(); ++i) {
+                markDamage(boundsOf(previous_items_[i]));
+            }
+            for (size_t i = common; i < current_items_.size(); ++i) {
+                markDamage(boundsOf(current_items_[i]));
+            }
+        }
+        force_full_redraw_ = false;
+
+        // 3. 合并为矩形，逐个矩形清屏 + 重绘。绘制顺序与记录顺序一致，保证遮挡关系不变。
+        buildDirtyRects(fb_width_, fb_height_);
+
+        std::vector<Rect> item_bounds;
+        item_bounds.reserve(current_items_.size());
+        for (const auto &item : current_items_) {
+            item_bounds.push_back(boundsOf(item));
+        }
+
+        for (const Rect &dirty : dirty_rects_) {
+            fb.clearRect(dirty, clear_color);
+            rasterizer_.setScissor(dirty);
+            for (size_t i = 0; i < current_items_.size(); ++i) {
+                if (!item_bounds[i].intersects(dirty)) {
+                    continue;
+                }
+                const DrawItem &item = current_items_[i];
+                if (item.texture) {
+                    rasterizer_.drawTexturedTriangle(fb, item.v0, item.v1, item.v2, *item.texture);
+                } else {
+                    rasterizer_.drawSolidTriangle(fb, item.v0, item.v1, item.v2, item.color);
+                }
+            }
+        }
+        rasterizer_.clearScissor();
+
+        previous_items_.swap(current_items_);
+        current_items_.clear();
+        dirty_textures_.clear();
+        return dirty_rects_;
+    }
+
+} // namespace SoftRenderer
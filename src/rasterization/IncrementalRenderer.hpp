@@ -0,0 +1,103 @@
+//
+//  IncrementalRenderer.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef IncrementalRenderer_hpp
+#define IncrementalRenderer_hpp
+
+#include <vector>
+#include <unordered_set>
+#include "Rasterizer.hpp"
+
+/**
+ * 脏矩形（Dirty Rectangle）增量渲染：
+ * 叠加层/UI 这类画面帧与帧之间大部分像素不变，整屏 clear + 重绘浪费了绝大部分带宽。
+ *
+ * beginFrame()
+ *     ↓
+ * 记录本帧的绘制列表（drawTexturedTriangle / drawSolidTriangle）
+ *     ↓
+ * endFrame(fb)
+ *     ├── 与上一帧的绘制列表逐项比较，变化项的新旧包围盒所覆盖的 Tile 标记为脏
+ *     ├── 只对脏 Tile 清屏，并以 Tile 为裁剪矩形重绘所有与之相交的三角形
+ *     └── 合并脏 Tile 为矩形列表导出，写出/编码端可以跳过其余区域
+ */
+namespace SoftRenderer {
+
+    // 一次绘制调用的完整状态，用于帧间比较
+    struct DrawItem {
+        // 顶点着色器处理之后的屏幕空间顶点：uniforms 的变化会体现为顶点位置的变化
+        Vertex v0, v1, v2;
+        const YUVTexture *texture = nullptr; // nullptr 表示纯色三角形
+        TextureFilter filter = TextureFilter::NEAREST;
+        Color color;
+
+        bool operator==(const DrawItem &other) const;
+        bool operator!=(const DrawItem &other) const { return !(*this == other); }
+    };
+
+    class IncrementalRenderer {
+    public:
+        explicit IncrementalRenderer(int tile_size = 64);
+
+        // 开始记录新的一帧
+        void beginFrame();
+
+        void drawTexturedTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const YUVTexture &texture);
+        void drawSolidTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Color &color);
+
+        /**
+         * 纹理对象不变但内容被原地修改时调用（纹理按指针比较，无法自动感知内容变化），
+         * 本帧所有引用它的三角形都会被视为已改变。
+         */
+        void markTextureDirty(const YUVTexture &texture);
+
+        // 强制下一次 endFrame 整帧重绘（例如帧缓冲被外部改写过）
+        void invalidate() { force_full_redraw_ = true; }
+
+        /**
+         * 结束本帧：只重绘脏 Tile。第一帧、帧缓冲尺寸或清屏颜色改变时整帧重绘。
+         * 同一个 FrameBuffer 需要在帧之间保留上一帧的内容。
+         * @return 本帧被重绘的矩形列表（同 getDirtyRects()）
+         */
+        const std::vector<Rect> &endFrame(FrameBuffer &fb, const Color &clear_color = Color(0, 0, 0));
+
+        const std::vector<Rect> &getDirtyRects() const { return dirty_rects_; }
+
+        // 上一帧被重绘的 Tile 数 / 总 Tile 数，便于观察增量渲染的收益
+        int getDirtyTileCount() const { return dirty_tile_count_; }
+        int getTileCount() const { return tiles_x_ * tiles_y_; }
+
+    private:
+        // 三角形包围盒（像素坐标，与 Rasterizer 相同的取整方式）
+        static Rect boundsOf(const DrawItem &item);
+
+        // 把矩形覆盖的 Tile 标记为脏
+        void markDamage(const Rect &bounds);
+
+        // 把脏 Tile 按行合并为矩形：同一行相邻的脏 Tile 合并成一个矩形
+        void buildDirtyRects(int fb_width, int fb_height);
+
+        int tile_size_;
+        int tiles_x_ = 0, tiles_y_ = 0;
+        int fb_width_ = 0, fb_height_ = 0;
+        Color last_clear_color_;
+        bool force_full_redraw_ = true;
+
+        std::vector<DrawItem> previous_items_;
+        std::vector<DrawItem> current_items_;
+        std::unordered_set<const YUVTexture *> dirty_textures_;
+
+        std::vector<unsigned char> tile_dirty_; // 每个 Tile 一个标记
+        std::vector<Rect> dirty_rects_;
+        int dirty_tile_count_ = 0;
+
+        Rasterizer rasterizer_;
+    };
+
+} // namespace SoftRenderer
+
+#endif /* IncrementalRenderer_hpp */
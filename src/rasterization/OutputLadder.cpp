@@ -0,0 +1,187 @@
+//
+//  OutputLadder.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include "OutputLadder.hpp"
+
+namespace SoftRenderer {
+
+    namespace {
+        constexpr int kWeightOne = 4096; // Q12
+    }
+
+    OutputLadder::OutputLadder(int reference_width, int reference_height)
+        : reference_width_(reference_width), reference_height_(reference_height) {
+        if (reference_width <= 0 || reference_height <= 0) {
+            throw std::invalid_argument("OutputLadder: 参考分辨率无效");
+        }
+    }
+
+    void OutputLadder::addTarget(FrameBuffer &fb) {
+        targets_.push_back(&fb);
+    }
+
+    template <typename Draw>
+    void OutputLadder::renderAll(const Color &clear_color, Draw &&draw) {
+        rendered_count_ = 0;
+        downscaled_count_ = 0;
+
+        // 面积从大到小
+        std::vector<size_t> order(targets_.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+            return static_cast<long long>(targets_[a]->getWidth()) * targets_[a]->getHeight() >
+                   static_cast<long long>(targets_[b]->getWidth()) * targets_[b]->getHeight();
+        });
+
+        std::vector<const FrameBuffer *> done;
+        for (size_t index : order) {
+            FrameBuffer &fb = *targets_[index];
+
+            // 级联源：已完成档位中宽高都不小于本档的最小一档
+            const FrameBuffer *source = nullptr;
+            if (cascade_) {
+                for (const FrameBuffer *candidate : done) {
+                    if (candidate->getWidth() >= fb.getWidth() && candidate->getHeight() >= fb.getHeight() &&
+                        (!source || candidate->getWidth() * candidate->getHeight() < source->getWidth() * source->getHeight())) {
+                        source = candidate;
+                    }
+                }
+            }
+
+            if (source) {
+                downscale(*source, fb);
+                ++downscaled_count_;
+            } else {
+                fb.clear(clear_color);
+                draw(fb, static_cast<float>(fb.getWidth()) / reference_width_,
+                     static_cast<float>(fb.getHeight()) / reference_height_);
+                ++rendered_count_;
+            }
+            done.push_back(&fb);
+        }
+    }
+
+    void OutputLadder::renderTriangles(const Vertex *vertices, size_t vertex_count, const YUVTexture &texture,
+                                       const Color &clear_color) {
+        if (vertex_count % 3 != 0 || (vertex_count > 0 && !vertices)) {
+            throw std::invalid_argument("OutputLadder::renderTriangles: 顶点数必须是 3 的倍数");
+        }
+        renderAll(clear_color, [&](FrameBuffer &fb, float scale_x, float scale_y) {
+            scaled_.resize(vertex_count);
+            for (size_t i = 0; i < vertex_count; ++i) {
+                scaled_[i] = Vertex(vertices[i].x * scale_x, vertices[i].y * scale_y, vertices[i].u, vertices[i].v);
+            }
+            for (size_t i = 0; i < vertex_count; i += 3) {
+                rasterizer_.drawTexturedTriangle(fb, scaled_[i], scaled_[i + 1], scaled_[i + 2], texture);
+            }
+        });
+    }
+
+    void OutputLadder::renderQuad(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Vertex &v3,
+                                  const YUVTexture &texture, const Color &clear_color) {
+        renderAll(clear_color, [&](FrameBuffer &fb, float scale_x, float scale_y) {
+            auto scale = [&](const Vertex &v) { return Vertex(v.x * scale_x, v.y * scale_y, v.u, v.v); };
+            rasterizer_.drawTexturedQuad(fb, scale(v0), scale(v1), scale(v2), scale(v3), texture);
+        });
+    }
+
+    void OutputLadder::buildFootprints(int src_size, int dst_size, std::vector<Footprint> &footprints,
+                                       std::vector<uint16_t> &weights) {
+        footprints.resize(dst_size);
+        weights.clear();
+        const double ratio = static_cast<double>(src_size) / dst_size;
+        for (int i = 0; i < dst_size; ++i) {
+            // 目标像素 i 覆盖源区间 [begin, end)
+            const double begin = i * ratio;
+            const double end = std::min(static_cast<double>(src_size), (i + 1) * ratio);
+            const int first = static_cast<int>(std::floor(begin));
+            const int last = std::min(src_size - 1, static_cast<int>(std::ceil(end)) - 1);
+
+            Footprint &footprint = footprints[i];
+            footprint.first = first;
+            footprint.count = last - first + 1;
+            footprint.weight_offset = weights.size();
+
+            // 覆盖长度量化为 Q12，舍入误差补到最大的权重上，保证总和精确为 1
+            int total = 0;
+            size_t largest = weights.size();
+            for (int s = first; s <= last; ++s) {
+                const double overlap = std::min(end, s + 1.0) - std::max(begin, static_cast<double>(s));
+                const int weight = static_cast<int>(std::lround(overlap / ratio * kWeightOne));
+                if (weights.size() == footprint.weight_offset || weight > weights[largest]) {
+                    largest = weights.size();
+                }
+                weights.push_back(static_cast<uint16_t>(weight));
+                total += weight;
+            }
+            weights[largest] = static_cast<uint16_t>(weights[largest] + (kWeightOne - total));
+        }
+    }
+
+    void OutputLadder::downscale(const FrameBuffer &src, FrameBuffer &dst) {
+        const int src_w = src.getWidth(), src_h = src.getHeight();
+        const int dst_w = dst.getWidth(), dst_h = dst.getHeight();
+        if (dst_w > src_w || dst_h > src_h) {
+            throw std::invalid_argument("OutputLadder::downscale: 目标尺寸大于源尺寸");
+        }
+
+        std::vector<Footprint> columns, rows;
+        std::vector<uint16_t> column_weights, row_weights;
+        buildFootprints(src_w, dst_w, columns, column_weights);
+        buildFootprints(src_h, dst_h, rows, row_weights);
+
+        // 每个像素都会被写入，待清除的 Tile 不需要先填充
+        for (int ty = 0; ty < dst.getClearTilesY(); ++ty) {
+            for (int tx = 0; tx < dst.getClearTilesX(); ++tx) {
+                dst.discardTileClear(tx, ty);
+            }
+        }
+
+        // 先垂直后水平：垂直方向是整行连续的乘加（可向量化），每个源行只读一次（边界行两次）；
+        // 水平方向的逐像素足迹循环只对每个目标行做一次
+        const size_t src_n = static_cast<size_t>(src_w) * 3;
+        std::vector<uint32_t> accum(src_n);
+        for (int y = 0; y < dst_h; ++y) {
+            const Footprint &footprint = rows[y];
+            const uint16_t *weight = &row_weights[footprint.weight_offset];
+            std::fill(accum.begin(), accum.end(), 0u);
+            for (int k = 0; k < footprint.count; ++k) {
+                const uint8_t *in = reinterpret_cast<const uint8_t *>(src.getRow(footprint.first + k));
+                const uint32_t w = weight[k];
+                for (size_t i = 0; i < src_n; ++i) {
+                    accum[i] += w * in[i];
+                }
+            }
+            // Q12 × 8 位 → 保留 8 位小数，避免水平方向再乘 Q12 时溢出
+            for (size_t i = 0; i < src_n; ++i) {
+                accum[i] = (accum[i] + 8) >> 4;
+            }
+
+            uint8_t *out = reinterpret_cast<uint8_t *>(dst.getRow(y));
+            for (int x = 0; x < dst_w; ++x) {
+                const Footprint &column = columns[x];
+                const uint16_t *column_weight = &column_weights[column.weight_offset];
+                const uint32_t *pixel = &accum[3 * static_cast<size_t>(column.first)];
+                uint32_t r = 0, g = 0, b = 0;
+                for (int k = 0; k < column.count; ++k) {
+                    r += column_weight[k] * pixel[3 * k + 0];
+                    g += column_weight[k] * pixel[3 * k + 1];
+                    b += column_weight[k] * pixel[3 * k + 2];
+                }
+                // Q12 × 8 位小数 → 8 位整数
+                out[3 * x + 0] = static_cast<uint8_t>(std::min<uint32_t>(255, (r + (1u << 19)) >> 20));
+                out[3 * x + 1] = static_cast<uint8_t>(std::min<uint32_t>(255, (g + (1u << 19)) >> 20));
+                out[3 * x + 2] = static_cast<uint8_t>(std::min<uint32_t>(255, (b + (1u << 19)) >> 20));
+            }
+        }
+    }
+
+} // namespace SoftRenderer
@@ -0,0 +1,90 @@
+//
+//  OutputLadder.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef OutputLadder_hpp
+#define OutputLadder_hpp
+
+#include <vector>
+#include <cstdint>
+#include "Rasterizer.hpp"
+
+/**
+ * 多分辨率输出阶梯（自适应码率打包）：同一个场景一次渲染到多个不同尺寸的 FrameBuffer。
+ *
+ *   顶点（参考分辨率坐标，只变换一次） + 纹理（只加载一次）
+ *       ↓
+ *   最大一档：光栅化 + 采样 + yuvToRGB
+ *       ↓ 面积平均缩小（级联：每档从上一档缩小，而不是重新采样纹理）
+ *   次一档 → 再次一档 → ...
+ *
+ * 缩小一档的代价是逐像素读几个已转换好的 RGB 像素，远低于重新光栅化、双线性采样和颜色转换；
+ * 同时相当于对小尺寸做了超采样，边缘比直接光栅化更平滑。
+ * 关闭级联（setCascade(false)）时每档各自光栅化，但仍共享纹理、变换后的顶点和光栅化器的临时缓冲。
+ */
+namespace SoftRenderer {
+
+    class OutputLadder {
+    public:
+        // 顶点坐标所在的参考分辨率，各档按 目标尺寸 / 参考尺寸 缩放顶点
+        OutputLadder(int reference_width, int reference_height);
+
+        // 添加一档输出，fb 由调用方持有，需存活到 render 结束
+        void addTarget(FrameBuffer &fb);
+        void clearTargets() { targets_.clear(); }
+
+        // 是否从较大一档级联缩小（默认开启）；关闭时每档都直接光栅化
+        void setCascade(bool cascade) { cascade_ = cascade; }
+
+        Rasterizer &getRasterizer() { return rasterizer_; }
+
+        /**
+         * 把三角形列表（vertex_count 为 3 的倍数）渲染到所有档位，每档先清屏为 clear_color。
+         * 档位按面积从大到小处理；一档的宽高都不超过已完成的某一档时，从其中最小的那一档缩小得到。
+         */
+        void renderTriangles(const Vertex *vertices, size_t vertex_count, const YUVTexture &texture,
+                             const Color &clear_color = Color(0, 0, 0));
+
+        // 同上，绘制沿边界排列的纹理四边形（见 Rasterizer::drawTexturedQuad）
+        void renderQuad(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Vertex &v3,
+                        const YUVTexture &texture, const Color &clear_color = Color(0, 0, 0));
+
+        // 上一次 render 中直接光栅化 / 级联缩小的档位数
+        int getRenderedCount() const { return rendered_count_; }
+        int getDownscaledCount() const { return downscaled_count_; }
+
+        /**
+         * 面积平均缩小：dst 的每个像素取其在 src 中覆盖区域的加权平均（可分离、定点）。
+         * dst 的宽高都不能大于 src，否则抛出 std::invalid_argument。
+         */
+        static void downscale(const FrameBuffer &src, FrameBuffer &dst);
+
+    private:
+        // 一个目标像素在源轴上的覆盖：从 first 开始的 count 个源像素，权重为 Q12（和为 4096）
+        struct Footprint {
+            int first, count;
+            size_t weight_offset;
+        };
+
+        static void buildFootprints(int src_size, int dst_size, std::vector<Footprint> &footprints,
+                                    std::vector<uint16_t> &weights);
+
+        // 按档位顺序逐档执行：draw(fb, scale_x, scale_y) 直接光栅化一档
+        template <typename Draw>
+        void renderAll(const Color &clear_color, Draw &&draw);
+
+        int reference_width_, reference_height_;
+        bool cascade_ = true;
+        std::vector<FrameBuffer *> targets_;
+        Rasterizer rasterizer_;
+        std::vector<Vertex> scaled_;
+        int rendered_count_ = 0;
+        int downscaled_count_ = 0;
+    };
+
+} // namespace SoftRenderer
+
+#endif /* OutputLadder_hpp */
@@ -6,10 +6,13 @@
 //
 
 #include <cmath>
+#include <limits>
 #include <algorithm>
 #include "texture/ColorSpace.hpp"
 #include "Rasterizer.hpp"
 #include "Interpolator.hpp"
+#include "TriangleSetup.hpp"
+#include "SpriteBatch.hpp"
 
 namespace SoftRenderer {
 
@@ -30,6 +33,36 @@ namespace SoftRenderer {
  * @param cy 向量终点 C 的 y 坐标
  * @return 浮点数，有向面积的两倍。符号表示 C 相对于 A->B 的方向。
  */
+namespace {
+    /**
+     * 行缓冲写入：被覆盖的像素先着色到缓冲，遇到未覆盖的像素（或行尾）时把连续的一段通过 writeSpan 整段写入，
+     * 大帧缓冲时为流式写入，也省去 setPixel 逐像素的边界和惰性清屏检查。
+     * 调用方必须按 x 递增的顺序对每个像素调用 put 或 skip。
+     */
+    struct SpanWriter {
+        FrameBuffer &fb;
+        Color *buffer;  // buffer[0] 对应第 origin_x 列
+        int origin_x;
+        int y;
+        int run_start = -1;
+
+        void put(int x, const Color &color) {
+            if (run_start < 0) {
+                run_start = x;
+            }
+            buffer[x - origin_x] = color;
+        }
+
+        // 像素 x 未被覆盖：写出此前的连续区间
+        void skip(int x) {
+            if (run_start >= 0) {
+                fb.writeSpan(y, run_start, buffer + (run_start - origin_x), x - run_start);
+                run_start = -1;
+            }
+        }
+    };
+}
+
 inline float edgeFunction(float ax, float ay, float bx, float by, float cx, float cy) {
     // 向量 V_AB : V_AB.x = (bx - ax), V_AB.y = (by - ay), V_AB = (bx - ax, by - ay)
     // 向量 V_AC : V_AC.x = (cx - ax), V_AC.y = (cy - ay), V_AC = (cx - ax, cy - ay)
@@ -38,7 +71,58 @@ inline float edgeFunction(float ax, float ay, float bx, float by, float cx, floa
     return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
 }
 
+void Rasterizer::clampToViewport(int fb_width, int fb_height, int& min_x, int& max_x, int& min_y, int& max_y) const {
+    min_x = std::max(0, min_x);
+    max_x = std::min(fb_width - 1, max_x);
+    min_y = std::max(0, min_y);
+    max_y = std::min(fb_height - 1, max_y);
+
+    if (has_scissor_) {
+        // 裁剪矩形是半开区间，换算成闭区间后再取交集；结果可能为空（min > max），循环自然不执行
+        min_x = std::max(min_x, scissor_.x);
+        max_x = std::min(max_x, scissor_.right() - 1);
+        min_y = std::max(min_y, scissor_.y);
+        max_y = std::min(max_y, scissor_.bottom() - 1);
+    }
+}
+
+void Rasterizer::discardCoveredClearTiles(FrameBuffer& fb, const TriangleSetup& setup,
+                                          int min_x, int max_x, int min_y, int max_y) const {
+    if (!fb.hasPendingClear() || min_x > max_x || min_y > max_y) {
+        return;
+    }
+    const int tile = FrameBuffer::kClearTileSize;
+    for (int ty = min_y / tile; ty <= max_y / tile; ++ty) {
+        for (int tx = min_x / tile; tx <= max_x / tile; ++tx) {
+            if (!fb.isTileClearPending(tx, ty)) {
+                continue;
+            }
+            // Tile 必须整个落在可写区域（帧缓冲 ∩ 裁剪矩形 ∩ 包围盒）内
+            const int x0 = tx * tile;
+            const int y0 = ty * tile;
+            const int x1 = std::min(x0 + tile, fb.getWidth()) - 1;
+            const int y1 = std::min(y0 + tile, fb.getHeight()) - 1;
+            if (x0 < min_x || x1 > max_x || y0 < min_y || y1 > max_y) {
+                continue;
+            }
+            // 三角形是凸的：四个角的像素中心都被覆盖，则 Tile 内所有像素中心都被覆盖
+            float w0, w1, w2;
+            if (setup.coverage(x0, y0, w0, w1, w2) && setup.coverage(x1, y0, w0, w1, w2) &&
+                setup.coverage(x0, y1, w0, w1, w2) && setup.coverage(x1, y1, w0, w1, w2)) {
+                fb.discardTileClear(tx, ty);
+            }
+        }
+    }
+}
+
 void Rasterizer::drawTexturedTriangle(FrameBuffer &fb, const Vertex &v0, const Vertex &v1, const Vertex &v2, const YUVTexture &texture) {
+    // 双线性过滤时走 2×2 块着色路径（开启了 RGB 缓存的纹理已不需要颜色计算，仍走逐像素路径）
+    const TextureFilter filter = filterOf(texture);
+    if (filter == TextureFilter::BILINEAR && !texture.hasRGBCache()) {
+        drawTexturedTriangleQuads(fb, v0, v1, v2, texture);
+        return;
+    }
+
     // 1. 预计算三角形的总面积和倒数（两倍有向面积用于重心坐标归一化，倒数可以避免重复计算）
     const float total_area_2X = edgeFunction(v0.x, v0.y, v1.x, v1.y, v2.x, v2.y);
 
@@ -75,15 +159,19 @@ void Rasterizer::drawTexturedTriangle(FrameBuffer &fb, const Vertex &v0, const V
     int min_y = static_cast<int>(std::floor(std::min({v0.y, v1.y, v2.y})));
     int max_y = static_cast<int>(std::ceil(std::max({v0.y, v1.y, v2.y})));
     
-    // 确保包围盒不会超出 FrameBuffer 的边界
-    min_x = std::max(0, min_x);
-    max_x = std::min(fb.getWidth() - 1, max_x);
-    min_y = std::max(0, min_y);
-    max_y = std::min(fb.getHeight() - 1, max_y);
+    // 确保包围盒不会超出 FrameBuffer 的边界（以及裁剪矩形）
+    clampToViewport(fb.getWidth(), fb.getHeight(), min_x, max_x, min_y, max_y);
+
+    // 被完整覆盖的待清除 Tile 无需先填充清屏颜色
+    if (fb.hasPendingClear()) {
+        discardCoveredClearTiles(fb, TriangleSetup(v0, v1, v2), min_x, max_x, min_y, max_y);
+    }
     
     // 4. 遍历三角形包围盒内的每个像素 (x,y)，将像素索引转换为几何采样点（px，py），依赖于 v0、v1、v2 坐标。
     // 在内存访问上，按行访问（y在外层）通常对 CPU 缓存（Cache）更友好。
+    span_buffer_.resize(static_cast<size_t>(std::max(max_x - min_x + 1, 0)));
     for (int y = min_y; y <= max_y; ++y) {
+        SpanWriter writer{fb, span_buffer_.data(), min_x, y};
         for (int x = min_x; x <= max_x; ++x) {
             // 像素是 1x1 的方格区域，不是数学上的点。
             // 如果用 (x, y)，它同时是四个像素的角点，系统很难确定这个像素是否应该被覆盖。
@@ -111,69 +199,506 @@ void Rasterizer::drawTexturedTriangle(FrameBuffer &fb, const Vertex &v0, const V
                 Interpolator::interpolateUV(w0, w1, w2, v0, v1, v2, u, v);
                 
                 // 7. 纹理采样，从 YUV 纹理中获取颜色数据，依赖于插值后的 (u，v) 坐标。
-                unsigned char y_val, u_val, v_val;
-                texture.sampleYUV(u, v, y_val, u_val, v_val);
-                
                 // 8. 颜色空间转换，将 YUV 转换为可显示的 RGB，依赖于采样的 Y, U, V 值。
-                Color rgb = yuvToRGB(y_val, u_val, v_val);
+                //    纹理开启了 RGB 缓存时，直接采样预转换的 RGB，跳过 7/8 中的颜色计算。
+                Color rgb;
+                if (texture.hasRGBCache()) {
+                    rgb = texture.sampleRGB(u, v, filter);
+                } else {
+                    unsigned char y_val, u_val, v_val;
+                    texture.sampleYUV(u, v, filter, y_val, u_val, v_val);
+                    rgb = yuvToRGB(y_val, u_val, v_val, texture.getColorSpace());
+                }
+                if (color_lut_) {
+                    rgb = color_lut_->apply(rgb);
+                }
                 
-                // 9. 将最终颜色写入帧缓冲
-                fb.setPixel(x, y, rgb);
+                // 9. 将最终颜色写入帧缓冲（经行缓冲按连续区间写入）
+                writer.put(x, rgb);
+            } else {
+                writer.skip(x);
+            }
+        }
+        writer.skip(max_x + 1);
+    }
+}
+
+void Rasterizer::drawTexturedTriangleQuads(FrameBuffer &fb, const Vertex &v0, const Vertex &v1, const Vertex &v2, const YUVTexture &texture) {
+    TriangleSetup setup(v0, v1, v2);
+    if (!setup.valid) {
+        return;
+    }
+
+    int min_x = setup.bounds.x;
+    int max_x = setup.bounds.right() - 1;
+    int min_y = setup.bounds.y;
+    int max_y = setup.bounds.bottom() - 1;
+    clampToViewport(fb.getWidth(), fb.getHeight(), min_x, max_x, min_y, max_y);
+    discardCoveredClearTiles(fb, setup, min_x, max_x, min_y, max_y);
+
+    // 块行的两行像素各用一段行缓冲
+    const int span_width = std::max(max_x - min_x + 1, 0);
+    span_buffer_.resize(2 * static_cast<size_t>(span_width));
+
+    // 以 2×2 块为单位遍历；块内未被覆盖的像素同样计算 UV（外推后钳制），只是不写入，
+    // 这样 4 个通道始终满载，采样函数内部没有分支。
+    for (int quad_y = min_y & ~1; quad_y <= max_y; quad_y += 2) {
+        SpanWriter writers[2] = {{fb, span_buffer_.data(), min_x, quad_y},
+                                 {fb, span_buffer_.data() + span_width, min_x, quad_y + 1}};
+        for (int quad_x = min_x & ~1; quad_x <= max_x; quad_x += 2) {
+            bool covered[4];
+            float tex_u[4], tex_v[4];
+            bool any_covered = false;
+            for (int i = 0; i < 4; ++i) {
+                int x = quad_x + (i & 1);
+                int y = quad_y + (i >> 1);
+                float w0, w1, w2;
+                bool inside = setup.coverage(x, y, w0, w1, w2);
+                covered[i] = inside && x >= min_x && x <= max_x && y >= min_y && y <= max_y;
+                any_covered |= covered[i];
+                Interpolator::interpolateUV(w0, w1, w2, v0, v1, v2, tex_u[i], tex_v[i]);
+            }
+            if (!any_covered) {
+                writers[0].skip(quad_x);
+                writers[1].skip(quad_x);
+                continue;
+            }
+
+            unsigned char y_val[4], u_val[4], v_val[4];
+            texture.sampleBilinearQuad(tex_u, tex_v, y_val, u_val, v_val);
+
+            for (int i = 0; i < 4; ++i) {
+                SpanWriter &writer = writers[i >> 1];
+                if (covered[i]) {
+                    Color rgb = yuvToRGB(y_val[i], u_val[i], v_val[i], texture.getColorSpace());
+                    if (color_lut_) {
+                        rgb = color_lut_->apply(rgb);
+                    }
+                    writer.put(quad_x + (i & 1), rgb);
+                } else {
+                    writer.skip(quad_x + (i & 1));
+                }
+            }
+        }
+        writers[0].skip(max_x + 1);
+        writers[1].skip(max_x + 1);
+    }
+}
+
+void Rasterizer::drawTexturedTriangle(YUVFrameBuffer &fb, const Vertex &v0, const Vertex &v1, const Vertex &v2, const YUVTexture &texture) {
+    TriangleSetup setup(v0, v1, v2);
+    if (!setup.valid) {
+        return;
+    }
+
+    int min_x = setup.bounds.x;
+    int max_x = setup.bounds.right() - 1;
+    int min_y = setup.bounds.y;
+    int max_y = setup.bounds.bottom() - 1;
+    clampToViewport(fb.getWidth(), fb.getHeight(), min_x, max_x, min_y, max_y);
+
+    const TextureFilter filter = filterOf(texture);
+    const bool needs_conversion = texture.getColorSpace() != fb.getColorSpace();
+
+    // 以 2×2 像素块为单位遍历，块左上角对齐到偶数坐标，与色度平面一一对应
+    for (int quad_y = min_y & ~1; quad_y <= max_y; quad_y += 2) {
+        for (int quad_x = min_x & ~1; quad_x <= max_x; quad_x += 2) {
+            // 1. 块内四个像素的覆盖与 UV
+            bool covered[4];
+            float tex_u[4], tex_v[4];
+            int covered_count = 0;
+            int offset_x = 0, offset_y = 0; // 被覆盖像素相对块左上角的偏移之和
+            for (int i = 0; i < 4; ++i) {
+                int x = quad_x + (i & 1);
+                int y = quad_y + (i >> 1);
+                float w0, w1, w2;
+                covered[i] = x >= min_x && x <= max_x && y >= min_y && y <= max_y &&
+                             setup.coverage(x, y, w0, w1, w2);
+                if (covered[i]) {
+                    Interpolator::interpolateUV(w0, w1, w2, v0, v1, v2, tex_u[i], tex_v[i]);
+                    ++covered_count;
+                    offset_x += i & 1;
+                    offset_y += i >> 1;
+                }
+            }
+            if (covered_count == 0) {
+                continue;
+            }
+
+            // 2. 色度：在被覆盖像素中心的重心处插值 UV 并采样一次（整块覆盖时即块中心 (quad_x + 1, quad_y + 1)），
+            // 凸三角形内的像素中心的重心仍在三角形内，不会采样到三角形以外的纹理
+            float w0, w1, w2;
+            setup.barycentric(static_cast<float>(quad_x) + 0.5f + static_cast<float>(offset_x) / covered_count,
+                              static_cast<float>(quad_y) + 0.5f + static_cast<float>(offset_y) / covered_count, w0, w1, w2);
+            float center_u, center_v;
+            Interpolator::interpolateUV(w0, w1, w2, v0, v1, v2, center_u, center_v);
+            unsigned char chroma_u, chroma_v;
+            texture.sampleChroma(center_u, center_v, filter, chroma_u, chroma_v);
+
+            // 部分覆盖的块：色度样本由 4 个像素共享，按被覆盖的像素数与原有色度加权混合，
+            // 未覆盖像素（背景）的颜色不被三角形的色度完全替换
+            auto writeChroma = [&](int out_u, int out_v) {
+                if (covered_count < 4) {
+                    unsigned char old_u, old_v;
+                    fb.getChroma(quad_x / 2, quad_y / 2, old_u, old_v);
+                    out_u = (out_u * covered_count + old_u * (4 - covered_count) + 2) / 4;
+                    out_v = (out_v * covered_count + old_v * (4 - covered_count) + 2) / 4;
+                }
+                fb.setChroma(quad_x / 2, quad_y / 2, static_cast<unsigned char>(out_u), static_cast<unsigned char>(out_v));
+            };
+
+            // 3. 亮度逐像素写入
+            if (!needs_conversion) {
+                for (int i = 0; i < 4; ++i) {
+                    if (covered[i]) {
+                        fb.setLuma(quad_x + (i & 1), quad_y + (i >> 1), texture.sampleLuma(tex_u[i], tex_v[i], filter));
+                    }
+                }
+                writeChroma(chroma_u, chroma_v);
+                continue;
+            }
+
+            // 标准不一致：经 RGB 转换，块内转换后的色度取平均
+            int sum_u = 0, sum_v = 0, count = 0;
+            for (int i = 0; i < 4; ++i) {
+                if (!covered[i]) {
+                    continue;
+                }
+                unsigned char luma = texture.sampleLuma(tex_u[i], tex_v[i], filter);
+                Color rgb = yuvToRGB(luma, chroma_u, chroma_v, texture.getColorSpace());
+                unsigned char out_y, out_u, out_v;
+                rgbToYUV(rgb, out_y, out_u, out_v, fb.getColorSpace());
+                fb.setLuma(quad_x + (i & 1), quad_y + (i >> 1), out_y);
+                sum_u += out_u;
+                sum_v += out_v;
+                ++count;
+            }
+            writeChroma((sum_u + count / 2) / count, (sum_v + count / 2) / count);
+        }
+    }
+}
+
+void Rasterizer::collectFootprint(int fb_width, int fb_height, const Vertex &v0, const Vertex &v1, const Vertex &v2, VirtualYUVTexture &texture) const {
+    TriangleSetup setup(v0, v1, v2);
+    if (!setup.valid) return;
+
+    int min_x = setup.bounds.x;
+    int max_x = setup.bounds.right() - 1;
+    int min_y = setup.bounds.y;
+    int max_y = setup.bounds.bottom() - 1;
+    clampToViewport(fb_width, fb_height, min_x, max_x, min_y, max_y);
+    if (min_x > max_x || min_y > max_y) {
+        return;
+    }
+
+    // UV 是屏幕坐标的仿射函数，可见区域内的极值一定出现在包围盒的角上
+    float u_min = std::numeric_limits<float>::max();
+    float u_max = std::numeric_limits<float>::lowest();
+    float v_min = u_min;
+    float v_max = u_max;
+    const int corner_x[2] = {min_x, max_x};
+    const int corner_y[2] = {min_y, max_y};
+    for (int cy : corner_y) {
+        for (int cx : corner_x) {
+            float w0, w1, w2, u, v;
+            setup.barycentric(static_cast<float>(cx) + 0.5f, static_cast<float>(cy) + 0.5f, w0, w1, w2);
+            Interpolator::interpolateUV(w0, w1, w2, v0, v1, v2, u, v);
+            u_min = std::min(u_min, u);
+            u_max = std::max(u_max, u);
+            v_min = std::min(v_min, v);
+            v_max = std::max(v_max, v);
+        }
+    }
+
+    // 与顶点 UV 范围求交（三角形内的 UV 不会超出顶点 UV 的凸包）
+    u_min = std::max(u_min, std::min({v0.u, v1.u, v2.u}));
+    u_max = std::min(u_max, std::max({v0.u, v1.u, v2.u}));
+    v_min = std::max(v_min, std::min({v0.v, v1.v, v2.v}));
+    v_max = std::min(v_max, std::max({v0.v, v1.v, v2.v}));
+    if (u_min > u_max || v_min > v_max) {
+        return;
+    }
+    texture.requestRegion(u_min, v_min, u_max, v_max);
+}
+
+void Rasterizer::drawTexturedTriangle(FrameBuffer &fb, const Vertex &v0, const Vertex &v1, const Vertex &v2, const VirtualYUVTexture &texture) {
+    TriangleSetup setup(v0, v1, v2);
+    if (!setup.valid) return;
+
+    int min_x = setup.bounds.x;
+    int max_x = setup.bounds.right() - 1;
+    int min_y = setup.bounds.y;
+    int max_y = setup.bounds.bottom() - 1;
+    clampToViewport(fb.getWidth(), fb.getHeight(), min_x, max_x, min_y, max_y);
+    discardCoveredClearTiles(fb, setup, min_x, max_x, min_y, max_y);
+
+    span_buffer_.resize(static_cast<size_t>(std::max(max_x - min_x + 1, 0)));
+    for (int y = min_y; y <= max_y; ++y) {
+        SpanWriter writer{fb, span_buffer_.data(), min_x, y};
+        for (int x = min_x; x <= max_x; ++x) {
+            float w0, w1, w2;
+            if (!setup.coverage(x, y, w0, w1, w2)) {
+                writer.skip(x);
+                continue;
+            }
+            float u, v;
+            Interpolator::interpolateUV(w0, w1, w2, v0, v1, v2, u, v);
+
+            unsigned char y_val, u_val, v_val;
+            texture.sampleYUV(u, v, y_val, u_val, v_val);
+            Color rgb = yuvToRGB(y_val, u_val, v_val, texture.getColorSpace());
+            if (color_lut_) {
+                rgb = color_lut_->apply(rgb);
             }
+            writer.put(x, rgb);
         }
+        writer.skip(max_x + 1);
     }
 }
 
+bool Rasterizer::canUseShearPath(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Vertex &v3,
+                                 const YUVTexture &texture) const {
+    // 最近点过滤和 RGB 缓存的语义是逐像素采样，保持三角形路径
+    if (!shear_path_enabled_ || filterOf(texture) != TextureFilter::BILINEAR || texture.hasRGBCache()) {
+        return false;
+    }
+    // 平行四边形：对角线中点重合（屏幕坐标容差 1/1000 像素，UV 容差 1e-6）
+    if (std::abs(v0.x + v2.x - v1.x - v3.x) > 1e-3f || std::abs(v0.y + v2.y - v1.y - v3.y) > 1e-3f ||
+        std::abs(v0.u + v2.u - v1.u - v3.u) > 1e-6f || std::abs(v0.v + v2.v - v1.v - v3.v) > 1e-6f) {
+        return false;
+    }
+    // UV 超出 [0, 1] 时三角形路径逐像素钳制到边缘，剪切分解中的钳制发生在剪切后的坐标上，两者不一致
+    for (const Vertex *vertex : {&v0, &v1, &v2, &v3}) {
+        if (vertex->u < 0.0f || vertex->u > 1.0f || vertex->v < 0.0f || vertex->v > 1.0f) {
+            return false;
+        }
+    }
+    // 小四边形的建立开销不划算；强烈缩小时三趟剪切要遍历整片源图，不如逐像素只采样需要的点
+    constexpr float kMinShearPixels = 64.0f * 64.0f;
+    constexpr float kMaxMinification = 4.0f;
+    const float screen_area = std::abs(edgeFunction(v0.x, v0.y, v1.x, v1.y, v3.x, v3.y));
+    const float texel_area = std::abs((v1.u - v0.u) * (v3.v - v0.v) - (v1.v - v0.v) * (v3.u - v0.u)) *
+                             static_cast<float>(texture.getWidth()) * static_cast<float>(texture.getHeight());
+    return screen_area >= kMinShearPixels && texel_area <= kMaxMinification * screen_area;
+}
+
+void Rasterizer::drawTexturedQuad(FrameBuffer &fb, const Vertex &v0, const Vertex &v1, const Vertex &v2, const Vertex &v3, const YUVTexture &texture) {
+    if (canUseShearPath(v0, v1, v2, v3, texture)) {
+        int min_x = static_cast<int>(std::floor(std::min({v0.x, v1.x, v2.x, v3.x})));
+        int max_x = static_cast<int>(std::ceil(std::max({v0.x, v1.x, v2.x, v3.x})));
+        int min_y = static_cast<int>(std::floor(std::min({v0.y, v1.y, v2.y, v3.y})));
+        int max_y = static_cast<int>(std::ceil(std::max({v0.y, v1.y, v2.y, v3.y})));
+        clampToViewport(fb.getWidth(), fb.getHeight(), min_x, max_x, min_y, max_y);
+        if (fb.hasPendingClear()) {
+            discardCoveredClearTiles(fb, TriangleSetup(v0, v1, v2), min_x, max_x, min_y, max_y);
+            discardCoveredClearTiles(fb, TriangleSetup(v0, v2, v3), min_x, max_x, min_y, max_y);
+        }
+        const Rect clip(min_x, min_y, max_x - min_x + 1, max_y - min_y + 1);
+        if (clip.empty() || shear_rotator_.draw(fb, texture, v0, v1, v3, clip, color_lut_)) {
+            return;
+        }
+    }
+    drawTexturedTriangle(fb, v0, v1, v2, texture);
+    drawTexturedTriangle(fb, v0, v2, v3, texture);
+}
+
 void Rasterizer::drawSolidTriangle(FrameBuffer& fb,
                                    const Vertex& v0,
                                    const Vertex& v1,
                                    const Vertex& v2,
                                    const Color& color) {
-    // 复用 drawTexturedTriangle 中的预计算优化逻辑
-    const float total_area_2X = edgeFunction(v0.x, v0.y, v1.x, v1.y, v2.x, v2.y);
-    if (std::abs(total_area_2X) < 1e-6) return;
-    
-    const float inv_total_area_2X = 1.0f / total_area_2X;
-    
-    // 预计算系数（与drawTexturedTriangle相同）
-    float A_for_w0 = v2.x - v1.x;
-    float B_for_w0 = v2.y - v1.y;
-    float C_for_w0 = -(A_for_w0 * v1.y - B_for_w0 * v1.x);
-    
-    float A_for_w1 = v0.x - v2.x;
-    float B_for_w1 = v0.y - v2.y;
-    float C_for_w1 = -(A_for_w1 * v2.y - B_for_w1 * v2.x);
+    // 复用 drawTexturedTriangle 中的预计算优化逻辑（系数、包围盒、覆盖判定见 TriangleSetup）
+    TriangleSetup setup(v0, v1, v2);
+    if (!setup.valid) return;
     
-    // 包围盒计算
-    int min_x = static_cast<int>(std::floor(std::min({v0.x, v1.x, v2.x})));
-    int max_x = static_cast<int>(std::ceil(std::max({v0.x, v1.x, v2.x})));
-    int min_y = static_cast<int>(std::floor(std::min({v0.y, v1.y, v2.y})));
-    int max_y = static_cast<int>(std::ceil(std::max({v0.y, v1.y, v2.y})));
+    int min_x = setup.bounds.x;
+    int max_x = setup.bounds.right() - 1;
+    int min_y = setup.bounds.y;
+    int max_y = setup.bounds.bottom() - 1;
     
     // 钳制
-    min_x = std::max(0, min_x);
-    max_x = std::min(max_x, fb.getWidth() - 1);
-    min_y = std::max(0, min_y);
-    max_y = std::min(max_y, fb.getHeight() - 1);
+    clampToViewport(fb.getWidth(), fb.getHeight(), min_x, max_x, min_y, max_y);
+    discardCoveredClearTiles(fb, setup, min_x, max_x, min_y, max_y);
+
+    // 整个三角形同一种颜色，查表一次即可
+    const Color shaded = color_lut_ ? color_lut_->apply(color) : color;
     
-    // 光栅化，像素坐标 -> 纹理坐标
-    for (int x = min_x; x <= max_x; ++x) {
-        for (int y = min_y; y <= max_y; ++y) {
-            // 取像素中心作为像素块唯一代表
-            float px = static_cast<float>(x) + 0.5f;
-            float py = static_cast<float>(y) + 0.5f;
-            
-            // 使用优化版重心坐标计算
-            float area_w0 = A_for_w0 * py - B_for_w0 * px + C_for_w0;
-            float area_w1 = A_for_w1 * py - B_for_w1 * px + C_for_w1;
-            
-            float w0 = area_w0 * inv_total_area_2X;
-            float w1 = area_w1 * inv_total_area_2X;
-            float w2 = 1.0f - w0 - w1;
-            
-            if (w0 >= -1e-5f && w1 >= -1e-5f && w2 >= -1e-5f) {
-                fb.setPixel(x, y, color);
+    /**
+     * 扫描线填充：纯色三角形不需要逐像素的属性，只需要知道每一行被覆盖的区间 [left, right]。
+     * 在固定的 py 上，w0、w1、w2 都是 px 的一次函数 w = k × px + c，
+     * 三个不等式 w >= -ε 各给出 px 的一个半无限区间，求交即得该行的覆盖区间。
+     * 三角形是凸的，所以每行的覆盖一定是连续的一段，可以整段写入。
+     */
+    auto covered = [&setup](int x, int y) {
+        float w0, w1, w2;
+        return setup.coverage(x, y, w0, w1, w2);
+    };
+    
+    for (int y = min_y; y <= max_y; ++y) {
+        const float py = static_cast<float>(y) + 0.5f;
+        
+        // 三条边在本行的 k、c（w2 = 1 - w0 - w1）
+        const float k0 = -setup.B0 * setup.inv_area_2X;
+        const float c0 = (setup.A0 * py + setup.C0) * setup.inv_area_2X;
+        const float k1 = -setup.B1 * setup.inv_area_2X;
+        const float c1 = (setup.A1 * py + setup.C1) * setup.inv_area_2X;
+        const float ks[3] = {k0, k1, -k0 - k1};
+        const float cs[3] = {c0, c1, 1.0f - c0 - c1};
+        
+        float lo = static_cast<float>(min_x);
+        float hi = static_cast<float>(max_x) + 1.0f;
+        for (int e = 0; e < 3; ++e) {
+            if (ks[e] > 0.0f) {
+                lo = std::max(lo, (-1e-5f - cs[e]) / ks[e]);
+            } else if (ks[e] < 0.0f) {
+                hi = std::min(hi, (-1e-5f - cs[e]) / ks[e]);
+            } else if (cs[e] < -1e-5f) {
+                lo = hi + 1.0f; // 与该边平行且在外侧，本行为空
+            }
+        }
+        if (lo > hi) {
+            continue;
+        }
+        
+        // px = x + 0.5，换算成像素下标，再钳制到包围盒
+        int left = std::max(min_x, static_cast<int>(std::ceil(lo - 0.5f)));
+        int right = std::min(max_x, static_cast<int>(std::floor(hi - 0.5f)));
+        
+        // 解析解存在浮点误差：用逐像素判定修正两个端点，保证与逐像素光栅化的结果完全一致
+        while (left <= right && !covered(left, y)) ++left;
+        while (left > min_x && covered(left - 1, y)) --left;
+        while (right >= left && !covered(right, y)) --right;
+        while (right < max_x && right >= left && covered(right + 1, y)) ++right;
+        
+        if (left <= right) {
+            fb.fillSpan(y, left, right + 1, shaded);
+        }
+    }
+}
+
+void Rasterizer::drawSprites(FrameBuffer &fb, const SpriteBatch &batch, const YUVTexture &texture) {
+    const size_t count = batch.size();
+    if (count == 0) {
+        return;
+    }
+
+    // 视口：帧缓冲与裁剪矩形的交集，换算成半开区间 [view_x0, view_x1) × [view_y0, view_y1)
+    int view_x0 = 0, view_x1 = fb.getWidth() - 1, view_y0 = 0, view_y1 = fb.getHeight() - 1;
+    clampToViewport(fb.getWidth(), fb.getHeight(), view_x0, view_x1, view_y0, view_y1);
+    ++view_x1;
+    ++view_y1;
+
+    // 1. 建立：对整批精灵逐数组计算。覆盖像素中心在 [x, x + w) 内的像素，即 [ceil(x - 0.5), ceil(x + w - 0.5))
+    SpriteSetup &setup = sprite_setup_;
+    for (std::vector<int> *column : {&setup.x0, &setup.x1, &setup.y0, &setup.y1}) {
+        column->resize(count);
+    }
+    for (std::vector<float> *column : {&setup.u, &setup.du, &setup.v, &setup.dv}) {
+        column->resize(count);
+    }
+    const float *xs = batch.getX(), *ys = batch.getY(), *ws = batch.getWidth(), *hs = batch.getHeight();
+    const float *u0s = batch.getU0(), *v0s = batch.getV0(), *u1s = batch.getU1(), *v1s = batch.getV1();
+    for (size_t i = 0; i < count; ++i) {
+        const int x0 = std::max(static_cast<int>(std::ceil(xs[i] - 0.5f)), view_x0);
+        const int x1 = std::min(static_cast<int>(std::ceil(xs[i] + ws[i] - 0.5f)), view_x1);
+        const float du = ws[i] > 0.0f ? (u1s[i] - u0s[i]) / ws[i] : 0.0f;
+        setup.x0[i] = x0;
+        setup.x1[i] = x1;
+        setup.du[i] = du;
+        setup.u[i] = u0s[i] + (static_cast<float>(x0) + 0.5f - xs[i]) * du;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        const int y0 = std::max(static_cast<int>(std::ceil(ys[i] - 0.5f)), view_y0);
+        const int y1 = std::min(static_cast<int>(std::ceil(ys[i] + hs[i] - 0.5f)), view_y1);
+        const float dv = hs[i] > 0.0f ? (v1s[i] - v0s[i]) / hs[i] : 0.0f;
+        setup.y0[i] = y0;
+        setup.y1[i] = y1;
+        setup.dv[i] = dv;
+        setup.v[i] = v0s[i] + (static_cast<float>(y0) + 0.5f - ys[i]) * dv;
+    }
+
+    // 2. 逐精灵逐行着色，整行写入
+    const TextureFilter filter = filterOf(texture);
+    const bool nearest = filter == TextureFilter::NEAREST && !texture.hasRGBCache();
+    const bool bilinear = filter == TextureFilter::BILINEAR && !texture.hasRGBCache();
+    const int tex_w = texture.getWidth();
+    const int tex_h = texture.getHeight();
+    const ColorSpaceStandard standard = texture.getColorSpace();
+    for (size_t i = 0; i < count; ++i) {
+        const int x0 = setup.x0[i], x1 = setup.x1[i];
+        const int y0 = setup.y0[i], y1 = setup.y1[i];
+        if (x0 >= x1 || y0 >= y1) {
+            continue;
+        }
+        const int width = x1 - x0;
+        if (span_buffer_.size() < 2 * static_cast<size_t>(width)) {
+            span_buffer_.resize(2 * static_cast<size_t>(width));
+        }
+
+        // 双线性过滤：与三角形路径相同，按 2×2 像素块调用定点的 sampleBilinearQuad，两行各用一段行缓冲
+        if (bilinear) {
+            Color *rows[2] = {span_buffer_.data(), span_buffer_.data() + width};
+            for (int y = y0; y < y1; y += 2) {
+                const float v_top = setup.v[i] + static_cast<float>(y - y0) * setup.dv[i];
+                const float v_bottom = v_top + setup.dv[i];
+                for (int c = 0; c < width; c += 2) {
+                    const float u_left = std::clamp(setup.u[i] + static_cast<float>(c) * setup.du[i], 0.0f, 1.0f);
+                    const float u_right = std::clamp(setup.u[i] + static_cast<float>(c + 1) * setup.du[i], 0.0f, 1.0f);
+                    const float tex_u[4] = {u_left, u_right, u_left, u_right};
+                    const float tex_v[4] = {std::clamp(v_top, 0.0f, 1.0f), std::clamp(v_top, 0.0f, 1.0f),
+                                            std::clamp(v_bottom, 0.0f, 1.0f), std::clamp(v_bottom, 0.0f, 1.0f)};
+                    unsigned char y_val[4], u_val[4], v_val[4];
+                    texture.sampleBilinearQuad(tex_u, tex_v, y_val, u_val, v_val);
+                    // 宽度为奇数时最后一块的右列、高度为奇数时最后一块的下行算了不写
+                    for (int k = 0; k < 4; ++k) {
+                        const int column = c + (k & 1);
+                        if (column < width) {
+                            Color rgb = yuvToRGB(y_val[k], u_val[k], v_val[k], standard);
+                            rows[k >> 1][column] = color_lut_ ? color_lut_->apply(rgb) : rgb;
+                        }
+                    }
+                }
+                fb.writeSpan(y, x0, rows[0], width);
+                if (y + 1 < y1) {
+                    fb.writeSpan(y + 1, x0, rows[1], width);
+                }
+            }
+            continue;
+        }
+
+        // 最近点过滤：各列的纹素列号（与 YUVTexture::sampleNearest 相同的取整和钳位）只算一次
+        if (nearest) {
+            sprite_columns_.resize(static_cast<size_t>(width));
+            for (int c = 0; c < width; ++c) {
+                const float u = setup.u[i] + static_cast<float>(c) * setup.du[i];
+                sprite_columns_[c] = std::clamp(static_cast<int>(u * tex_w), 0, tex_w - 1);
+            }
+        }
+
+        Color *out = span_buffer_.data();
+        for (int y = y0; y < y1; ++y) {
+            const float v = setup.v[i] + static_cast<float>(y - y0) * setup.dv[i];
+            if (nearest) {
+                const int ty = std::clamp(static_cast<int>(v * tex_h), 0, tex_h - 1);
+                const unsigned char *y_row = texture.getYData() + static_cast<size_t>(ty) * texture.getYStride();
+                const unsigned char *u_row = texture.getUData() + static_cast<size_t>(ty / 2) * texture.getUStride();
+                const unsigned char *v_row = texture.getVData() + static_cast<size_t>(ty / 2) * texture.getVStride();
+                for (int c = 0; c < width; ++c) {
+                    const int tx = sprite_columns_[c];
+                    out[c] = yuvToRGB(y_row[tx], u_row[tx / 2], v_row[tx / 2], standard);
+                }
+            } else {
+                // 开启了 RGB 缓存：直接采样预转换的 RGB
+                for (int c = 0; c < width; ++c) {
+                    out[c] = texture.sampleRGB(setup.u[i] + static_cast<float>(c) * setup.du[i], v, filter);
+                }
+            }
+            if (color_lut_) {
+                for (int c = 0; c < width; ++c) {
+                    out[c] = color_lut_->apply(out[c]);
+                }
             }
+            fb.writeSpan(y, x0, out, width);
         }
     }
 }
@@ -10,8 +10,13 @@
 
 #include <vector>
 #include "geometry/Vertex.hpp"
+#include "core/Rect.hpp"
 #include "core/FrameBuffer.hpp"
+#include "core/YUVFrameBuffer.hpp"
 #include "texture/YUVTexture.hpp"
+#include "texture/VirtualYUVTexture.hpp"
+#include "texture/ColorLUT.hpp"
+#include "ShearRotator.hpp"
 
 // 光栅化
 /**
@@ -22,12 +27,16 @@
  * Rasterizer光栅化
  *     ├── 纹理采样 ← YUVTexture.sampleYUV()
  *     ├── 色彩空间转换 ← ColorSpace::yuvToRGB()
+ *     ├── 调色（可选）← ColorLUT::apply()
  *     └── 像素写入 ← FrameBuffer.setPixel()
  *     ↓
  * FrameBuffer (存储最终结果)
  */
 
 namespace SoftRenderer {
+    struct TriangleSetup;
+    class SpriteBatch;
+
     class Rasterizer {
     public:
         Rasterizer() = default;
@@ -46,6 +55,50 @@ namespace SoftRenderer {
                                   const Vertex& v2,
                                   const YUVTexture& texture);
         
+        /**
+         * 绘制三角形到 YUV420 渲染目标：亮度逐像素采样写入，色度每个 2×2 像素块在被覆盖像素的重心处采样一次。
+         * 纹理与目标的颜色空间标准一致时不做任何颜色转换；不一致时经 RGB 转换到目标标准。
+         * 只被三角形部分覆盖的 2×2 块按覆盖像素数（n / 4）与原有色度混合（与编码器的 4:2:0 降采样行为一致）。
+         */
+        void drawTexturedTriangle(YUVFrameBuffer& fb,
+                                  const Vertex& v0,
+                                  const Vertex& v1,
+                                  const Vertex& v2,
+                                  const YUVTexture& texture);
+        
+        /**
+         * 绘制三角形并从虚拟纹理采样。应先对本帧所有三角形调用 collectFootprint 并 commitRequests，
+         * 否则缺页会在采样时同步加载（结果相同，但 I/O 落在绘制循环中）。
+         */
+        void drawTexturedTriangle(FrameBuffer& fb,
+                                  const Vertex& v0,
+                                  const Vertex& v1,
+                                  const Vertex& v2,
+                                  const VirtualYUVTexture& texture);
+
+        /**
+         * 虚拟纹理的反馈阶段：不写入像素，只把三角形在视口（及裁剪矩形）内可见部分的 UV 包围盒提交给 texture。
+         * 包围盒取“可见包围盒四角外推的 UV”与“三个顶点 UV”范围的交集，两者都是保守估计。
+         */
+        void collectFootprint(int fb_width, int fb_height,
+                              const Vertex& v0,
+                              const Vertex& v1,
+                              const Vertex& v2,
+                              VirtualYUVTexture& texture) const;
+        
+        /**
+         * 绘制纹理四边形，v0 → v1 → v2 → v3 沿边界依次排列，等价于绘制三角形 (v0, v1, v2) 和 (v0, v2, v3)。
+         * 四边形是平行四边形（屏幕坐标和 UV 都满足 v0 + v2 = v1 + v3，即整张图像经过仿射变换）、
+         * UV 在 [0, 1] 内、双线性过滤且面积足够大时，自动改用 ShearRotator 的三趟剪切路径，
+         * 结果与三角形路径每个分量通常相差 1~2 级；其他情况按两个三角形绘制。
+         */
+        void drawTexturedQuad(FrameBuffer& fb,
+                              const Vertex& v0,
+                              const Vertex& v1,
+                              const Vertex& v2,
+                              const Vertex& v3,
+                              const YUVTexture& texture);
+
         // 辅助方法：绘制纯色三角形（用于调试）
         void drawSolidTriangle(FrameBuffer& fb,
                                const Vertex& v0,
@@ -53,7 +106,85 @@ namespace SoftRenderer {
                                const Vertex& v2,
                                const Color& color);
 
+        /**
+         * 批量绘制轴对齐精灵（见 SpriteBatch），所有精灵采样同一张纹理（通常是 TextureAtlas::getTexture()）。
+         * 先对整批精灵逐数组建立（像素范围、起始纹理坐标和步长，裁剪到帧缓冲和裁剪矩形），
+         * 再逐精灵逐行着色并整行写入；最近点过滤时每个精灵的纹素列号只计算一次，各行复用。
+         * 按批次中的顺序绘制，后面的精灵覆盖前面的。
+         */
+        void drawSprites(FrameBuffer& fb, const SpriteBatch& batch, const YUVTexture& texture);
+
+        /**
+         * 裁剪矩形（Scissor）：设置后只写入矩形内的像素，用于分块（Tile）渲染和局部重绘。
+         * 与 FrameBuffer 边界取交集，不影响三角形本身的几何计算。
+         */
+        void setScissor(const Rect& scissor) { scissor_ = scissor; has_scissor_ = true; }
+        void clearScissor() { has_scissor_ = false; }
+
+        /**
+         * 过滤方式覆盖：设置后 YUVTexture 的绘制一律按 filter 采样（包括路径选择），忽略纹理自身的过滤模式。
+         * 纹理不被修改，同一张纹理可以同时被多个以不同过滤方式绘制的 Rasterizer 只读共享（CommandBuffer::replay）。
+         */
+        void setFilterOverride(TextureFilter filter) { filter_override_ = filter; has_filter_override_ = true; }
+        void clearFilterOverride() { has_filter_override_ = false; }
+        bool hasFilterOverride() const { return has_filter_override_; }
+        TextureFilter getFilterOverride() const { return filter_override_; }
+
+        /**
+         * 3D LUT 调色：设置后绘制到 RGB 帧缓冲的每个像素在 yuvToRGB 之后立即查表（纯色三角形对颜色查表一次），
+         * 省去对整帧输出的单独一趟。lut 由调用方持有，需存活到不再绘制；传 nullptr 关闭。
+         * YUV 渲染目标不受影响。
+         */
+        void setColorLUT(const ColorLUT* lut) { color_lut_ = lut; }
+        const ColorLUT* getColorLUT() const { return color_lut_; }
+
+        // 是否允许 drawTexturedQuad 使用三趟剪切路径（默认允许；AutoTuner 按实测结果设置）
+        void setShearPathEnabled(bool enabled) { shear_path_enabled_ = enabled; }
+        bool isShearPathEnabled() const { return shear_path_enabled_; }
+
     private:
+        // 将包围盒 [min_x, max_x] × [min_y, max_y]（闭区间）钳制到帧缓冲和裁剪矩形内
+        void clampToViewport(int fb_width, int fb_height, int& min_x, int& max_x, int& min_y, int& max_y) const;
+
+        /**
+         * 惰性清屏配合：包围盒 [min_x, max_x] × [min_y, max_y] 内被三角形完整覆盖的待清除 Tile
+         * 马上会被逐像素写满，直接放弃其清除，省去一次多余的填充。
+         */
+        void discardCoveredClearTiles(FrameBuffer& fb, const TriangleSetup& setup,
+                                      int min_x, int max_x, int min_y, int max_y) const;
+
+        // 双线性过滤的快速路径：按 2×2 像素块着色，共享色度纹素读取，使用定点权重
+        void drawTexturedTriangleQuads(FrameBuffer& fb,
+                                       const Vertex& v0,
+                                       const Vertex& v1,
+                                       const Vertex& v2,
+                                       const YUVTexture& texture);
+
+        // 本次绘制使用的过滤方式：设置了覆盖时为覆盖值，否则为纹理自身的过滤模式
+        TextureFilter filterOf(const YUVTexture& texture) const {
+            return has_filter_override_ ? filter_override_ : texture.getFilterMode();
+        }
+
+        // 四边形能否走三趟剪切路径（见 drawTexturedQuad）
+        bool canUseShearPath(const Vertex& v0, const Vertex& v1, const Vertex& v2, const Vertex& v3,
+                             const YUVTexture& texture) const;
+
+        Rect scissor_;
+        bool has_scissor_ = false;
+        TextureFilter filter_override_ = TextureFilter::NEAREST;
+        bool has_filter_override_ = false;
+        const ColorLUT* color_lut_ = nullptr;
+        bool shear_path_enabled_ = true;
+        ShearRotator shear_rotator_; // 三趟剪切路径的临时缓冲在多次绘制间复用
+        std::vector<Color> span_buffer_; // 逐像素路径的行缓冲，着色结果按连续区间整段写入帧缓冲
+
+        // drawSprites 的建立结果（SoA）：像素范围 [x0, x1) × [y0, y1)，首个像素中心的纹理坐标及每像素步长
+        struct SpriteSetup {
+            std::vector<int> x0, x1, y0, y1;
+            std::vector<float> u, du, v, dv;
+        };
+        SpriteSetup sprite_setup_;
+        std::vector<int> sprite_columns_; // 最近点过滤时当前精灵各列的纹素列号
     };
 
 } // namespace SoftRenderer
@@ -0,0 +1,346 @@
+//
+//  RealtimeRenderer.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include "RealtimeRenderer.hpp"
+
+namespace SoftRenderer {
+
+    namespace {
+        // 各档位相对 FULL 的名义开销，用于推算还没有实测过的档位
+        constexpr double kNominalCost[kRealtimeQualityCount] = {1.0, 0.85, 0.55, 0.3, 0.18};
+        constexpr float kScale[kRealtimeQualityCount] = {1.0f, 1.0f, 0.75f, 0.5f, 0.5f};
+        constexpr int kBandRows = 64;        // SCALE_50_HALF 交替重绘的条带高度（低分辨率缓冲中的行数）
+        constexpr double kRateSmoothing = 0.3; // 速率的指数滑动平均系数
+
+        // 三角形覆盖的像素数估计：面积，但不超过包围盒与帧缓冲的交集
+        double coveredPixels(const Vertex &v0, const Vertex &v1, const Vertex &v2, int width, int height) {
+            const double area = 0.5 * std::abs((v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y));
+            const double x0 = std::max(0.0f, std::min({v0.x, v1.x, v2.x}));
+            const double x1 = std::min(static_cast<float>(width), std::max({v0.x, v1.x, v2.x}));
+            const double y0 = std::max(0.0f, std::min({v0.y, v1.y, v2.y}));
+            const double y1 = std::min(static_cast<float>(height), std::max({v0.y, v1.y, v2.y}));
+            if (x0 >= x1 || y0 >= y1) {
+                return 0.0;
+            }
+            return std::min(area, (x1 - x0) * (y1 - y0));
+        }
+
+        Vertex scaled(const Vertex &v, float scale) {
+            Vertex out = v;
+            out.x *= scale;
+            out.y *= scale;
+            return out;
+        }
+    }
+
+    const char *realtimeQualityName(RealtimeQuality quality) {
+        switch (quality) {
+            case RealtimeQuality::FULL: return "full";
+            case RealtimeQuality::NEAREST: return "nearest";
+            case RealtimeQuality::SCALE_75: return "scale75";
+            case RealtimeQuality::SCALE_50: return "scale50";
+            case RealtimeQuality::SCALE_50_HALF: return "scale50-half";
+        }
+        return "unknown";
+    }
+
+    RealtimeRenderer::RealtimeRenderer(const RealtimeSettings &settings) : settings_(settings) {
+        if (!(settings_.deadline_ms > 0.0) || !(settings_.headroom > 0.0) || !(settings_.upgrade_margin > 0.0) ||
+            settings_.history == 0) {
+            throw std::invalid_argument("RealtimeRenderer: deadline、headroom、upgrade_margin 和 history 必须大于0");
+        }
+    }
+
+    void RealtimeRenderer::beginFrame() {
+        items_.clear();
+    }
+
+    void RealtimeRenderer::drawTexturedTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const YUVTexture &texture) {
+        Item item;
+        item.v[0] = v0;
+        item.v[1] = v1;
+        item.v[2] = v2;
+        item.texture = &texture;
+        items_.push_back(item);
+    }
+
+    void RealtimeRenderer::drawTexturedQuad(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Vertex &v3,
+                                            const YUVTexture &texture) {
+        Item item;
+        item.v[0] = v0;
+        item.v[1] = v1;
+        item.v[2] = v2;
+        item.v[3] = v3;
+        item.vertex_count = 4;
+        item.texture = &texture;
+        items_.push_back(item);
+    }
+
+    void RealtimeRenderer::drawSolidTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Color &color) {
+        Item item;
+        item.v[0] = v0;
+        item.v[1] = v1;
+        item.v[2] = v2;
+        item.color = color;
+        items_.push_back(item);
+    }
+
+    double RealtimeRenderer::getEstimatedRate(RealtimeQuality quality) const {
+        const int level = static_cast<int>(quality);
+        if (measured_[level]) {
+            return rate_[level];
+        }
+        if (last_measured_ < 0) {
+            return 0.0;
+        }
+        return rate_[last_measured_] * kNominalCost[level] / kNominalCost[last_measured_];
+    }
+
+    double RealtimeRenderer::predict(int level, double workload_pixels) const {
+        return getEstimatedRate(static_cast<RealtimeQuality>(level)) * workload_pixels * 1e-6;
+    }
+
+    RealtimeQuality RealtimeRenderer::chooseQuality(double workload_pixels, double &predicted_ms) const {
+        const int worst = static_cast<int>(settings_.worst);
+        const double budget = settings_.deadline_ms * settings_.headroom;
+
+        // 速率不低于某个更高质量档位的档位降级没有收益
+        bool useful[kRealtimeQualityCount];
+        double cheapest = 0.0;
+        for (int level = 0; level <= worst; ++level) {
+            const double rate = getEstimatedRate(static_cast<RealtimeQuality>(level));
+            useful[level] = level == 0 || rate < cheapest;
+            cheapest = level == 0 ? rate : std::min(cheapest, rate);
+        }
+
+        // 满足预算的最高质量档位；都不满足时取最便宜的档位
+        int candidate = -1;
+        int fastest = 0;
+        for (int level = 0; level <= worst; ++level) {
+            if (!useful[level]) {
+                continue;
+            }
+            fastest = level;
+            if (candidate < 0 && predict(level, workload_pixels) <= budget) {
+                candidate = level;
+            }
+        }
+        if (candidate < 0) {
+            candidate = fastest;
+        }
+
+        int level = candidate;
+        const int current = std::min(current_level_, worst);
+        if (candidate < current) {
+            // 升档：一次一步到上一个有收益的档位，且要有足够余量
+            int better = current - 1;
+            while (better > 0 && !useful[better]) {
+                --better;
+            }
+            level = predict(better, workload_pixels) <= settings_.deadline_ms * settings_.upgrade_margin ? better : current;
+        }
+        predicted_ms = predict(level, workload_pixels);
+        return static_cast<RealtimeQuality>(level);
+    }
+
+    void RealtimeRenderer::drawItems(FrameBuffer &target, float scale, int band_parity) {
+        auto drawAll = [&]() {
+            for (const Item &item : items_) {
+                const Vertex v0 = scaled(item.v[0], scale);
+                const Vertex v1 = scaled(item.v[1], scale);
+                const Vertex v2 = scaled(item.v[2], scale);
+                if (!item.texture) {
+                    rasterizer_.drawSolidTriangle(target, v0, v1, v2, item.color);
+                } else if (item.vertex_count == 4) {
+                    rasterizer_.drawTexturedQuad(target, v0, v1, v2, scaled(item.v[3], scale), *item.texture);
+                } else {
+                    rasterizer_.drawTexturedTriangle(target, v0, v1, v2, *item.texture);
+                }
+            }
+        };
+
+        if (band_parity < 0) {
+            drawAll();
+            return;
+        }
+        // 只重绘奇偶性为 band_parity 的条带，每个条带单独作为裁剪矩形（已在调用方清除）
+        const int band_count = (target.getHeight() + kBandRows - 1) / kBandRows;
+        for (int band = band_parity; band < band_count; band += 2) {
+            const int y0 = band * kBandRows;
+            rasterizer_.setScissor(Rect(0, y0, target.getWidth(), std::min(kBandRows, target.getHeight() - y0)));
+            drawAll();
+        }
+        rasterizer_.clearScissor();
+    }
+
+    const RealtimeFrame &RealtimeRenderer::endFrame(FrameBuffer &fb, const Color &clear_color) {
+        const auto start = std::chrono::steady_clock::now();
+        const int width = fb.getWidth();
+        const int height = fb.getHeight();
+
+        // 1. 工作量与选档（在渲染之前决定）
+        double workload = static_cast<double>(width) * height;
+        for (const Item &item : items_) {
+            workload += coveredPixels(item.v[0], item.v[1], item.v[2], width, height);
+            if (item.vertex_count == 4) {
+                workload += coveredPixels(item.v[0], item.v[2], item.v[3], width, height);
+            }
+        }
+        RealtimeFrame frame;
+        frame.index = frame_index_++;
+        frame.workload_pixels = workload;
+        if (forced_) {
+            frame.quality = forced_quality_;
+            frame.predicted_ms = predict(static_cast<int>(forced_quality_), workload);
+        } else {
+            frame.quality = chooseQuality(workload, frame.predicted_ms);
+        }
+        const int level = static_cast<int>(frame.quality);
+
+        // 2. NEAREST 档位由光栅化器覆盖过滤方式，纹理保持不变
+        if (frame.quality == RealtimeQuality::NEAREST) {
+            rasterizer_.setFilterOverride(TextureFilter::NEAREST);
+        } else {
+            rasterizer_.clearFilterOverride();
+        }
+
+        // 3. 渲染
+        const float scale = kScale[level];
+        if (scale == 1.0f) {
+            fb.clear(clear_color);
+            drawItems(fb, 1.0f, -1);
+        } else {
+            const int low_width = std::max(1, static_cast<int>(std::lround(width * scale)));
+            const int low_height = std::max(1, static_cast<int>(std::lround(height * scale)));
+            if (!low_res_ || low_res_->getWidth() != low_width || low_res_->getHeight() != low_height) {
+                low_res_.reset(new FrameBuffer(low_width, low_height));
+                low_res_valid_ = false;
+            }
+            // 顶点按低分辨率缓冲与输出的实际比例缩放（取整后的尺寸）
+            const float draw_scale = static_cast<float>(low_width) / static_cast<float>(width);
+            if (frame.quality == RealtimeQuality::SCALE_50_HALF && low_res_valid_) {
+                const int parity = static_cast<int>(frame.index & 1);
+                for (int y0 = parity * kBandRows; y0 < low_height; y0 += 2 * kBandRows) {
+                    for (int y = y0; y < std::min(y0 + kBandRows, low_height); ++y) {
+                        low_res_->fillSpan(y, 0, low_width, clear_color);
+                    }
+                }
+                drawItems(*low_res_, draw_scale, parity);
+            } else {
+                low_res_->clear(clear_color);
+                drawItems(*low_res_, draw_scale, -1);
+            }
+            upscale(*low_res_, fb);
+        }
+        // 低分辨率缓冲只在连续使用同一分辨率时有效（全分辨率档位不更新它）
+        low_res_valid_ = scale != 1.0f;
+
+        // 4. 计时、更新速率
+        frame.render_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        frame.missed = frame.render_ms > settings_.deadline_ms;
+        const double rate = workload > 0.0 ? frame.render_ms / (workload * 1e-6) : 0.0;
+        rate_[level] = measured_[level] ? rate_[level] + kRateSmoothing * (rate - rate_[level]) : rate;
+        measured_[level] = true;
+        last_measured_ = level;
+        if (!forced_) {
+            current_level_ = level;
+        }
+        record(frame);
+        return last_frame_;
+    }
+
+    void RealtimeRenderer::record(const RealtimeFrame &frame) {
+        last_frame_ = frame;
+        ++totals_.frames;
+        totals_.missed += frame.missed ? 1 : 0;
+        ++totals_.frames_per_quality[static_cast<int>(frame.quality)];
+        if (history_ms_.size() < settings_.history) {
+            history_ms_.push_back(frame.render_ms);
+        } else {
+            history_ms_[history_next_] = frame.render_ms;
+            history_next_ = (history_next_ + 1) % settings_.history;
+        }
+    }
+
+    double RealtimeRenderer::getFrameTimePercentile(double p) const {
+        if (history_ms_.empty()) {
+            return 0.0;
+        }
+        std::vector<double> sorted(history_ms_);
+        const double clamped = std::min(100.0, std::max(0.0, p));
+        // 最近秩法：第 ceil(p / 100 × n) 小的值（至少第 1 个）
+        size_t rank = static_cast<size_t>(std::ceil(clamped / 100.0 * static_cast<double>(sorted.size())));
+        rank = std::max<size_t>(rank, 1);
+        std::nth_element(sorted.begin(), sorted.begin() + (rank - 1), sorted.end());
+        return sorted[rank - 1];
+    }
+
+    RealtimeStats RealtimeRenderer::getStats() const {
+        RealtimeStats stats = totals_;
+        stats.p50_ms = getFrameTimePercentile(50.0);
+        stats.p99_ms = getFrameTimePercentile(99.0);
+        stats.max_ms = getFrameTimePercentile(100.0);
+        return stats;
+    }
+
+    void RealtimeRenderer::resetStats() {
+        totals_ = RealtimeStats();
+        history_ms_.clear();
+        history_next_ = 0;
+    }
+
+    void RealtimeRenderer::upscale(const FrameBuffer &src, FrameBuffer &dst) {
+        const int src_width = src.getWidth();
+        const int src_height = src.getHeight();
+        const int dst_width = dst.getWidth();
+        const int dst_height = dst.getHeight();
+
+        // 源坐标（Q8）：像素中心对齐 (x + 0.5) × src / dst - 0.5，钳制到 [0, src - 1]
+        auto sourcePosition = [](int x, int src_size, int dst_size) {
+            const int64_t pos = ((2 * static_cast<int64_t>(x) + 1) * src_size * 256) / (2 * static_cast<int64_t>(dst_size)) - 128;
+            return static_cast<int>(std::min<int64_t>(std::max<int64_t>(pos, 0), static_cast<int64_t>(src_size - 1) * 256));
+        };
+        if (upscale_src_width_ != src_width || static_cast<int>(row_buffer_.size()) != dst_width) {
+            upscale_x0_.resize(dst_width);
+            upscale_x1_.resize(dst_width);
+            upscale_fx_.resize(dst_width);
+            for (int x = 0; x < dst_width; ++x) {
+                const int pos = sourcePosition(x, src_width, dst_width);
+                upscale_x0_[x] = pos >> 8;
+                upscale_x1_[x] = std::min(upscale_x0_[x] + 1, src_width - 1);
+                upscale_fx_[x] = pos & 255;
+            }
+            upscale_src_width_ = src_width;
+            row_buffer_.resize(dst_width);
+        }
+        const int *x0 = upscale_x0_.data();
+        const int *x1 = upscale_x1_.data();
+        const int *fx = upscale_fx_.data();
+        Color *row = row_buffer_.data();
+        for (int y = 0; y < dst_height; ++y) {
+            const int pos = sourcePosition(y, src_height, dst_height);
+            const int fy = pos & 255;
+            const Color *top = src.getRow(pos >> 8);
+            const Color *bottom = src.getRow(std::min((pos >> 8) + 1, src_height - 1));
+            for (int x = 0; x < dst_width; ++x) {
+                const int wx = fx[x];
+                auto lerp = [&](unsigned char Color::*channel) {
+                    const int upper = (top[x0[x]].*channel) * (256 - wx) + (top[x1[x]].*channel) * wx;
+                    const int lower = (bottom[x0[x]].*channel) * (256 - wx) + (bottom[x1[x]].*channel) * wx;
+                    return static_cast<unsigned char>((upper * (256 - fy) + lower * fy + 32768) >> 16);
+                };
+                row[x] = Color(lerp(&Color::r), lerp(&Color::g), lerp(&Color::b));
+            }
+            dst.writeSpan(y, 0, row, dst_width);
+        }
+    }
+
+} // namespace SoftRenderer
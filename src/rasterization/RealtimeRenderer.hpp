@@ -0,0 +1,164 @@
+//
+//  RealtimeRenderer.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef RealtimeRenderer_hpp
+#define RealtimeRenderer_hpp
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "Rasterizer.hpp"
+
+/**
+ * 实时（Deadline）渲染模式：直播播出每 16.6 ms 必须交出一帧，重帧（多层叠加、4K 上的双线性过滤）不能简单地迟到。
+ *
+ * beginFrame()
+ *     ↓
+ * 记录本帧的绘制列表（drawTexturedTriangle / drawTexturedQuad / drawSolidTriangle）
+ *     ↓
+ * endFrame(fb)
+ *     ├── 估算本帧工作量（输出像素数 + 各三角形覆盖的像素数），乘以各质量档位此前实测的速率，预测每一档的耗时
+ *     ├── 在渲染开始之前选出预测耗时不超过 deadline × headroom 的最高质量档位
+ *     └── 渲染并计时，记录是否超时，更新该档位的速率
+ *
+ * 质量档位（依次降级）：
+ *   FULL          原样渲染
+ *   NEAREST       纹理按最近点采样（BILINEAR → NEAREST，纹理本身不变）
+ *   SCALE_75      以 75% 分辨率渲染后双线性放大到输出（纹理过滤方式不变）
+ *   SCALE_50      50% 分辨率
+ *   SCALE_50_HALF 50% 分辨率，且每帧只重绘一半的条带（奇偶交替），其余条带沿用上一帧
+ * 缩放档位不改过滤方式：整图四边形的三趟剪切快速路径只在双线性过滤时可用，改为最近点采样反而更慢。
+ * 同理，实测速率不低于某个更高质量档位的档位（例如整图四边形为主时的 NEAREST）降级没有收益，选档时跳过。
+ * 还没有实测过的档位按名义相对开销从最近实测的档位推算。
+ * 降档立即生效；升档每帧最多一步（到上一个有收益的档位），并要求其预测耗时不超过 deadline × upgrade_margin，
+ * 避免在两档之间来回跳。
+ */
+namespace SoftRenderer {
+
+    enum class RealtimeQuality { FULL, NEAREST, SCALE_75, SCALE_50, SCALE_50_HALF };
+    constexpr int kRealtimeQualityCount = 5;
+
+    const char *realtimeQualityName(RealtimeQuality quality);
+
+    struct RealtimeSettings {
+        double deadline_ms = 1000.0 / 60.0;   // 每帧的时限
+        double headroom = 0.9;                // 选择档位时只使用时限的这一部分，留给预测误差
+        double upgrade_margin = 0.7;          // 升档要求的预测耗时比例
+        RealtimeQuality worst = RealtimeQuality::SCALE_50_HALF; // 允许降到的最低档位
+        size_t history = 600;                 // 参与百分位统计的最近帧数
+    };
+
+    // 一帧的调度与计时结果
+    struct RealtimeFrame {
+        uint64_t index = 0;
+        RealtimeQuality quality = RealtimeQuality::FULL;
+        double workload_pixels = 0.0;
+        double predicted_ms = 0.0;
+        double render_ms = 0.0;
+        bool missed = false; // render_ms 超过 deadline_ms
+    };
+
+    // 最近 history 帧的统计
+    struct RealtimeStats {
+        uint64_t frames = 0;        // 自创建（或 resetStats）以来的总帧数
+        uint64_t missed = 0;        // 其中超时的帧数
+        double p50_ms = 0.0;        // 以下为最近 history 帧的耗时分布
+        double p99_ms = 0.0;
+        double max_ms = 0.0;
+        std::array<uint64_t, kRealtimeQualityCount> frames_per_quality{}; // 各档位使用的帧数（总计）
+    };
+
+    class RealtimeRenderer {
+    public:
+        explicit RealtimeRenderer(const RealtimeSettings &settings = RealtimeSettings());
+
+        // 开始记录新的一帧（清空上一帧的绘制列表）
+        void beginFrame();
+
+        /**
+         * 纹理需存活到 endFrame 结束。NEAREST 档位通过 Rasterizer 的过滤方式覆盖改为最近点采样，
+         * 纹理本身不被修改，可以同时被其他线程只读共享。
+         */
+        void drawTexturedTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const YUVTexture &texture);
+        void drawTexturedQuad(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Vertex &v3,
+                              const YUVTexture &texture);
+        void drawSolidTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Color &color);
+
+        // 按预测选档并渲染本帧到 fb（整帧重绘）；SCALE_50_HALF 沿用的条带来自上一帧的低分辨率缓冲
+        const RealtimeFrame &endFrame(FrameBuffer &fb, const Color &clear_color = Color(0, 0, 0));
+
+        // 固定档位（跳过预测），用于测量或手动控制；clearForcedQuality 恢复自动选档
+        void forceQuality(RealtimeQuality quality) { forced_ = true; forced_quality_ = quality; }
+        void clearForcedQuality() { forced_ = false; }
+
+        const RealtimeFrame &getLastFrame() const { return last_frame_; }
+        RealtimeStats getStats() const;
+
+        // 最近 history 帧耗时的 p 分位数（p ∈ [0, 100]，最近秩法），没有记录时返回 0
+        double getFrameTimePercentile(double p) const;
+
+        // 当前各档位的速率（毫秒 / 百万像素工作量）估计
+        double getEstimatedRate(RealtimeQuality quality) const;
+
+        void resetStats();
+
+        const RealtimeSettings &getSettings() const { return settings_; }
+
+        /**
+         * 把 src 双线性缩放到 dst 的尺寸（像素中心对齐，定点权重），逐行通过 writeSpan 写出。
+         * 用于把降分辨率渲染的结果放大到输出。列坐标表和行缓冲在调用间复用，只在尺寸变化时重建。
+         */
+        void upscale(const FrameBuffer &src, FrameBuffer &dst);
+
+    private:
+        struct Item {
+            Vertex v[4];
+            int vertex_count = 3;               // 3：三角形，4：四边形
+            const YUVTexture *texture = nullptr; // nullptr 表示纯色
+            Color color;
+        };
+
+        // 选出本帧的档位
+        RealtimeQuality chooseQuality(double workload_pixels, double &predicted_ms) const;
+        double predict(int level, double workload_pixels) const;
+
+        // 在 target 上绘制所有项，坐标乘以 scale；band_parity >= 0 时只绘制该奇偶性的条带
+        void drawItems(FrameBuffer &target, float scale, int band_parity);
+
+        void record(const RealtimeFrame &frame);
+
+        RealtimeSettings settings_;
+        std::vector<Item> items_;
+        Rasterizer rasterizer_;
+
+        // 各档位的速率（毫秒 / 百万像素）及是否实测过；last_measured_ 为最近一次实测的档位
+        std::array<double, kRealtimeQualityCount> rate_{};
+        std::array<bool, kRealtimeQualityCount> measured_{};
+        int last_measured_ = -1;
+        int current_level_ = 0;
+        bool forced_ = false;
+        RealtimeQuality forced_quality_ = RealtimeQuality::FULL;
+
+        // 降分辨率渲染的缓冲，low_res_valid_ 表示其内容是上一帧完整（或交替补齐）的结果
+        std::unique_ptr<FrameBuffer> low_res_;
+        bool low_res_valid_ = false;
+        std::vector<Color> row_buffer_; // upscale 的输出行
+        // upscale 的列坐标表（源列 x0 / x1 与 Q8 权重 fx），对应 upscale_src_width_ → 行缓冲宽度
+        std::vector<int> upscale_x0_, upscale_x1_, upscale_fx_;
+        int upscale_src_width_ = 0;
+
+        uint64_t frame_index_ = 0;
+        RealtimeFrame last_frame_;
+        std::vector<double> history_ms_; // 环形缓冲
+        size_t history_next_ = 0;
+        RealtimeStats totals_;
+    };
+
+} // namespace SoftRenderer
+
+#endif /* RealtimeRenderer_hpp */
@@ -0,0 +1,315 @@
+//
+//  ShearRotator.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include "texture/ColorSpace.hpp"
+#include "ShearRotator.hpp"
+
+namespace SoftRenderer {
+
+    namespace {
+
+        // 与 YUVTexture 定点双线性相同的 smoothstep 权重表：分数 [0, 255] → 权重 [0, 256]
+        const uint16_t *smoothstepWeights() {
+            static const auto table = [] {
+                std::array<uint16_t, 256> t{};
+                for (int i = 0; i < 256; ++i) {
+                    float s = static_cast<float>(i) / 256.0f;
+                    t[i] = static_cast<uint16_t>(std::lround(s * s * (3.0f - 2.0f * s) * 256.0f));
+                }
+                return t;
+            }();
+            return table.data();
+        }
+
+        inline unsigned char lerpFixed(int a, int b, int w) {
+            return static_cast<unsigned char>((a * (256 - w) + b * w + 128) >> 8);
+        }
+
+        /**
+         * 一维重采样：dst[i] = src 在纹素中心坐标 base + i × step 处的插值，索引钳制到 [0, n - 1]。
+         * 步长为 1 时（纯剪切）一行内的小数部分相同，内层循环是固定权重的相邻两点插值。
+         */
+        void resampleRow(const unsigned char *src, int n, double base, double step,
+                         unsigned char *dst, int count) {
+            const uint16_t *weights = smoothstepWeights();
+            if (std::abs(step - 1.0) < 1e-6) {
+                const double floor_base = std::floor(base);
+                const long long k = static_cast<long long>(floor_base);
+                const int w = weights[std::min(255, static_cast<int>((base - floor_base) * 256.0))];
+                // 两个相邻纹素都在 [0, n - 1] 内的输出区间 [begin, end)
+                const int begin = static_cast<int>(std::clamp<long long>(-k, 0, count));
+                const int end = static_cast<int>(std::clamp<long long>(n - 1 - k, begin, count));
+                auto clamped = [&](int i) {
+                    const long long i0 = std::clamp<long long>(k + i, 0, n - 1);
+                    const long long i1 = std::clamp<long long>(k + i + 1, 0, n - 1);
+                    return lerpFixed(src[i0], src[i1], w);
+                };
+                for (int i = 0; i < begin; ++i) {
+                    dst[i] = clamped(i);
+                }
+                const unsigned char *s = src + k;
+                for (int i = begin; i < end; ++i) {
+                    dst[i] = lerpFixed(s[i], s[i + 1], w);
+                }
+                for (int i = end; i < count; ++i) {
+                    dst[i] = clamped(i);
+                }
+                return;
+            }
+
+            // 一般步长（缩放）：32.32 定点坐标，逐点钳制
+            const int64_t fixed_base = std::llround(base * 4294967296.0);
+            const int64_t fixed_step = std::llround(step * 4294967296.0);
+            for (int i = 0; i < count; ++i) {
+                const int64_t pos = fixed_base + fixed_step * i;
+                const int64_t k = pos >> 32;
+                const int w = weights[(pos >> 24) & 255];
+                const int64_t i0 = std::clamp<int64_t>(k, 0, n - 1);
+                const int64_t i1 = std::clamp<int64_t>(k + 1, 0, n - 1);
+                dst[i] = lerpFixed(src[i0], src[i1], w);
+            }
+        }
+
+        // 分块转置：src 为 rows × cols，dst 为 cols × rows
+        void transpose(const unsigned char *src, int rows, int cols, unsigned char *dst) {
+            constexpr int kBlock = 32;
+            for (int r0 = 0; r0 < rows; r0 += kBlock) {
+                const int r1 = std::min(rows, r0 + kBlock);
+                for (int c0 = 0; c0 < cols; c0 += kBlock) {
+                    const int c1 = std::min(cols, c0 + kBlock);
+                    for (int r = r0; r < r1; ++r) {
+                        const unsigned char *in = src + static_cast<size_t>(r) * cols;
+                        for (int c = c0; c < c1; ++c) {
+                            dst[static_cast<size_t>(c) * rows + r] = in[c];
+                        }
+                    }
+                }
+            }
+        }
+
+    } // namespace
+
+    size_t ShearRotator::getScratchBytes() const {
+        return spans_.capacity() * sizeof(Span) + pass_a_.capacity() + pass_b_.capacity() + row_.capacity() +
+               y_out_.capacity() + u_out_.capacity() + v_out_.capacity();
+    }
+
+    bool ShearRotator::draw(FrameBuffer &fb, const YUVTexture &texture,
+                            const Vertex &v0, const Vertex &v1, const Vertex &v3, const Rect &clip,
+                            const ColorLUT *lut) {
+        // 1. 四边形参数 (α, β)：屏幕坐标 = v0 + α · e1 + β · e2，UV 同理
+        const double e1x = v1.x - v0.x, e1y = v1.y - v0.y, e1u = v1.u - v0.u, e1v = v1.v - v0.v;
+        const double e2x = v3.x - v0.x, e2y = v3.y - v0.y, e2u = v3.u - v0.u, e2v = v3.v - v0.v;
+        const double det_xy = e1x * e2y - e1y * e2x;
+        const double det_uv = e1u * e2v - e1v * e2u;
+        if (std::abs(det_xy) < 1e-6 || std::abs(det_uv) < 1e-12) {
+            return false;
+        }
+        if (clip.empty()) {
+            return true;
+        }
+
+        // 2. 每行的覆盖区间：像素中心的 (α, β) 落在 [0, 1]² 内（容差与三角形路径的重心坐标容差相同）
+        const double ia00 = e2y / det_xy, ia01 = -e2x / det_xy;
+        const double ia10 = -e1y / det_xy, ia11 = e1x / det_xy;
+        constexpr double kEpsilon = 1e-5;
+        spans_.assign(clip.height, Span{0, 0});
+        int first_row = -1, last_row = -1;
+        for (int k = 0; k < clip.height; ++k) {
+            const double py = clip.y + k + 0.5 - v0.y;
+            double lo = clip.x, hi = clip.right() - 1;
+            // α(x) = a0 + ga · x，β(x) = b0 + gb · x，其中 x 为像素索引
+            auto restrict_range = [&](double origin, double gradient) {
+                if (std::abs(gradient) < 1e-12) {
+                    if (origin < -kEpsilon || origin > 1.0 + kEpsilon) {
+                        hi = lo - 1;
+                    }
+                    return;
+                }
+                double x_a = (-kEpsilon - origin) / gradient;
+                double x_b = (1.0 + kEpsilon - origin) / gradient;
+                lo = std::max(lo, std::min(x_a, x_b));
+                hi = std::min(hi, std::max(x_a, x_b));
+            };
+            restrict_range(ia00 * (0.5 - v0.x) + ia01 * py, ia00);
+            restrict_range(ia10 * (0.5 - v0.x) + ia11 * py, ia10);
+            const int x0 = static_cast<int>(std::ceil(lo));
+            const int x1 = static_cast<int>(std::floor(hi)) + 1;
+            if (x0 < x1) {
+                spans_[k] = Span{x0, x1};
+                if (first_row < 0) {
+                    first_row = k;
+                }
+                last_row = k;
+            }
+        }
+        if (first_row < 0) {
+            return true;
+        }
+        spans_.erase(spans_.begin() + last_row + 1, spans_.end());
+        spans_.erase(spans_.begin(), spans_.begin() + first_row);
+        const Rect rows(clip.x, clip.y + first_row, clip.width, last_row - first_row + 1);
+
+        // 3. UV → 屏幕的雅可比矩阵 J：屏幕坐标 = v0 + J · (uv - uv0)
+        const double j00 = (e1x * e2v - e2x * e1v) / det_uv, j01 = (e2x * e1u - e1x * e2u) / det_uv;
+        const double j10 = (e1y * e2v - e2y * e1v) / det_uv, j11 = (e2y * e1u - e1y * e2u) / det_uv;
+        auto plane_map = [&](int plane_width, int plane_height) {
+            // 纹素坐标 = uv × 平面尺寸
+            Affine map;
+            map.m00 = j00 / plane_width;
+            map.m01 = j01 / plane_height;
+            map.m10 = j10 / plane_width;
+            map.m11 = j11 / plane_height;
+            map.tx = v0.x - (j00 * v0.u + j01 * v0.v);
+            map.ty = v0.y - (j10 * v0.u + j11 * v0.v);
+            return map;
+        };
+
+        // 4. 三个平面分别重采样到屏幕分辨率
+        const int w = texture.getWidth();
+        const int h = texture.getHeight();
+        warpPlane(texture.getYData(), texture.getYStride(), w, h, plane_map(w, h), rows, y_out_);
+        warpPlane(texture.getUData(), texture.getUStride(), w / 2, h / 2, plane_map(w / 2, h / 2), rows, u_out_);
+        warpPlane(texture.getVData(), texture.getVStride(), w / 2, h / 2, plane_map(w / 2, h / 2), rows, v_out_);
+
+        // 5. 颜色转换（及查表）并写入帧缓冲，一行转换完马上查表，数据仍在 L1 中。
+        //    流式写入时先转换到行缓冲（查表要读回结果，不能在未缓存的目标行上进行），再整段写入
+        const ColorSpaceStandard standard = texture.getColorSpace();
+        const bool streaming = fb.usesStreamingStores();
+        if (streaming) {
+            row_rgb_.resize(static_cast<size_t>(rows.width));
+        }
+        for (int k = 0; k < rows.height; ++k) {
+            const Span span = spans_[k];
+            if (span.x0 >= span.x1) {
+                continue;
+            }
+            // out 指向本行 span.x0 处的像素
+            Color *out = streaming ? row_rgb_.data() + (span.x0 - rows.x) : fb.getRow(rows.y + k) + span.x0;
+            const size_t offset = static_cast<size_t>(k) * rows.width + (span.x0 - rows.x);
+            const int count = span.x1 - span.x0;
+            for (int i = 0; i < count; ++i) {
+                out[i] = yuvToRGB(y_out_[offset + i], u_out_[offset + i], v_out_[offset + i], standard);
+            }
+            if (lut) {
+                lut->applyRow(out, count);
+            }
+            if (streaming) {
+                fb.writeSpan(rows.y + k, span.x0, out, count);
+            }
+        }
+        return true;
+    }
+
+    void ShearRotator::warpPlane(const unsigned char *plane, size_t stride, int width, int height,
+                                 const Affine &map, const Rect &clip, std::vector<unsigned char> &out) {
+        double a = map.m00, b = map.m01, c = map.m10, d = map.m11;
+        double tx = map.tx, ty = map.ty;
+
+        // 旋转角超过 ±90°（a < 0）时源图先旋转 180°：T = (w, h) - T'，M' = -M，t' = t + M · (w, h)
+        const bool flip = a < 0.0;
+        if (flip) {
+            tx += a * width + b * height;
+            ty += c * width + d * height;
+            a = -a;
+            b = -b;
+            c = -c;
+            d = -d;
+        }
+
+        // M = X2 · Y · X1：取 s = det / |第一列|，纯旋转时 s = p2 = 1、q1 = q2 = -tan(θ/2)
+        const double sx = std::hypot(a, c);
+        const double s = (a * d - b * c) / sx;
+        const double q1 = (d * c / (sx + a) + b) / sx;
+        const double r = c;
+        const double q2 = (b - a * q1) / s;
+        const double p2 = a - q2 * c;
+
+        // 屏幕像素中心 (x + 0.5, y + 0.5) 反推：by = y + 0.5 - ty，bx = (x + 0.5 - tx - q2 · by) / p2
+        const int ny = clip.height;
+        auto row_by = [&](int k) { return clip.y + k + 0.5 - ty; };
+
+        // 中间图像的列网格：第 i 列中心位于 bx = col0 + i + 0.5，只覆盖本次输出需要的范围
+        double bx_min = std::numeric_limits<double>::max();
+        double bx_max = std::numeric_limits<double>::lowest();
+        for (int k = 0; k < ny; ++k) {
+            const Span span = spans_[k];
+            if (span.x0 >= span.x1) {
+                continue;
+            }
+            for (int x : {span.x0, span.x1 - 1}) {
+                const double bx = (x + 0.5 - tx - q2 * row_by(k)) / p2;
+                bx_min = std::min(bx_min, bx);
+                bx_max = std::max(bx_max, bx);
+            }
+        }
+        // 与源图经过 X1 后的范围取交集（超出部分都是边缘钳制的结果，覆盖像素不会用到）
+        const double a_lo = std::min(0.0, q1 * height), a_hi = width + std::max(0.0, q1 * height);
+        bx_min = std::max(bx_min, a_lo - 1.0);
+        bx_max = std::max(bx_min, std::min(bx_max, a_hi + 1.0));
+        const int col0 = static_cast<int>(std::floor(bx_min)) - 2;
+        const int ncol = static_cast<int>(std::ceil(bx_max)) + 2 - col0;
+
+        // 需要的源图行：ay = (by - r · ax) / s 在列网格两端、输出首末行处取极值
+        double ay_min = std::numeric_limits<double>::max();
+        double ay_max = std::numeric_limits<double>::lowest();
+        for (double ax : {col0 + 0.5, col0 + ncol - 0.5}) {
+            for (double by : {row_by(0), row_by(ny - 1)}) {
+                const double ay = (by - r * ax) / s;
+                ay_min = std::min(ay_min, ay);
+                ay_max = std::max(ay_max, ay);
+            }
+        }
+        const int j0 = std::clamp(static_cast<int>(std::floor(ay_min - 0.5)) - 1, 0, height - 1);
+        const int j1 = std::clamp(static_cast<int>(std::ceil(ay_max - 0.5)) + 1, 0, height - 1);
+        const int nrow = j1 - j0 + 1;
+
+        // 第一趟 X1：逐行平移 -q1 · ty（步长 1）
+        pass_a_.resize(static_cast<size_t>(nrow) * ncol);
+        row_.resize(width);
+        for (int j = j0; j <= j1; ++j) {
+            const unsigned char *src = plane + static_cast<size_t>(j) * stride;
+            if (flip) {
+                const unsigned char *mirrored = plane + static_cast<size_t>(height - 1 - j) * stride;
+                std::reverse_copy(mirrored, mirrored + width, row_.begin());
+                src = row_.data();
+            }
+            resampleRow(src, width, col0 - q1 * (j + 0.5), 1.0,
+                        &pass_a_[static_cast<size_t>(j - j0) * ncol], ncol);
+        }
+
+        // 第二趟 Y：转置后按行处理，每列平移 r · ax 并缩放 s
+        pass_b_.resize(pass_a_.size());
+        transpose(pass_a_.data(), nrow, ncol, pass_b_.data());
+        pass_a_.resize(static_cast<size_t>(ncol) * ny);
+        for (int i = 0; i < ncol; ++i) {
+            const double ax = col0 + i + 0.5;
+            resampleRow(&pass_b_[static_cast<size_t>(i) * nrow], nrow, (row_by(0) - r * ax) / s - 0.5 - j0, 1.0 / s,
+                        &pass_a_[static_cast<size_t>(i) * ny], ny);
+        }
+        pass_b_.resize(pass_a_.size());
+        transpose(pass_a_.data(), ncol, ny, pass_b_.data());
+
+        // 第三趟 X2：每个屏幕行只输出覆盖区间
+        out.resize(static_cast<size_t>(clip.width) * ny);
+        for (int k = 0; k < ny; ++k) {
+            const Span span = spans_[k];
+            if (span.x0 >= span.x1) {
+                continue;
+            }
+            const double base = (span.x0 + 0.5 - tx - q2 * row_by(k)) / p2 - 0.5 - col0;
+            resampleRow(&pass_b_[static_cast<size_t>(k) * ncol], ncol, base, 1.0 / p2,
+                        &out[static_cast<size_t>(k) * clip.width + (span.x0 - clip.x)], span.x1 - span.x0);
+        }
+    }
+
+} // namespace SoftRenderer
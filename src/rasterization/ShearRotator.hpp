@@ -0,0 +1,76 @@
+//
+//  ShearRotator.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef ShearRotator_hpp
+#define ShearRotator_hpp
+
+#include <vector>
+#include "core/Rect.hpp"
+#include "core/FrameBuffer.hpp"
+#include "geometry/Vertex.hpp"
+#include "texture/YUVTexture.hpp"
+#include "texture/ColorLUT.hpp"
+
+/**
+ * 三趟剪切（Paeth）仿射绘制：整张图像做“缩放 + 旋转 + 平移”时，逐像素双线性采样在源图上沿对角线读取，
+ * 大图旋转时几乎每个像素都落在不同的缓存行上。这里把仿射矩阵分解为三个一维重采样：
+ *
+ *   M = X2 · Y · X1
+ *   X1 = [1 q1; 0 1]   水平剪切：每行整体平移（小数偏移在一行内相同）
+ *   Y  = [1 0; r  s]   垂直剪切 + 缩放：按列进行，先分块转置，变成按行处理
+ *   X2 = [p2 q2; 0 1]  水平剪切 + 缩放，直接输出到屏幕行
+ *
+ * 每一趟都沿行线性读写；纯旋转时三趟的步长都是 1，内核退化为“固定权重的相邻两点插值”，可被编译器向量化。
+ * 旋转角超过 ±90° 时先把源图旋转 180°（行内倒序读取，无损），保证剪切系数 |tan(θ/2)| ≤ 1。
+ *
+ * 过滤与 YUVTexture 的双线性一致（纹素中心对齐、smoothstep 权重、钳制到边缘），但由三次一维插值组合而成，
+ * 与逐像素二维双线性相比每个分量通常相差 1~2 级；Y/U/V 三个平面各自按自己的分辨率变换，
+ * 色度直接重采样到屏幕分辨率，最后逐像素转换为 RGB。
+ */
+namespace SoftRenderer {
+
+    class ShearRotator {
+    public:
+        /**
+         * 把平行四边形 v0 → v1 → (v1 + v3 - v0) → v3 绘制到 fb，v1、v3 是 v0 的两个相邻顶点。
+         * UV 在四边形上仿射插值（与拆成两个三角形绘制时相同），必须落在 [0, 1] 内。
+         * 只写入 clip（已与帧缓冲、裁剪矩形取交集）内、像素中心被四边形覆盖的像素。
+         * lut 非空时每个像素转换为 RGB 后再查表。
+         * @return 四边形退化（面积或 UV 面积为 0）时不绘制并返回 false
+         */
+        bool draw(FrameBuffer &fb, const YUVTexture &texture,
+                  const Vertex &v0, const Vertex &v1, const Vertex &v3, const Rect &clip,
+                  const ColorLUT *lut = nullptr);
+
+        // 临时缓冲当前占用的字节数（在多次绘制间复用）
+        size_t getScratchBytes() const;
+
+    private:
+        // 屏幕坐标 = M · 纹素坐标 + t
+        struct Affine {
+            double m00, m01, m10, m11;
+            double tx, ty;
+        };
+
+        // 屏幕行 clip.y + k 上被覆盖的列 [x0, x1)
+        struct Span {
+            int x0, x1;
+        };
+
+        // 对一个平面执行三趟重采样，输出覆盖像素的值到 out（clip.width × 行数，行主序）
+        void warpPlane(const unsigned char *plane, size_t stride, int width, int height,
+                       const Affine &map, const Rect &clip, std::vector<unsigned char> &out);
+
+        std::vector<Span> spans_;
+        std::vector<unsigned char> pass_a_, pass_b_, row_;
+        std::vector<unsigned char> y_out_, u_out_, v_out_;
+        std::vector<Color> row_rgb_; // 流式写入时的一行 RGB 结果
+    };
+
+} // namespace SoftRenderer
+
+#endif /* ShearRotator_hpp */
@@ -0,0 +1,58 @@
+//
+//  SpriteBatch.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include "SpriteBatch.hpp"
+
+namespace SoftRenderer {
+
+    void SpriteBatch::clear() {
+        for (std::vector<float> *column : {&x_, &y_, &width_, &height_, &u0_, &v0_, &u1_, &v1_}) {
+            column->clear();
+        }
+    }
+
+    void SpriteBatch::reserve(size_t count) {
+        for (std::vector<float> *column : {&x_, &y_, &width_, &height_, &u0_, &v0_, &u1_, &v1_}) {
+            column->reserve(count);
+        }
+    }
+
+    void SpriteBatch::add(float x, float y, float width, float height, float u0, float v0, float u1, float v1) {
+        x_.push_back(x);
+        y_.push_back(y);
+        width_.push_back(width);
+        height_.push_back(height);
+        u0_.push_back(u0);
+        v0_.push_back(v0);
+        u1_.push_back(u1);
+        v1_.push_back(v1);
+    }
+
+    void SpriteBatch::add(float x, float y, const AtlasRegion &region, float scale) {
+        add(x, y, region.width * scale, region.height * scale, region.u0, region.v0, region.u1, region.v1);
+    }
+
+    void SpriteBatch::add(size_t count, const float *x, const float *y, const float *width, const float *height,
+                          const float *u0, const float *v0, const float *u1, const float *v1) {
+        x_.insert(x_.end(), x, x + count);
+        y_.insert(y_.end(), y, y + count);
+        width_.insert(width_.end(), width, width + count);
+        height_.insert(height_.end(), height, height + count);
+        u0_.insert(u0_.end(), u0, u0 + count);
+        v0_.insert(v0_.end(), v0, v0 + count);
+        u1_.insert(u1_.end(), u1, u1 + count);
+        v1_.insert(v1_.end(), v1, v1 + count);
+    }
+
+    void SpriteBatch::add(size_t count, const float *x, const float *y, const int *region_ids, const TextureAtlas &atlas) {
+        reserve(size() + count);
+        for (size_t i = 0; i < count; ++i) {
+            add(x[i], y[i], atlas.getRegion(region_ids[i]));
+        }
+    }
+
+} // namespace SoftRenderer
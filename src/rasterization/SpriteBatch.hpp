@@ -0,0 +1,66 @@
+//
+//  SpriteBatch.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef SpriteBatch_hpp
+#define SpriteBatch_hpp
+
+#include <vector>
+#include <cstddef>
+#include "texture/TextureAtlas.hpp"
+
+/**
+ * 精灵批次：成千上万个轴对齐的小四边形（图标、字形），以结构数组（SoA）形式保存，
+ * 由 Rasterizer::drawSprites 一次性建立、用专用的小四边形内核绘制。
+ *
+ * 与逐个 drawTexturedQuad（两个三角形）相比：
+ *  - 建立阶段对整批精灵逐数组计算像素范围和纹理坐标步长，没有边函数，每个精灵的开销是一个小常数；
+ *  - 绘制只遍历精灵实际覆盖的像素，不扫描包围盒、不做覆盖测试；
+ *  - 所有精灵采样同一张纹理（通常是 TextureAtlas），纹理只绑定一次。
+ *
+ * 精灵覆盖像素中心落在 [x, x + width) × [y, y + height) 内的像素（左上包含、右下不包含），
+ * 相邻精灵恰好拼接而不重叠；三角形路径对恰好落在边上的像素中心两侧都包含，因此边缘上的像素可能不同。
+ */
+namespace SoftRenderer {
+
+    class SpriteBatch {
+    public:
+        void clear();
+        void reserve(size_t count);
+
+        // 单个精灵：屏幕矩形 (x, y, width, height) 映射纹理坐标矩形 [u0, u1] × [v0, v1]
+        void add(float x, float y, float width, float height, float u0, float v0, float u1, float v1);
+
+        // 图集中的小图，以 scale 倍的原尺寸放在 (x, y)
+        void add(float x, float y, const AtlasRegion &region, float scale = 1.0f);
+
+        // 批量提交（SoA）：每个数组 count 个元素
+        void add(size_t count, const float *x, const float *y, const float *width, const float *height,
+                 const float *u0, const float *v0, const float *u1, const float *v1);
+
+        // 批量提交图集小图（原尺寸）：region_ids 为 TextureAtlas::add 返回的编号
+        void add(size_t count, const float *x, const float *y, const int *region_ids, const TextureAtlas &atlas);
+
+        size_t size() const { return x_.size(); }
+        bool empty() const { return x_.empty(); }
+
+        const float *getX() const { return x_.data(); }
+        const float *getY() const { return y_.data(); }
+        const float *getWidth() const { return width_.data(); }
+        const float *getHeight() const { return height_.data(); }
+        const float *getU0() const { return u0_.data(); }
+        const float *getV0() const { return v0_.data(); }
+        const float *getU1() const { return u1_.data(); }
+        const float *getV1() const { return v1_.data(); }
+
+    private:
+        std::vector<float> x_, y_, width_, height_;
+        std::vector<float> u0_, v0_, u1_, v1_;
+    };
+
+} // namespace SoftRenderer
+
+#endif /* SpriteBatch_hpp */
@@ -0,0 +1,72 @@
+//
+//  TriangleSetup.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef TriangleSetup_hpp
+#define TriangleSetup_hpp
+
+#include <cmath>
+#include <algorithm>
+#include "core/Rect.hpp"
+#include "geometry/Vertex.hpp"
+
+namespace SoftRenderer {
+
+    /**
+     * 三角形建立（Triangle Setup）：把 Rasterizer::drawTexturedTriangle 中与像素无关的预计算提取出来，
+     * 供需要“先覆盖、后着色”的渲染路径复用，保证覆盖判定与重心坐标与即时模式逐位一致。
+     * 推导见 Rasterizer.cpp 中的注释：
+     *   area_w0 = A0 * py - B0 * px + C0
+     *   area_w1 = A1 * py - B1 * px + C1
+     *   w2 = 1 - w0 - w1
+     */
+    struct TriangleSetup {
+        float inv_area_2X = 0.0f;
+        float A0 = 0.0f, B0 = 0.0f, C0 = 0.0f;
+        float A1 = 0.0f, B1 = 0.0f, C1 = 0.0f;
+        Rect bounds; // 未钳制的像素包围盒
+        bool valid = false; // 退化三角形（面积为 0）为 false
+
+        TriangleSetup(const Vertex &v0, const Vertex &v1, const Vertex &v2) {
+            const float total_area_2X = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+            if (std::abs(total_area_2X) < 1e-6) {
+                return;
+            }
+            valid = true;
+            inv_area_2X = 1.0f / total_area_2X;
+
+            A0 = v2.x - v1.x;
+            B0 = v2.y - v1.y;
+            C0 = -(A0 * v1.y - B0 * v1.x);
+
+            A1 = v0.x - v2.x;
+            B1 = v0.y - v2.y;
+            C1 = -(A1 * v2.y - B1 * v2.x);
+
+            int min_x = static_cast<int>(std::floor(std::min({v0.x, v1.x, v2.x})));
+            int max_x = static_cast<int>(std::ceil(std::max({v0.x, v1.x, v2.x})));
+            int min_y = static_cast<int>(std::floor(std::min({v0.y, v1.y, v2.y})));
+            int max_y = static_cast<int>(std::ceil(std::max({v0.y, v1.y, v2.y})));
+            bounds = Rect(min_x, min_y, max_x - min_x + 1, max_y - min_y + 1);
+        }
+
+        // 任意几何点 (px, py) 的重心坐标，点在三角形外时为负值（可用于外推属性）
+        void barycentric(float px, float py, float &w0, float &w1, float &w2) const {
+            w0 = (A0 * py - B0 * px + C0) * inv_area_2X;
+            w1 = (A1 * py - B1 * px + C1) * inv_area_2X;
+            w2 = 1.0f - w0 - w1;
+        }
+
+        // 计算像素 (x, y) 中心的重心坐标，返回是否在三角形内（与 Rasterizer 相同的容差）
+        bool coverage(int x, int y, float &w0, float &w1, float &w2) const {
+            barycentric(static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f, w0, w1, w2);
+            return w0 >= -1e-5f && w1 >= -1e-5f && w2 >= -1e-5f;
+        }
+    };
+
+} // namespace SoftRenderer
+
+#endif /* TriangleSetup_hpp */
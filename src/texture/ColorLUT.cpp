@@ -0,0 +1,141 @@
+//
+//  ColorLUT.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <cmath>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include "ColorLUT.hpp"
+
+namespace SoftRenderer {
+
+    namespace {
+        constexpr int kMinSize = 2;
+        constexpr int kMaxSize = 256;
+        constexpr float kDomainMin[3] = {0.0f, 0.0f, 0.0f};
+        constexpr float kDomainMax[3] = {1.0f, 1.0f, 1.0f};
+
+        // 恒等映射的格点数据（R 变化最快）
+        std::vector<float> identityTable(int size) {
+            if (size < kMinSize || size > kMaxSize) {
+                throw std::invalid_argument("ColorLUT: 格点数必须在 2 ~ 256 之间");
+            }
+            std::vector<float> rgb(static_cast<size_t>(size) * size * size * 3);
+            const float scale = 1.0f / static_cast<float>(size - 1);
+            size_t i = 0;
+            for (int b = 0; b < size; ++b) {
+                for (int g = 0; g < size; ++g) {
+                    for (int r = 0; r < size; ++r) {
+                        rgb[i++] = r * scale;
+                        rgb[i++] = g * scale;
+                        rgb[i++] = b * scale;
+                    }
+                }
+            }
+            return rgb;
+        }
+    }
+
+    ColorLUT::ColorLUT(int size) : ColorLUT(size, identityTable(size), kDomainMin, kDomainMax) {}
+
+    ColorLUT::ColorLUT(int size, const std::vector<float> &rgb, const float domain_min[3], const float domain_max[3])
+        : size_(size) {
+        stride_r_ = 1;
+        stride_g_ = static_cast<size_t>(size);
+        stride_b_ = static_cast<size_t>(size) * size;
+
+        entries_.resize(stride_b_ * size);
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            auto quantize = [](float value) {
+                return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f * 256.0f));
+            };
+            entries_[i] = {quantize(rgb[3 * i]), quantize(rgb[3 * i + 1]), quantize(rgb[3 * i + 2]), 0};
+        }
+        buildInputTables(domain_min, domain_max);
+    }
+
+    void ColorLUT::buildInputTables(const float domain_min[3], const float domain_max[3]) {
+        const size_t strides[3] = {stride_r_, stride_g_, stride_b_};
+        for (int channel = 0; channel < 3; ++channel) {
+            const float range = domain_max[channel] - domain_min[channel];
+            for (int value = 0; value < 256; ++value) {
+                const float t = std::clamp((value / 255.0f - domain_min[channel]) / range, 0.0f, 1.0f);
+                const float position = t * static_cast<float>(size_ - 1);
+                // 最后一个格点归入前一个区间（小数为 256），保证 +1 步长的读取不越界
+                const int index = std::min(static_cast<int>(position), size_ - 2);
+                offset_[channel][value] = static_cast<uint32_t>(index * strides[channel]);
+                frac_[channel][value] = static_cast<uint16_t>(std::lround((position - index) * 256.0f));
+            }
+        }
+    }
+
+    ColorLUT ColorLUT::loadCube(const std::string &filename) {
+        std::ifstream file(filename);
+        if (!file) {
+            throw std::runtime_error("无法打开 LUT 文件: " + filename);
+        }
+
+        int size = 0;
+        float domain_min[3] = {kDomainMin[0], kDomainMin[1], kDomainMin[2]};
+        float domain_max[3] = {kDomainMax[0], kDomainMax[1], kDomainMax[2]};
+        std::vector<float> rgb;
+        std::string line;
+        while (std::getline(file, line)) {
+            const size_t start = line.find_first_not_of(" \t\r");
+            if (start == std::string::npos || line[start] == '#') {
+                continue;
+            }
+            std::istringstream fields(line.substr(start));
+            if (std::isalpha(static_cast<unsigned char>(line[start]))) {
+                std::string keyword;
+                fields >> keyword;
+                if (keyword == "LUT_3D_SIZE") {
+                    if (!(fields >> size) || size < kMinSize || size > kMaxSize) {
+                        throw std::runtime_error("LUT_3D_SIZE 无效: " + filename);
+                    }
+                    rgb.reserve(static_cast<size_t>(size) * size * size * 3);
+                } else if (keyword == "DOMAIN_MIN" || keyword == "DOMAIN_MAX") {
+                    float *domain = keyword == "DOMAIN_MIN" ? domain_min : domain_max;
+                    if (!(fields >> domain[0] >> domain[1] >> domain[2])) {
+                        throw std::runtime_error(keyword + " 格式错误: " + filename);
+                    }
+                } else if (keyword == "LUT_1D_SIZE") {
+                    throw std::runtime_error("不支持 1D LUT: " + filename);
+                }
+                // TITLE 及其他未知关键字忽略
+                continue;
+            }
+
+            float r, g, b;
+            if (size == 0 || !(fields >> r >> g >> b)) {
+                throw std::runtime_error("LUT 数据行格式错误: " + filename);
+            }
+            rgb.push_back(r);
+            rgb.push_back(g);
+            rgb.push_back(b);
+        }
+
+        if (size == 0 || rgb.size() != static_cast<size_t>(size) * size * size * 3) {
+            throw std::runtime_error("LUT 数据数量与 LUT_3D_SIZE 不符: " + filename);
+        }
+        for (int channel = 0; channel < 3; ++channel) {
+            if (!(domain_max[channel] > domain_min[channel])) {
+                throw std::runtime_error("LUT 输入范围无效: " + filename);
+            }
+        }
+        return ColorLUT(size, rgb, domain_min, domain_max);
+    }
+
+    void ColorLUT::applyRow(Color *row, int count) const {
+        for (int i = 0; i < count; ++i) {
+            row[i] = apply(row[i]);
+        }
+    }
+
+} // namespace SoftRenderer
@@ -0,0 +1,106 @@
+//
+//  ColorLUT.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef ColorLUT_hpp
+#define ColorLUT_hpp
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "core/Color.hpp"
+
+/**
+ * 3D 颜色查找表（调色 / 显示校准），在光栅化器中紧跟 yuvToRGB 执行，不需要对整帧输出再读写一遍。
+ *
+ * 存储布局：N³ 个格点按 .cube 文件的顺序（R 变化最快）连续存放，每个格点 8 字节（RGB 各 16 位定点 + 填充），
+ * 一次插值要读的 4 个格点最多分布在两层相邻的 R 行上。
+ * 输入是 8 位颜色，每个通道到“格点偏移 + 小数”的映射在加载时预先算成 256 项的表，逐像素不做浮点运算。
+ *
+ * 插值采用四面体插值：按三个小数的大小顺序选出包含该点的四面体，只读取 4 个格点（三线性需要 8 个），
+ * 结果在格点上精确，在格点之间是 4 个格点的凸组合。
+ */
+namespace SoftRenderer {
+
+    class ColorLUT {
+    public:
+        // 恒等查找表（每边 size 个格点，2 ≤ size ≤ 256）
+        explicit ColorLUT(int size = 33);
+
+        /**
+         * 加载 Adobe / Resolve 的 .cube 文件（LUT_3D_SIZE、DOMAIN_MIN、DOMAIN_MAX、TITLE、# 注释），
+         * 输出值钳制到 [0, 1]。文件无法打开、格式错误或是 1D LUT 时抛出 std::runtime_error。
+         */
+        static ColorLUT loadCube(const std::string &filename);
+
+        int getSize() const { return size_; }
+
+        // 格点数据占用的字节数
+        size_t getBytes() const { return entries_.size() * sizeof(Entry); }
+
+        // 对单个颜色做四面体插值
+        Color apply(const Color &color) const {
+            const uint32_t fr = frac_[0][color.r], fg = frac_[1][color.g], fb = frac_[2][color.b];
+            const Entry *base = &entries_[offset_[0][color.r] + offset_[1][color.g] + offset_[2][color.b]];
+
+            // 按小数从大到小依次沿对应轴前进一步：c000 → c_a → c_b → c111
+            uint32_t f1, f2, f3;
+            size_t step1, step2;
+            if (fr >= fg) {
+                if (fg >= fb) {
+                    f1 = fr; f2 = fg; f3 = fb; step1 = stride_r_; step2 = stride_g_;
+                } else if (fr >= fb) {
+                    f1 = fr; f2 = fb; f3 = fg; step1 = stride_r_; step2 = stride_b_;
+                } else {
+                    f1 = fb; f2 = fr; f3 = fg; step1 = stride_b_; step2 = stride_r_;
+                }
+            } else {
+                if (fb >= fg) {
+                    f1 = fb; f2 = fg; f3 = fr; step1 = stride_b_; step2 = stride_g_;
+                } else if (fb >= fr) {
+                    f1 = fg; f2 = fb; f3 = fr; step1 = stride_g_; step2 = stride_b_;
+                } else {
+                    f1 = fg; f2 = fr; f3 = fb; step1 = stride_g_; step2 = stride_r_;
+                }
+            }
+            const Entry &c0 = base[0];
+            const Entry &ca = base[step1];
+            const Entry &cb = base[step1 + step2];
+            const Entry &c1 = base[stride_r_ + stride_g_ + stride_b_];
+
+            // 权重 (256 - f1, f1 - f2, f2 - f3, f3)，和为 256；格点值 8 位小数，结果保留 16 位小数后舍入
+            const uint32_t w0 = 256 - f1, wa = f1 - f2, wb = f2 - f3;
+            auto blend = [&](uint16_t Entry::*channel) {
+                const uint32_t sum = w0 * (c0.*channel) + wa * (ca.*channel) + wb * (cb.*channel) + f3 * (c1.*channel);
+                return static_cast<unsigned char>((sum + 32768) >> 16);
+            };
+            return Color(blend(&Entry::r), blend(&Entry::g), blend(&Entry::b));
+        }
+
+        // 对一行像素原地查表
+        void applyRow(Color *row, int count) const;
+
+    private:
+        struct Entry {
+            uint16_t r, g, b, pad; // 0 ~ 255 × 256
+        };
+
+        // rgb：size³ × 3 个 [0, 1] 内的浮点数，R 变化最快；domain：输入范围
+        ColorLUT(int size, const std::vector<float> &rgb, const float domain_min[3], const float domain_max[3]);
+
+        void buildInputTables(const float domain_min[3], const float domain_max[3]);
+
+        int size_ = 0;
+        size_t stride_r_ = 1, stride_g_ = 0, stride_b_ = 0;
+        std::vector<Entry> entries_;
+        // 输入通道值 → 格点偏移（已乘以该轴的步长）与 8 位小数（0 ~ 256）
+        uint32_t offset_[3][256];
+        uint16_t frac_[3][256];
+    };
+
+} // namespace SoftRenderer
+
+#endif /* ColorLUT_hpp */
@@ -71,3 +71,43 @@ Color SoftRenderer::yuvToRGB(unsigned char y, unsigned char u, unsigned char v,
         clampColorComponent(B)
     );
 }
+
+void SoftRenderer::rgbToYUV(const Color &rgb, unsigned char &y, unsigned char &u, unsigned char &v, ColorSpaceStandard standard) {
+    /**
+     * yuvToRGB 的逆变换。由 R = Y + CrtoR × V、B = Y + CbtoB × U 可知：
+     * CrtoR = 2 × (1 - Kr)，CbtoB = 2 × (1 - Kb)，于是
+     * Y = Kr × R + (1 - Kr - Kb) × G + Kb × B
+     * U = (B - Y) / CbtoB + 128
+     * V = (R - Y) / CrtoR + 128
+     */
+    float CrtoR, CbtoB;
+    switch (standard) {
+        case ColorSpaceStandard::BT709:
+            CrtoR = ColorCoefficients::BT709::CrtoR;
+            CbtoB = ColorCoefficients::BT709::CbtoB;
+            break;
+        case ColorSpaceStandard::BT2020:
+            CrtoR = ColorCoefficients::BT2020::CrtoR;
+            CbtoB = ColorCoefficients::BT2020::CbtoB;
+            break;
+        case ColorSpaceStandard::BT601:
+        default:
+            CrtoR = ColorCoefficients::BT601::CrtoR;
+            CbtoB = ColorCoefficients::BT601::CbtoB;
+            break;
+    }
+
+    const float Kr = 1.0f - CrtoR * 0.5f;
+    const float Kb = 1.0f - CbtoB * 0.5f;
+    const float Kg = 1.0f - Kr - Kb;
+
+    const float R = static_cast<float>(rgb.r);
+    const float G = static_cast<float>(rgb.g);
+    const float B = static_cast<float>(rgb.b);
+
+    const float Y = Kr * R + Kg * G + Kb * B;
+    // +0.5 四舍五入，避免往返转换时系统性偏暗
+    y = clampColorComponent(Y + 0.5f);
+    u = clampColorComponent((B - Y) / CbtoB + 128.0f + 0.5f);
+    v = clampColorComponent((R - Y) / CrtoR + 128.0f + 0.5f);
+}
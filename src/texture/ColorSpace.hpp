@@ -51,6 +51,17 @@ namespace SoftRenderer {
      */
     Color yuvToRGB(unsigned char y, unsigned char u, unsigned char v, ColorSpaceStandard standard = ColorSpaceStandard::BT601);
 
+    /**
+     * 将RGB颜色空间转换为YUV颜色空间（yuvToRGB 的逆变换，全范围 8 位）
+     * @param rgb 输入颜色
+     * @param y 输出：亮度分量
+     * @param u 输出：色度分量U
+     * @param v 输出：色度分量V
+     * @param standard 颜色空间标准
+     */
+    void rgbToYUV(const Color &rgb, unsigned char &y, unsigned char &u, unsigned char &v,
+                  ColorSpaceStandard standard = ColorSpaceStandard::BT601);
+
 } // namespace SoftRenderer
 
 #endif /* ColorSpace_hpp */
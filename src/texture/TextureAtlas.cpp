@@ -0,0 +1,131 @@
+//
+//  TextureAtlas.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include "TextureAtlas.hpp"
+
+namespace SoftRenderer {
+
+    namespace {
+        // 先校验尺寸再分配平面（成员初始化列表中使用）
+        size_t validatedArea(int width, int height) {
+            if (width <= 0 || height <= 0 || width % 2 != 0 || height % 2 != 0) {
+                throw std::invalid_argument("TextureAtlas: 图集宽高必须为正偶数");
+            }
+            return static_cast<size_t>(width) * height;
+        }
+
+        YUVPlaneView viewOf(int width, std::vector<unsigned char> &y, std::vector<unsigned char> &u,
+                            std::vector<unsigned char> &v) {
+            YUVPlaneView view;
+            view.y = y.data();
+            view.u = u.data();
+            view.v = v.data();
+            view.y_stride = static_cast<size_t>(width);
+            view.u_stride = static_cast<size_t>(width / 2);
+            view.v_stride = static_cast<size_t>(width / 2);
+            return view;
+        }
+
+        // 把 src 平面（w × h，行跨度 stride）复制到 dst 的 (x, y)，四周 pad 个像素用钳制到边缘的源像素填充
+        void copyPlane(const unsigned char *src, size_t stride, int w, int h,
+                       unsigned char *dst, int dst_width, int x, int y, int pad) {
+            for (int row = -pad; row < h + pad; ++row) {
+                const unsigned char *src_row = src + static_cast<size_t>(std::min(std::max(row, 0), h - 1)) * stride;
+                unsigned char *dst_row = dst + static_cast<size_t>(y + row) * dst_width + x;
+                std::fill(dst_row - pad, dst_row, src_row[0]);
+                std::copy(src_row, src_row + w, dst_row);
+                std::fill(dst_row + w, dst_row + w + pad, src_row[w - 1]);
+            }
+        }
+    }
+
+    TextureAtlas::TextureAtlas(int width, int height, int padding)
+        : width_(width), height_(height), padding_((std::max(padding, 0) + 1) / 2 * 2),
+          y_plane_(validatedArea(width, height), 0),
+          u_plane_(y_plane_.size() / 4, 128),
+          v_plane_(y_plane_.size() / 4, 128),
+          texture_(width, height, viewOf(width, y_plane_, u_plane_, v_plane_)) {
+        if (padding < 0) {
+            throw std::invalid_argument("TextureAtlas: padding 不能为负");
+        }
+    }
+
+    bool TextureAtlas::allocate(int width, int height, int &x, int &y) {
+        // 高度够用的货架中选浪费（货架高度 - 小图高度）最少的
+        Shelf *best = nullptr;
+        for (Shelf &shelf : shelves_) {
+            if (shelf.height >= height && shelf.cursor + width <= width_ &&
+                (!best || shelf.height < best->height)) {
+                best = &shelf;
+            }
+        }
+        if (!best) {
+            if (next_shelf_y_ + height > height_ || width > width_) {
+                return false;
+            }
+            shelves_.push_back(Shelf{next_shelf_y_, height, 0});
+            next_shelf_y_ += height;
+            best = &shelves_.back();
+        }
+        x = best->cursor;
+        y = best->y;
+        best->cursor += width;
+        used_pixels_ += static_cast<long long>(width) * height;
+        return true;
+    }
+
+    void TextureAtlas::copyImage(const YUVTexture &image, int x, int y) {
+        const int w = image.getWidth();
+        const int h = image.getHeight();
+        copyPlane(image.getYData(), image.getYStride(), w, h, y_plane_.data(), width_, x, y, padding_);
+        copyPlane(image.getUData(), image.getUStride(), w / 2, h / 2, u_plane_.data(), width_ / 2, x / 2, y / 2, padding_ / 2);
+        copyPlane(image.getVData(), image.getVStride(), w / 2, h / 2, v_plane_.data(), width_ / 2, x / 2, y / 2, padding_ / 2);
+    }
+
+    int TextureAtlas::add(const YUVTexture &image) {
+        int slot_x = 0, slot_y = 0;
+        if (!allocate(image.getWidth() + 2 * padding_, image.getHeight() + 2 * padding_, slot_x, slot_y)) {
+            throw std::runtime_error("TextureAtlas::add: 图集空间不足");
+        }
+        AtlasRegion region;
+        region.x = slot_x + padding_;
+        region.y = slot_y + padding_;
+        region.width = image.getWidth();
+        region.height = image.getHeight();
+        region.u0 = static_cast<float>(region.x) / width_;
+        region.v0 = static_cast<float>(region.y) / height_;
+        region.u1 = static_cast<float>(region.x + region.width) / width_;
+        region.v1 = static_cast<float>(region.y + region.height) / height_;
+        copyImage(image, region.x, region.y);
+        if (texture_.hasRGBCache()) {
+            texture_.invalidateRGBCache();
+        }
+        regions_.push_back(region);
+        return static_cast<int>(regions_.size()) - 1;
+    }
+
+    std::vector<int> TextureAtlas::add(const std::vector<const YUVTexture *> &images) {
+        std::vector<size_t> order(images.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return images[a]->getHeight() > images[b]->getHeight();
+        });
+        std::vector<int> ids(images.size(), -1);
+        for (size_t index : order) {
+            ids[index] = add(*images[index]);
+        }
+        return ids;
+    }
+
+    double TextureAtlas::getOccupancy() const {
+        return static_cast<double>(used_pixels_) / (static_cast<double>(width_) * height_);
+    }
+
+} // namespace SoftRenderer
@@ -0,0 +1,88 @@
+//
+//  TextureAtlas.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef TextureAtlas_hpp
+#define TextureAtlas_hpp
+
+#include <vector>
+#include "YUVTexture.hpp"
+
+/**
+ * 纹理图集：把大量小图（图标、字形）打包进一张 I420 纹理，整批精灵只绑定一张纹理，
+ * 采样集中在一块连续内存上，也不必为每个小图分配一个 YUVTexture。
+ *
+ * 装箱采用货架（Shelf）算法：按行开辟“货架”，小图放入高度最接近且剩余宽度足够的货架，放不下时开新货架。
+ * 每个小图四周留 padding 像素的边，边内复制小图的边缘像素：双线性过滤在区域边缘采样到的邻居与单独一张纹理的
+ * CLAMP_TO_EDGE 相同，不会渗入相邻小图的颜色。
+ * 小图位置和 padding 都是偶数，色度平面（1/2 分辨率）与亮度对齐。
+ */
+namespace SoftRenderer {
+
+    // 小图在图集中的位置：像素矩形和对应的归一化纹理坐标（u1、v1 为右、下边界）
+    struct AtlasRegion {
+        int x = 0, y = 0, width = 0, height = 0;
+        float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+    };
+
+    class TextureAtlas {
+    public:
+        /**
+         * @param width 图集宽度（正偶数）
+         * @param height 图集高度（正偶数）
+         * @param padding 每个小图四周的边宽，向上取偶数
+         * 尺寸无效时抛出 std::invalid_argument。未使用的区域为黑色（Y=0，U=V=128）。
+         */
+        TextureAtlas(int width, int height, int padding = 2);
+
+        TextureAtlas(const TextureAtlas &) = delete;
+        TextureAtlas &operator=(const TextureAtlas &) = delete;
+
+        // 复制 image 到图集中，返回区域编号；空间不足时抛出 std::runtime_error
+        int add(const YUVTexture &image);
+
+        /**
+         * 批量添加：按高度从高到低装箱（货架算法在这个顺序下浪费最少），返回的编号与 images 的顺序一致。
+         * 空间不足时抛出 std::runtime_error，此时已放入的小图保留。
+         */
+        std::vector<int> add(const std::vector<const YUVTexture *> &images);
+
+        const AtlasRegion &getRegion(int id) const { return regions_.at(id); }
+        int getRegionCount() const { return static_cast<int>(regions_.size()); }
+
+        /**
+         * 图集纹理（直接在图集平面上采样，不拷贝）。add 会改写平面，不能与采样并发调用；
+         * 若开启了 RGB 缓存，add 会使其失效。
+         */
+        YUVTexture &getTexture() { return texture_; }
+        const YUVTexture &getTexture() const { return texture_; }
+
+        // 已被货架占用的像素比例
+        double getOccupancy() const;
+
+    private:
+        struct Shelf {
+            int y, height;
+            int cursor; // 下一个可用的 x
+        };
+
+        // 为 width × height（含 padding）找位置，失败返回 false
+        bool allocate(int width, int height, int &x, int &y);
+
+        void copyImage(const YUVTexture &image, int x, int y);
+
+        int width_, height_, padding_;
+        std::vector<unsigned char> y_plane_, u_plane_, v_plane_;
+        YUVTexture texture_;
+        std::vector<Shelf> shelves_;
+        int next_shelf_y_ = 0;
+        long long used_pixels_ = 0;
+        std::vector<AtlasRegion> regions_;
+    };
+
+} // namespace SoftRenderer
+
+#endif /* TextureAtlas_hpp */
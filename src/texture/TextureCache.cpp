@@ -0,0 +1,180 @@
+//
+//  TextureCache.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <functional>
+#include "TextureCache.hpp"
+
+namespace SoftRenderer {
+
+    namespace {
+        // 2×2 盒式滤波降采样一个平面，w、h 为源平面尺寸（需为偶数），stride 为源平面行跨度
+        std::vector<unsigned char> downsamplePlane(const unsigned char *src, size_t stride, int w, int h) {
+            int dst_w = w / 2;
+            int dst_h = h / 2;
+            std::vector<unsigned char> dst(static_cast<size_t>(dst_w) * dst_h);
+            for (int y = 0; y < dst_h; ++y) {
+                const unsigned char *row0 = src + static_cast<size_t>(2 * y) * stride;
+                const unsigned char *row1 = row0 + stride;
+                unsigned char *out = &dst[static_cast<size_t>(y) * dst_w];
+                for (int x = 0; x < dst_w; ++x) {
+                    // +2 实现四舍五入
+                    int sum = row0[2 * x] + row0[2 * x + 1] + row1[2 * x] + row1[2 * x + 1];
+                    out[x] = static_cast<unsigned char>((sum + 2) >> 2);
+                }
+            }
+            return dst;
+        }
+
+        // 生成 mip 链：下一级的宽高必须仍是偶数（I420 要求），否则停止
+        std::vector<std::shared_ptr<const YUVTexture>> buildMipChain(const YUVTexture &base) {
+            std::vector<std::shared_ptr<const YUVTexture>> chain;
+            const YUVTexture *level = &base;
+            while (level->getWidth() % 4 == 0 && level->getHeight() % 4 == 0) {
+                int w = level->getWidth();
+                int h = level->getHeight();
+                auto next = std::make_shared<YUVTexture>(
+                    w / 2, h / 2,
+                    downsamplePlane(level->getYData(), level->getYStride(), w, h),
+                    downsamplePlane(level->getUData(), level->getUStride(), w / 2, h / 2),
+                    downsamplePlane(level->getVData(), level->getVStride(), w / 2, h / 2));
+                next->setFilterMode(base.getFilterMode());
+                chain.push_back(next);
+                level = next.get();
+            }
+            return chain;
+        }
+    } // namespace
+
+    size_t TextureKeyHash::operator()(const TextureKey &key) const {
+        // 经典的 hash_combine
+        size_t seed = std::hash<std::string>()(key.path);
+        auto combine = [&seed](size_t value) {
+            seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        };
+        combine(std::hash<int>()(key.width));
+        combine(std::hash<int>()(key.height));
+        combine(std::hash<int>()(static_cast<int>(key.format)));
+        combine(std::hash<int>()(key.frame_index));
+        return seed;
+    }
+
+    TiledPlane TiledPlane::build(const unsigned char *plane, size_t stride, int w, int h, int tile_size) {
+        TiledPlane tiled;
+        tiled.width = w;
+        tiled.height = h;
+        tiled.tile_size = tile_size;
+        tiled.tiles_x = (w + tile_size - 1) / tile_size;
+        tiled.tiles_y = (h + tile_size - 1) / tile_size;
+        tiled.data.resize(static_cast<size_t>(tiled.tiles_x) * tiled.tiles_y * tile_size * tile_size);
+
+        unsigned char *out = tiled.data.data();
+        for (int ty = 0; ty < tiled.tiles_y; ++ty) {
+            for (int tx = 0; tx < tiled.tiles_x; ++tx) {
+                for (int y = 0; y < tile_size; ++y) {
+                    // 超出边界的行列钳位到边缘像素
+                    int src_y = std::min(ty * tile_size + y, h - 1);
+                    const unsigned char *row = plane + static_cast<size_t>(src_y) * stride;
+                    for (int x = 0; x < tile_size; ++x) {
+                        int src_x = std::min(tx * tile_size + x, w - 1);
+                        *out++ = row[src_x];
+                    }
+                }
+            }
+        }
+        return tiled;
+    }
+
+    TextureCache::TextureCache(const TextureCacheOptions &options) : options_(options) {
+        if (options_.tile_size <= 0) {
+            throw std::invalid_argument("TextureCache: tile_size 必须大于0");
+        }
+    }
+
+    TextureHandle TextureCache::acquire(const TextureKey &key) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = index_.find(key);
+            if (it != index_.end()) {
+                ++stats_.hits;
+                lru_.splice(lru_.begin(), lru_, it->second); // 移到头部，迭代器保持有效
+                return it->second->second;
+            }
+            ++stats_.misses;
+        }
+
+        // 文件 I/O 和派生数据生成在锁外进行，避免阻塞其他线程的命中查询
+        TextureHandle handle = load(key);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            // 其他线程已抢先插入，使用已有的那份
+            lru_.splice(lru_.begin(), lru_, it->second);
+            return it->second->second;
+        }
+        lru_.emplace_front(key, handle);
+        index_[key] = lru_.begin();
+        stats_.resident_bytes += handle->memory_bytes;
+        evictLocked();
+        return handle;
+    }
+
+    void TextureCache::setBudget(size_t budget_bytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        options_.budget_bytes = budget_bytes;
+        evictLocked();
+    }
+
+    void TextureCache::clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        lru_.clear();
+        index_.clear();
+        stats_.resident_bytes = 0;
+    }
+
+    TextureCacheStats TextureCache::getStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        TextureCacheStats stats = stats_;
+        stats.entry_count = index_.size();
+        return stats;
+    }
+
+    TextureHandle TextureCache::load(const TextureKey &key) const {
+        auto entry = std::make_shared<CachedTexture>();
+
+        auto texture = std::make_shared<YUVTexture>(key.path, key.width, key.height, key.frame_index);
+        texture->setFilterMode(options_.filter_mode);
+        entry->texture = texture;
+        entry->memory_bytes = texture->getMemoryBytes();
+
+        if (options_.build_mip_chain) {
+            entry->mip_chain = buildMipChain(*texture);
+            for (const auto &level : entry->mip_chain) {
+                entry->memory_bytes += level->getMemoryBytes();
+            }
+        }
+
+        if (options_.build_tiled_layout) {
+            entry->tiled_y = TiledPlane::build(texture->getYData(), texture->getYStride(), key.width, key.height, options_.tile_size);
+            entry->memory_bytes += entry->tiled_y.data.size();
+        }
+
+        return entry;
+    }
+
+    void TextureCache::evictLocked() {
+        // 至少保留最近插入的一条：单个纹理超过预算时也要能正常返回
+        while (stats_.resident_bytes > options_.budget_bytes && lru_.size() > 1) {
+            auto &victim = lru_.back();
+            stats_.resident_bytes -= victim.second->memory_bytes;
+            index_.erase(victim.first);
+            lru_.pop_back();
+            ++stats_.evictions;
+        }
+    }
+
+} // namespace SoftRenderer
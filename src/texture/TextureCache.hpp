@@ -0,0 +1,133 @@
+//
+//  TextureCache.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef TextureCache_hpp
+#define TextureCache_hpp
+
+#include <list>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include "YUVTexture.hpp"
+
+/**
+ * 纹理缓存：长时间运行的批处理任务会反复使用同一批背景、台标、LUT 纹理，
+ * 每次都重新读文件、重新分配 YUVTexture 既浪费 I/O 也浪费加载时间。
+ *
+ * acquire(key)
+ *     ├── 命中 → 返回共享的只读句柄，并移到 LRU 链表头部
+ *     └── 未命中 → 读文件 + 生成派生数据 → 插入缓存 → 超出预算时从 LRU 尾部淘汰
+ */
+namespace SoftRenderer {
+
+    // 缓存键：同一文件的不同尺寸/格式/帧视为不同纹理
+    struct TextureKey {
+        std::string path;
+        int width = 0;
+        int height = 0;
+        YUVFormat format = YUVFormat::I420;
+        int frame_index = 0;
+
+        bool operator==(const TextureKey &other) const {
+            return path == other.path && width == other.width && height == other.height &&
+                   format == other.format && frame_index == other.frame_index;
+        }
+    };
+
+    struct TextureKeyHash {
+        size_t operator()(const TextureKey &key) const;
+    };
+
+    /**
+     * 分块（Tiled）布局的平面：把行主序平面重排成 tile_size × tile_size 的小块连续存放，
+     * 块内仍是行主序。旋转、缩放等“斜着走”的采样能在一个块内命中更多缓存行。
+     * 边缘不足一块的部分用最近的边缘像素填充（与 CLAMP_TO_EDGE 一致）。
+     */
+    struct TiledPlane {
+        int width = 0, height = 0;   // 原平面尺寸
+        int tile_size = 0;
+        int tiles_x = 0, tiles_y = 0;
+        std::vector<unsigned char> data;
+
+        unsigned char at(int x, int y) const {
+            int tile_index = (y / tile_size) * tiles_x + (x / tile_size);
+            int in_tile = (y % tile_size) * tile_size + (x % tile_size);
+            return data[static_cast<size_t>(tile_index) * tile_size * tile_size + in_tile];
+        }
+
+        static TiledPlane build(const unsigned char *plane, size_t stride, int w, int h, int tile_size);
+    };
+
+    // 缓存条目：纹理本体 + 可选的预计算派生数据，整体只读，可在多线程间共享
+    struct CachedTexture {
+        std::shared_ptr<const YUVTexture> texture;
+        // mip_chain[0] 是第 1 级（宽高各减半），直到宽高不再满足 I420 偶数要求为止
+        std::vector<std::shared_ptr<const YUVTexture>> mip_chain;
+        // 仅对 Y 平面生成分块布局（U/V 平面只有 1/4 大小，重排收益不大）
+        TiledPlane tiled_y;
+        // 本条目占用的总字节数（含派生数据），计入缓存预算
+        size_t memory_bytes = 0;
+    };
+
+    using TextureHandle = std::shared_ptr<const CachedTexture>;
+
+    struct TextureCacheOptions {
+        size_t budget_bytes = 256u * 1024u * 1024u; // 内存预算，默认 256 MB
+        bool build_mip_chain = false;               // 加载时预生成 mip 链
+        bool build_tiled_layout = false;            // 加载时预生成 Y 平面分块布局
+        int tile_size = 32;                         // 分块布局的块边长
+        TextureFilter filter_mode = TextureFilter::NEAREST; // 句柄只读，过滤模式在加载时设定
+    };
+
+    struct TextureCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t resident_bytes = 0;
+        size_t entry_count = 0;
+    };
+
+    class TextureCache {
+    public:
+        explicit TextureCache(const TextureCacheOptions &options = TextureCacheOptions());
+
+        /**
+         * 获取纹理，未命中时从磁盘加载。线程安全。
+         * 被淘汰的条目只是离开缓存，已经发出去的句柄仍然有效（共享所有权）。
+         * 文件读取在锁外进行，多个线程同时未命中同一个键时可能重复加载，最终只保留先插入的那份。
+         * @throws std::runtime_error / std::invalid_argument 与 YUVTexture 构造函数相同
+         */
+        TextureHandle acquire(const TextureKey &key);
+
+        // 调整预算，立即按新预算淘汰
+        void setBudget(size_t budget_bytes);
+
+        // 清空缓存（不计入淘汰次数）
+        void clear();
+
+        TextureCacheStats getStats() const;
+
+    private:
+        using LRUList = std::list<std::pair<TextureKey, TextureHandle>>;
+
+        TextureHandle load(const TextureKey &key) const;
+
+        // 调用方需持有 mutex_
+        void evictLocked();
+
+        TextureCacheOptions options_;
+        mutable std::mutex mutex_;
+        LRUList lru_; // 头部最近使用，尾部最久未使用
+        std::unordered_map<TextureKey, LRUList::iterator, TextureKeyHash> index_;
+        TextureCacheStats stats_;
+    };
+
+} // namespace SoftRenderer
+
+#endif /* TextureCache_hpp */
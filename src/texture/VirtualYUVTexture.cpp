@@ -0,0 +1,257 @@
+//
+//  VirtualYUVTexture.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "VirtualYUVTexture.hpp"
+
+namespace SoftRenderer {
+
+    namespace {
+        // 与 YUVTexture::samplePlaneBilinear 相同的纹素中心对齐、钳位和 smoothstep 权重，纹素通过 fetch 获取
+        template <typename Fetch>
+        float bilinear(const Fetch &fetch, int plane_width, int plane_height, float u, float v) {
+            float center_based_x = u * plane_width - 0.5f;
+            float center_based_y = v * plane_height - 0.5f;
+            int x0 = static_cast<int>(std::floor(center_based_x));
+            int y0 = static_cast<int>(std::floor(center_based_y));
+            int x1 = std::clamp(x0 + 1, 0, plane_width - 1);
+            int y1 = std::clamp(y0 + 1, 0, plane_height - 1);
+            x0 = std::clamp(x0, 0, plane_width - 1);
+            y0 = std::clamp(y0, 0, plane_height - 1);
+
+            float s = center_based_x - static_cast<float>(x0);
+            float t = center_based_y - static_cast<float>(y0);
+            s = std::clamp(s * s * (3.0f - 2.0f * s), 0.0f, 1.0f);
+            t = std::clamp(t * t * (3.0f - 2.0f * t), 0.0f, 1.0f);
+
+            float bottom = (1.0f - s) * fetch(x0, y0) + s * fetch(x1, y0);
+            float top = (1.0f - s) * fetch(x0, y1) + s * fetch(x1, y1);
+            return (1.0f - t) * bottom + t * top;
+        }
+    } // namespace
+
+    VirtualYUVTexture::VirtualYUVTexture(const std::string &filename, int w, int h, int frame_index,
+                                         int page_size, size_t max_resident_pages)
+        : width_(w), height_(h), page_size_(page_size), max_resident_pages_(max_resident_pages),
+          file_(filename, std::ios::binary) {
+        if (w <= 0 || h <= 0 || w % 2 != 0 || h % 2 != 0) {
+            throw std::invalid_argument("YUV420要求宽高为正偶数");
+        }
+        if (page_size <= 0 || page_size % 2 != 0) {
+            throw std::invalid_argument("虚拟纹理页边长必须为正偶数");
+        }
+        if (frame_index < 0) {
+            throw std::invalid_argument("帧序号不能为负数");
+        }
+        if (!file_) {
+            throw std::runtime_error("Failed to open YUV file: " + filename);
+        }
+
+        frame_offset_ = YUVTexture::frameSize(w, h) * static_cast<size_t>(frame_index);
+        file_.seekg(0, std::ios::end);
+        size_t file_size = static_cast<size_t>(file_.tellg());
+        size_t expected_size = frame_offset_ + YUVTexture::frameSize(w, h);
+        if (file_size < expected_size) {
+            throw std::runtime_error("YUV文件大小不足: 期望 " + std::to_string(expected_size) +
+                                     " bytes, 实际 " + std::to_string(file_size) + " bytes");
+        }
+
+        pages_x_ = (w + page_size - 1) / page_size;
+        pages_y_ = (h + page_size - 1) / page_size;
+        const size_t page_count = static_cast<size_t>(pages_x_) * pages_y_;
+        page_table_.reset(new std::atomic<Page *>[page_count]);
+        for (size_t i = 0; i < page_count; ++i) {
+            page_table_[i].store(nullptr, std::memory_order_relaxed);
+        }
+        requested_.assign(page_count, 0);
+    }
+
+    VirtualYUVTexture::~VirtualYUVTexture() = default;
+
+    void VirtualYUVTexture::requestRegion(float u0, float v0, float u1, float v1) {
+        // 扩展 1 个纹素：双线性采样会读到相邻纹素
+        int x0 = static_cast<int>(std::floor(std::min(u0, u1) * width_)) - 1;
+        int x1 = static_cast<int>(std::ceil(std::max(u0, u1) * width_)) + 1;
+        int y0 = static_cast<int>(std::floor(std::min(v0, v1) * height_)) - 1;
+        int y1 = static_cast<int>(std::ceil(std::max(v0, v1) * height_)) + 1;
+        x0 = std::clamp(x0, 0, width_ - 1);
+        x1 = std::clamp(x1, 0, width_ - 1);
+        y0 = std::clamp(y0, 0, height_ - 1);
+        y1 = std::clamp(y1, 0, height_ - 1);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int py = y0 / page_size_; py <= y1 / page_size_; ++py) {
+            for (int px = x0 / page_size_; px <= x1 / page_size_; ++px) {
+                requested_[static_cast<size_t>(py) * pages_x_ + px] = 1;
+            }
+        }
+    }
+
+    size_t VirtualYUVTexture::commitRequests() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t loaded = 0;
+
+        // 1. 加载缺失的页（按页下标顺序，即文件中大致从前到后的顺序）
+        for (size_t i = 0; i < requested_.size(); ++i) {
+            if (!requested_[i]) {
+                continue;
+            }
+            const int page_index = static_cast<int>(i);
+            if (!resident_.count(page_index)) {
+                std::unique_ptr<Page> page = loadPageLocked(page_index);
+                page_table_[i].store(page.get(), std::memory_order_release);
+                resident_[page_index] = std::move(page);
+                ++loaded;
+            }
+            touchLocked(page_index);
+        }
+
+        // 2. 淘汰：从 LRU 尾部开始，跳过本次请求的页
+        auto it = lru_.end();
+        while (resident_.size() > max_resident_pages_ && it != lru_.begin()) {
+            --it;
+            const int page_index = *it;
+            if (requested_[page_index]) {
+                continue;
+            }
+            page_table_[page_index].store(nullptr, std::memory_order_relaxed);
+            stats_.resident_bytes -= resident_[page_index]->y.size() * 3 / 2;
+            resident_.erase(page_index);
+            lru_index_.erase(page_index);
+            it = lru_.erase(it);
+            ++stats_.evictions;
+        }
+
+        std::fill(requested_.begin(), requested_.end(), 0);
+        return loaded;
+    }
+
+    void VirtualYUVTexture::touchLocked(int page_index) const {
+        auto found = lru_index_.find(page_index);
+        if (found != lru_index_.end()) {
+            lru_.splice(lru_.begin(), lru_, found->second);
+        } else {
+            lru_.push_front(page_index);
+            lru_index_[page_index] = lru_.begin();
+        }
+    }
+
+    std::unique_ptr<VirtualYUVTexture::Page> VirtualYUVTexture::loadPageLocked(int page_index) const {
+        const int px = page_index % pages_x_;
+        const int py = page_index / pages_x_;
+        const int x0 = px * page_size_;
+        const int y0 = py * page_size_;
+
+        auto page = std::make_unique<Page>();
+        page->width = std::min(page_size_, width_ - x0);
+        page->height = std::min(page_size_, height_ - y0);
+        page->y.resize(static_cast<size_t>(page->width) * page->height);
+
+        // Y 块：逐行定位读取（页内的行在文件中不连续）
+        for (int row = 0; row < page->height; ++row) {
+            size_t offset = frame_offset_ + static_cast<size_t>(y0 + row) * width_ + x0;
+            file_.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+            file_.read(reinterpret_cast<char *>(&page->y[static_cast<size_t>(row) * page->width]), page->width);
+        }
+
+        // U/V 块：宽高各为 Y 块的一半
+        const int chroma_width = width_ / 2;
+        const int chroma_height = height_ / 2;
+        const int page_cw = page->width / 2;
+        const int page_ch = page->height / 2;
+        const size_t u_offset = frame_offset_ + static_cast<size_t>(width_) * height_;
+        const size_t v_offset = u_offset + static_cast<size_t>(chroma_width) * chroma_height;
+        page->u.resize(static_cast<size_t>(page_cw) * page_ch);
+        page->v.resize(page->u.size());
+        for (int row = 0; row < page_ch; ++row) {
+            size_t in_plane = static_cast<size_t>(y0 / 2 + row) * chroma_width + x0 / 2;
+            file_.seekg(static_cast<std::streamoff>(u_offset + in_plane), std::ios::beg);
+            file_.read(reinterpret_cast<char *>(&page->u[static_cast<size_t>(row) * page_cw]), page_cw);
+            file_.seekg(static_cast<std::streamoff>(v_offset + in_plane), std::ios::beg);
+            file_.read(reinterpret_cast<char *>(&page->v[static_cast<size_t>(row) * page_cw]), page_cw);
+        }
+
+        if (!file_) {
+            throw std::runtime_error("读取虚拟纹理页失败");
+        }
+
+        ++stats_.page_loads;
+        stats_.resident_bytes += page->y.size() * 3 / 2;
+        return page;
+    }
+
+    const VirtualYUVTexture::Page &VirtualYUVTexture::page(int page_index) const {
+        Page *resident = page_table_[page_index].load(std::memory_order_acquire);
+        if (resident) {
+            return *resident;
+        }
+
+        // 兜底：反馈没有覆盖到的页，采样时同步加载（下次 commitRequests 时参与淘汰）
+        std::lock_guard<std::mutex> lock(mutex_);
+        resident = page_table_[page_index].load(std::memory_order_relaxed);
+        if (!resident) {
+            std::unique_ptr<Page> page = loadPageLocked(page_index);
+            resident = page.get();
+            resident_[page_index] = std::move(page);
+            touchLocked(page_index);
+            ++stats_.fallback_loads;
+            page_table_[page_index].store(resident, std::memory_order_release);
+        }
+        return *resident;
+    }
+
+    unsigned char VirtualYUVTexture::fetchY(int x, int y) const {
+        const Page &p = page((y / page_size_) * pages_x_ + x / page_size_);
+        return p.y[static_cast<size_t>(y % page_size_) * p.width + x % page_size_];
+    }
+
+    void VirtualYUVTexture::fetchUV(int cx, int cy, unsigned char &u, unsigned char &v) const {
+        // 色度纹素 (cx, cy) 对应 Y 纹素 (2cx, 2cy) 所在的页
+        const int chroma_page = page_size_ / 2;
+        const Page &p = page((cy / chroma_page) * pages_x_ + cx / chroma_page);
+        size_t index = static_cast<size_t>(cy % chroma_page) * (p.width / 2) + cx % chroma_page;
+        u = p.u[index];
+        v = p.v[index];
+    }
+
+    void VirtualYUVTexture::sampleYUV(float u, float v,
+                                      unsigned char &y_val, unsigned char &u_val, unsigned char &v_val) const {
+        if (filter_mode_ == TextureFilter::NEAREST) {
+            // 与 YUVTexture::sampleNearest 相同的取整和钳位
+            int pix_x = std::clamp(static_cast<int>(u * width_), 0, width_ - 1);
+            int pix_y = std::clamp(static_cast<int>(v * height_), 0, height_ - 1);
+            y_val = fetchY(pix_x, pix_y);
+            fetchUV(pix_x / 2, pix_y / 2, u_val, v_val);
+            return;
+        }
+
+        auto fetch_y = [this](int x, int y) { return static_cast<float>(fetchY(x, y)); };
+        auto fetch_u = [this](int x, int y) {
+            unsigned char cu, cv;
+            fetchUV(x, y, cu, cv);
+            return static_cast<float>(cu);
+        };
+        auto fetch_v = [this](int x, int y) {
+            unsigned char cu, cv;
+            fetchUV(x, y, cu, cv);
+            return static_cast<float>(cv);
+        };
+        y_val = static_cast<unsigned char>(std::clamp(bilinear(fetch_y, width_, height_, u, v), 0.0f, 255.0f));
+        u_val = static_cast<unsigned char>(std::clamp(bilinear(fetch_u, width_ / 2, height_ / 2, u, v), 0.0f, 255.0f));
+        v_val = static_cast<unsigned char>(std::clamp(bilinear(fetch_v, width_ / 2, height_ / 2, u, v), 0.0f, 255.0f));
+    }
+
+    VirtualTextureStats VirtualYUVTexture::getStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        VirtualTextureStats stats = stats_;
+        stats.resident_pages = resident_.size();
+        return stats;
+    }
+
+} // namespace SoftRenderer
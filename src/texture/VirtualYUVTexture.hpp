@@ -0,0 +1,132 @@
+//
+//  VirtualYUVTexture.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef VirtualYUVTexture_hpp
+#define VirtualYUVTexture_hpp
+
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <unordered_map>
+#include "YUVTexture.hpp"
+
+/**
+ * 虚拟纹理（Sparse / Virtual Texturing）：YUVTexture 需要在第一次采样前把整张图读进内存，
+ * 对 16K 全景图只裁剪/放大一小块区域时，绝大部分 I/O 和内存都被浪费了。
+ *
+ * 纹理按页（Page）切分：一页 = page_size × page_size 的 Y 块 + 对应的 (page_size/2)² 的 U、V 块。
+ *
+ * 反馈阶段（Feedback Pass）：Rasterizer::collectFootprint → requestRegion，标记可见区域覆盖的页
+ *     ↓
+ * commitRequests()：批量读入缺失的页，按 LRU 淘汰超出驻留上限且本次未请求的页
+ *     ↓
+ * 绘制阶段：采样时通过页表直接访问驻留页；遇到未驻留的页（反馈不完整）时同步加载兜底
+ *
+ * 加载时间和内存由可见区域决定，而不是源图尺寸。
+ */
+namespace SoftRenderer {
+
+    struct VirtualTextureStats {
+        uint64_t page_loads = 0;       // 累计加载的页数
+        uint64_t fallback_loads = 0;   // 其中在采样时同步加载的页数（反馈遗漏）
+        uint64_t evictions = 0;
+        size_t resident_pages = 0;
+        size_t resident_bytes = 0;
+    };
+
+    class VirtualYUVTexture {
+    public:
+        /**
+         * 只打开文件并校验大小，不读取像素数据
+         * @param filename I420 文件路径
+         * @param w 纹理宽度（偶数）
+         * @param h 纹理高度（偶数）
+         * @param frame_index 多帧文件中的帧序号
+         * @param page_size 页边长（Y 平面纹素，必须为正偶数）
+         * @param max_resident_pages 驻留页数上限，commitRequests 时按 LRU 淘汰
+         */
+        VirtualYUVTexture(const std::string &filename, int w, int h, int frame_index = 0,
+                          int page_size = 128, size_t max_resident_pages = 256);
+        ~VirtualYUVTexture();
+
+        VirtualYUVTexture(const VirtualYUVTexture &) = delete;
+        VirtualYUVTexture &operator=(const VirtualYUVTexture &) = delete;
+
+        void setFilterMode(TextureFilter mode) { filter_mode_ = mode; }
+        TextureFilter getFilterMode() const { return filter_mode_; }
+        void setColorSpace(ColorSpaceStandard standard) { color_space_ = standard; }
+        ColorSpaceStandard getColorSpace() const { return color_space_; }
+
+        int getWidth() const { return width_; }
+        int getHeight() const { return height_; }
+        int getPageSize() const { return page_size_; }
+        int getPageCount() const { return pages_x_ * pages_y_; }
+
+        /**
+         * 反馈：请求归一化纹理坐标矩形 [u0, u1] × [v0, v1] 覆盖的所有页（含双线性需要的 1 纹素边缘）。
+         * 线程安全。
+         */
+        void requestRegion(float u0, float v0, float u1, float v1);
+
+        /**
+         * 加载所有已请求但未驻留的页，并淘汰超出上限的最久未使用页（本次请求的页不会被淘汰）。
+         * 不能与采样并发调用。
+         * @return 本次加载的页数
+         */
+        size_t commitRequests();
+
+        // 与 YUVTexture::sampleYUV 相同的接口和寻址规则。可多线程并发调用。
+        void sampleYUV(float u, float v, unsigned char &y_val, unsigned char &u_val, unsigned char &v_val) const;
+
+        VirtualTextureStats getStats() const;
+
+    private:
+        struct Page {
+            int width = 0, height = 0; // 本页 Y 块的实际尺寸（边缘页可能不满）
+            std::vector<unsigned char> y, u, v;
+        };
+
+        // 返回已驻留的页，未驻留时同步加载（兜底路径）
+        const Page &page(int page_index) const;
+
+        // 从文件读取一页，调用方需持有 mutex_
+        std::unique_ptr<Page> loadPageLocked(int page_index) const;
+
+        // 把页标记为最近使用，调用方需持有 mutex_
+        void touchLocked(int page_index) const;
+
+        unsigned char fetchY(int x, int y) const;
+        void fetchUV(int cx, int cy, unsigned char &u, unsigned char &v) const;
+
+        int width_, height_;
+        int page_size_;
+        int pages_x_, pages_y_;
+        size_t max_resident_pages_;
+        size_t frame_offset_;
+        TextureFilter filter_mode_ = TextureFilter::NEAREST;
+        ColorSpaceStandard color_space_ = ColorSpaceStandard::BT601;
+
+        // 页表：采样时无锁读取；页只在 commitRequests（不与采样并发）时被释放
+        std::unique_ptr<std::atomic<Page *>[]> page_table_;
+
+        mutable std::mutex mutex_;
+        mutable std::ifstream file_;
+        mutable std::unordered_map<int, std::unique_ptr<Page>> resident_;
+        mutable std::list<int> lru_; // 头部最近使用
+        mutable std::unordered_map<int, std::list<int>::iterator> lru_index_;
+        std::vector<unsigned char> requested_;
+        mutable VirtualTextureStats stats_;
+    };
+
+} // namespace SoftRenderer
+
+#endif /* VirtualYUVTexture_hpp */
@@ -7,27 +7,51 @@
 
 #include "YUVTexture.hpp"
 #include <iostream>
+#include <mutex>
+#include <atomic>
+#include <stdexcept>
+#include <array>
+#include <cstdint>
 
 namespace SoftRenderer {
 
+    // 惰性 RGB 缓存的内部状态：每块一个就绪标记（双重检查），转换时加锁
+    struct YUVTexture::RGBCache {
+        ColorSpaceStandard standard;
+        int tile_size;
+        int tiles_x, tiles_y;
+        std::vector<std::unique_ptr<unsigned char[]>> tiles;
+        std::unique_ptr<std::atomic<bool>[]> ready;
+        std::atomic<size_t> bytes{0};
+        std::mutex mutex;
+
+        RGBCache(ColorSpaceStandard s, int tile, int w, int h)
+            : standard(s), tile_size(tile),
+              tiles_x((w + tile - 1) / tile), tiles_y((h + tile - 1) / tile),
+              tiles(static_cast<size_t>(tiles_x) * tiles_y),
+              ready(new std::atomic<bool>[static_cast<size_t>(tiles_x) * tiles_y]) {
+            for (size_t i = 0; i < tiles.size(); ++i) {
+                ready[i].store(false, std::memory_order_relaxed);
+            }
+        }
+    };
+
     /// I420格式（YUV420P）的数据排列：[YYYYYYYY][UUUU][VVVV]
     /// Y平面：完整分辨率（width × height）
     /// U平面：1/4分辨率（width/2 × height/2）
     /// V平面：1/4分辨率（width/2 × height/2）
     /// 文件大小计算：width × height × 1.5 bytes
-    YUVTexture::YUVTexture(const std::string &filename, int w, int h) : width_(w), height_(h) {
-        if (width_ <= 0 || height_ <= 0)
-        {
-            throw std::invalid_argument("纹理尺寸必须大于0");
-        }
+    YUVTexture::YUVTexture(const std::string &filename, int w, int h, int frame_index) : width_(w), height_(h) {
+        validateSize(width_, height_);
 
-        if (width_ % 2 != 0 || height_ % 2 != 0)
+        if (frame_index < 0)
         {
-            throw std::invalid_argument("YUV420要求宽高为偶数");
+            throw std::invalid_argument("帧序号不能为负数");
         }
         
-        int y_size = w * h;
-        int uv_size = (w / 2) * (h / 2);
+        // 使用 64 位大小，超大纹理（如 16K 全景图）的 w × h 可能超出 int 范围
+        size_t y_size = static_cast<size_t>(w) * h;
+        size_t uv_size = static_cast<size_t>(w / 2) * (h / 2);
 
         y_plane_.resize(y_size);
         u_plane_.resize(uv_size);
@@ -44,13 +68,16 @@ namespace SoftRenderer {
         size_t file_size = ifs.tellg(); // 计算size
         ifs.seekg(0, std::ios::beg);    // 完毕移至开头，便于后续读取操作。
         
-        size_t expected_size = y_size + uv_size * 2;
+        // 多帧文件中，第 frame_index 帧从 frame_index × 单帧大小 处开始
+        size_t frame_offset = frameSize(w, h) * static_cast<size_t>(frame_index);
+        size_t expected_size = frame_offset + y_size + uv_size * 2;
         if (file_size < expected_size)
         {
             throw std::runtime_error("YUV文件大小不足: 期望 " +
                                      std::to_string(expected_size) + " bytes, 实际 " +
                                      std::to_string(file_size) + " bytes");
         }
+        ifs.seekg(static_cast<std::streamoff>(frame_offset), std::ios::beg);
 
         if (!ifs.read(reinterpret_cast<char *>(y_plane_.data()), y_size))
         {
@@ -64,11 +91,73 @@ namespace SoftRenderer {
         {
             throw std::runtime_error("读取V分量失败");
         }
+        bindOwnedPlanes();
+    }
+
+    YUVTexture::YUVTexture(int w, int h,
+                           std::vector<unsigned char> y_plane,
+                           std::vector<unsigned char> u_plane,
+                           std::vector<unsigned char> v_plane)
+        : y_plane_(std::move(y_plane)), u_plane_(std::move(u_plane)), v_plane_(std::move(v_plane)),
+          width_(w), height_(h) {
+        validateSize(width_, height_);
+
+        size_t y_size = static_cast<size_t>(w) * h;
+        size_t uv_size = static_cast<size_t>(w / 2) * (h / 2);
+        if (y_plane_.size() != y_size || u_plane_.size() != uv_size || v_plane_.size() != uv_size)
+        {
+            throw std::invalid_argument("YUV平面尺寸与宽高不匹配");
+        }
+        bindOwnedPlanes();
+    }
+
+    YUVTexture::YUVTexture(int w, int h, const YUVPlaneView &view) : width_(w), height_(h) {
+        validateSize(width_, height_);
+
+        if (!view.y || !view.u || !view.v)
+        {
+            throw std::invalid_argument("YUV平面指针不能为空");
+        }
+        if (view.y_stride < static_cast<size_t>(w) || view.u_stride < static_cast<size_t>(w / 2) ||
+            view.v_stride < static_cast<size_t>(w / 2))
+        {
+            throw std::invalid_argument("YUV平面行跨度小于行宽");
+        }
+        y_data_ = view.y;
+        u_data_ = view.u;
+        v_data_ = view.v;
+        y_stride_ = view.y_stride;
+        u_stride_ = view.u_stride;
+        v_stride_ = view.v_stride;
+    }
+
+    void YUVTexture::bindOwnedPlanes() {
+        y_data_ = y_plane_.data();
+        u_data_ = u_plane_.data();
+        v_data_ = v_plane_.data();
+        y_stride_ = static_cast<size_t>(width_);
+        u_stride_ = v_stride_ = static_cast<size_t>(width_ / 2);
     }
 
-    void YUVTexture::sampleYUV(float u, float v,
+    YUVTexture::YUVTexture(YUVTexture &&other) noexcept = default;
+    YUVTexture &YUVTexture::operator=(YUVTexture &&other) noexcept = default;
+    YUVTexture::~YUVTexture() = default;
+
+    void YUVTexture::validateSize(int w, int h) {
+        if (w <= 0 || h <= 0)
+        {
+            throw std::invalid_argument("纹理尺寸必须大于0");
+        }
+
+        if (w % 2 != 0 || h % 2 != 0)
+        {
+            throw std::invalid_argument("YUV420要求宽高为偶数");
+        }
+    }
+
+    void YUVTexture::sampleYUV(float u, float v, TextureFilter filter,
                                unsigned char &y_val, unsigned char &u_val, unsigned char &v_val) const {
-        switch (filter_mode_)
+        switch (filter)
         {
         case TextureFilter::NEAREST:
             sampleNearest(u, v, y_val, u_val, v_val);
@@ -112,21 +201,141 @@ namespace SoftRenderer {
         pix_y = pix_y >= height_ ? height_ - 1 : pix_y;
 
         // 3. Y 分量采样
-        int y_index = pix_y * width_ + pix_x;
-        y_val = y_plane_[y_index];
+        size_t y_index = static_cast<size_t>(pix_y) * y_stride_ + pix_x;
+        y_val = y_data_[y_index];
 
         // 4. U/V 分量采样 (4:2:0 降采样)
         int uv_x = pix_x / 2;
         int uv_y = pix_y / 2;
-        int uv_width = width_ / 2;
-        int uv_index = uv_y * uv_width + uv_x;
+        // U、V 平面的行跨度可以不同（外部内存视图）
+        u_val = u_data_[static_cast<size_t>(uv_y) * u_stride_ + uv_x];
+        v_val = v_data_[static_cast<size_t>(uv_y) * v_stride_ + uv_x];
+    }
+
+    unsigned char YUVTexture::sampleLuma(float u, float v, TextureFilter filter) const {
+        if (filter == TextureFilter::BILINEAR) {
+            float y_interpolated = samplePlaneBilinear(y_data_, y_stride_, width_, height_, u, v);
+            return static_cast<unsigned char>(std::clamp(y_interpolated, 0.0f, 255.0f));
+        }
+        // 与 sampleNearest 相同的取整和钳位规则
+        int pix_x = std::clamp(static_cast<int>(u * width_), 0, width_ - 1);
+        int pix_y = std::clamp(static_cast<int>(v * height_), 0, height_ - 1);
+        return y_data_[static_cast<size_t>(pix_y) * y_stride_ + pix_x];
+    }
+
+    void YUVTexture::sampleChroma(float u, float v, TextureFilter filter, unsigned char &u_val, unsigned char &v_val) const {
+        if (filter == TextureFilter::BILINEAR) {
+            float u_interpolated = samplePlaneBilinear(u_data_, u_stride_, width_ / 2, height_ / 2, u, v);
+            float v_interpolated = samplePlaneBilinear(v_data_, v_stride_, width_ / 2, height_ / 2, u, v);
+            u_val = static_cast<unsigned char>(std::clamp(u_interpolated, 0.0f, 255.0f));
+            v_val = static_cast<unsigned char>(std::clamp(v_interpolated, 0.0f, 255.0f));
+            return;
+        }
+        int pix_x = std::clamp(static_cast<int>(u * width_), 0, width_ - 1);
+        int pix_y = std::clamp(static_cast<int>(v * height_), 0, height_ - 1);
+        u_val = u_data_[static_cast<size_t>(pix_y / 2) * u_stride_ + pix_x / 2];
+        v_val = v_data_[static_cast<size_t>(pix_y / 2) * v_stride_ + pix_x / 2];
+    }
+
+    namespace {
+        // smoothstep 权重表：分数部分 [0, 255] → 权重 [0, 256]（8 位定点，256 表示 1.0）
+        const uint16_t *smoothstepWeights() {
+            static const auto table = [] {
+                std::array<uint16_t, 256> t{};
+                for (int i = 0; i < 256; ++i) {
+                    float s = static_cast<float>(i) / 256.0f;
+                    t[i] = static_cast<uint16_t>(std::lround(s * s * (3.0f - 2.0f * s) * 256.0f));
+                }
+                return t;
+            }();
+            return table.data();
+        }
+
+        // 归一化坐标 → 纹素中心坐标的 8 位定点数，等价于 floor((coord × size - 0.5) × 256)。
+        // coord ∈ [0,1] 时 (coord × size + 0.5) 非负，截断即向下取整；结果 ≥ -128
+        inline int toFixedTexel(float coord, int size) {
+            return static_cast<int>((coord * static_cast<float>(size) + 0.5f) * 256.0f) - 256;
+        }
+
+        // 定点双线性：w_s/w_t ∈ [0, 256]，结果截断到 8 位（与浮点版本的 static_cast 一致）
+        inline unsigned char bilerpFixed(int c00, int c10, int c01, int c11, int w_s, int w_t) {
+            int bottom = c00 * (256 - w_s) + c10 * w_s;
+            int top = c01 * (256 - w_s) + c11 * w_s;
+            return static_cast<unsigned char>((bottom * (256 - w_t) + top * w_t) >> 16);
+        }
+    } // namespace
+
+    void YUVTexture::sampleBilinearQuad(const float u[4], const float v[4],
+                                        unsigned char y_val[4], unsigned char u_val[4], unsigned char v_val[4]) const {
+        const uint16_t *weights = smoothstepWeights();
+
+        // 1. Y 平面（全分辨率）：逐像素定点双线性
+        int x0[4], y0[4], w_s[4], w_t[4];
+        for (int i = 0; i < 4; ++i) {
+            int fx = toFixedTexel(u[i], width_);
+            int fy = toFixedTexel(v[i], height_);
+            x0[i] = fx >> 8; // 算术右移 = 向下取整
+            y0[i] = fy >> 8;
+            w_s[i] = weights[fx & 255];
+            w_t[i] = weights[fy & 255];
+        }
+        for (int i = 0; i < 4; ++i) {
+            // 边界钳位（CLAMP_TO_EDGE）：x0 = -1 或 x1 = width 时两个纹素相同，权重不再影响结果
+            int xa = std::clamp(x0[i], 0, width_ - 1);
+            int xb = std::clamp(x0[i] + 1, 0, width_ - 1);
+            const unsigned char *row0 = y_data_ + static_cast<size_t>(std::clamp(y0[i], 0, height_ - 1)) * y_stride_;
+            const unsigned char *row1 = y_data_ + static_cast<size_t>(std::clamp(y0[i] + 1, 0, height_ - 1)) * y_stride_;
+            y_val[i] = bilerpFixed(row0[xa], row0[xb], row1[xa], row1[xb], w_s[i], w_t[i]);
+        }
+
+        // 2. U/V 平面（1/4 分辨率）：先算 4 个像素的足迹
+        const int chroma_width = width_ / 2;
+        const int chroma_height = height_ / 2;
+        for (int i = 0; i < 4; ++i) {
+            int fx = toFixedTexel(u[i], chroma_width);
+            int fy = toFixedTexel(v[i], chroma_height);
+            x0[i] = fx >> 8;
+            y0[i] = fy >> 8;
+            w_s[i] = weights[fx & 255];
+            w_t[i] = weights[fy & 255];
+        }
+
+        const bool shared_footprint = x0[0] == x0[1] && x0[0] == x0[2] && x0[0] == x0[3] &&
+                                      y0[0] == y0[1] && y0[0] == y0[2] && y0[0] == y0[3];
+        if (shared_footprint) {
+            // 3a. 足迹相同：2×2 色度纹素只读取一次，4 个像素只有权重不同
+            int xa = std::clamp(x0[0], 0, chroma_width - 1);
+            int xb = std::clamp(x0[0] + 1, 0, chroma_width - 1);
+            size_t row0 = static_cast<size_t>(std::clamp(y0[0], 0, chroma_height - 1));
+            size_t row1 = static_cast<size_t>(std::clamp(y0[0] + 1, 0, chroma_height - 1));
+            const unsigned char *u_row0 = u_data_ + row0 * u_stride_, *u_row1 = u_data_ + row1 * u_stride_;
+            const unsigned char *v_row0 = v_data_ + row0 * v_stride_, *v_row1 = v_data_ + row1 * v_stride_;
+            const int u00 = u_row0[xa], u10 = u_row0[xb];
+            const int u01 = u_row1[xa], u11 = u_row1[xb];
+            const int v00 = v_row0[xa], v10 = v_row0[xb];
+            const int v01 = v_row1[xa], v11 = v_row1[xb];
+            for (int i = 0; i < 4; ++i) {
+                u_val[i] = bilerpFixed(u00, u10, u01, u11, w_s[i], w_t[i]);
+                v_val[i] = bilerpFixed(v00, v10, v01, v11, w_s[i], w_t[i]);
+            }
+            return;
+        }
 
-        u_val = u_plane_[uv_index];
-        v_val = v_plane_[uv_index];
+        // 3b. 足迹不同（缩小或跨越纹素边界）：逐像素读取
+        for (int i = 0; i < 4; ++i) {
+            int xa = std::clamp(x0[i], 0, chroma_width - 1);
+            int xb = std::clamp(x0[i] + 1, 0, chroma_width - 1);
+            size_t row0 = static_cast<size_t>(std::clamp(y0[i], 0, chroma_height - 1));
+            size_t row1 = static_cast<size_t>(std::clamp(y0[i] + 1, 0, chroma_height - 1));
+            const unsigned char *u_row0 = u_data_ + row0 * u_stride_, *u_row1 = u_data_ + row1 * u_stride_;
+            const unsigned char *v_row0 = v_data_ + row0 * v_stride_, *v_row1 = v_data_ + row1 * v_stride_;
+            u_val[i] = bilerpFixed(u_row0[xa], u_row0[xb], u_row1[xa], u_row1[xb], w_s[i], w_t[i]);
+            v_val[i] = bilerpFixed(v_row0[xa], v_row0[xb], v_row1[xa], v_row1[xb], w_s[i], w_t[i]);
+        }
     }
 
     // 辅助函数：在指定平面上进行双线性采样
-    float YUVTexture::samplePlaneBilinear(const std::vector<unsigned char>& plane,
+    float YUVTexture::samplePlaneBilinear(const unsigned char *plane, size_t stride,
                                           int planeWidth, int planeHeight,
                                           float u, float v) const {
         // 1. 坐标转换，双线性采样：downcast到最近的四个像素坐标
@@ -185,10 +394,10 @@ namespace SoftRenderer {
         t = std::clamp(t, 0.0f, 1.0f);
 
         // 6. 双线性插值采样：获取四个像素的U值。
-        unsigned char u00 = plane[y0 * planeWidth + x0]; // 左下 (x0, y0)
-        unsigned char u10 = plane[y0 * planeWidth + x1]; // 右下 (x1, y0)
-        unsigned char u01 = plane[y1 * planeWidth + x0]; // 左上 (x0, y1)
-        unsigned char u11 = plane[y1 * planeWidth + x1]; // 右上 (x1, y1)
+        unsigned char u00 = plane[static_cast<size_t>(y0) * stride + x0]; // 左下 (x0, y0)
+        unsigned char u10 = plane[static_cast<size_t>(y0) * stride + x1]; // 右下 (x1, y0)
+        unsigned char u01 = plane[static_cast<size_t>(y1) * stride + x0]; // 左上 (x0, y1)
+        unsigned char u11 = plane[static_cast<size_t>(y1) * stride + x1]; // 右上 (x1, y1)
 
         // 7. 双线性插值：先水平、后垂直。
         float bottom = (1.0f - s) * static_cast<float>(u00) + s * static_cast<float>(u10); // 下边插值
@@ -199,16 +408,126 @@ namespace SoftRenderer {
 
     void YUVTexture::sampleBilinear(float u, float v, unsigned char &y_val, unsigned char &u_val, unsigned char &v_val) const {
         // 1. Y分量双线性插值采样（全分辨率）
-        float y_interpolated = samplePlaneBilinear(y_plane_, width_, height_, u, v);
+        float y_interpolated = samplePlaneBilinear(y_data_, y_stride_, width_, height_, u, v);
         y_val = static_cast<unsigned char>(std::clamp(y_interpolated, 0.0f, 255.0f));
         
         // 2. U分量双线性插值采样， (4:2:0 降采样)
-        float u_interpolated = samplePlaneBilinear(u_plane_, width_ / 2, height_ / 2, u, v);
+        float u_interpolated = samplePlaneBilinear(u_data_, u_stride_, width_ / 2, height_ / 2, u, v);
         u_val = static_cast<unsigned char>(std::clamp(u_interpolated, 0.0f, 255.0f));
 
         // 3. V分量双线性插值采样， (4:2:0 降采样)
-        float v_interpolated = samplePlaneBilinear(v_plane_, width_ / 2, height_ / 2, u, v);
+        float v_interpolated = samplePlaneBilinear(v_data_, v_stride_, width_ / 2, height_ / 2, u, v);
         v_val = static_cast<unsigned char>(std::clamp(v_interpolated, 0.0f, 255.0f));
     }
 
+    void YUVTexture::enableRGBCache(ColorSpaceStandard standard, int tile_size) {
+        if (tile_size <= 0) {
+            throw std::invalid_argument("RGB缓存块大小必须大于0");
+        }
+        rgb_cache_ = std::make_unique<RGBCache>(standard, tile_size, width_, height_);
+    }
+
+    void YUVTexture::releaseRGBCache() {
+        rgb_cache_.reset();
+    }
+
+    void YUVTexture::invalidateRGBCache() {
+        if (!rgb_cache_) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(rgb_cache_->mutex);
+        for (size_t i = 0; i < rgb_cache_->tiles.size(); ++i) {
+            rgb_cache_->ready[i].store(false, std::memory_order_relaxed);
+            rgb_cache_->tiles[i].reset();
+        }
+        rgb_cache_->bytes.store(0, std::memory_order_relaxed);
+    }
+
+    size_t YUVTexture::getRGBCacheBytes() const {
+        return rgb_cache_ ? rgb_cache_->bytes.load(std::memory_order_relaxed) : 0;
+    }
+
+    const unsigned char *YUVTexture::rgbTexel(int x, int y) const {
+        RGBCache &cache = *rgb_cache_;
+        const int tile_x = x / cache.tile_size;
+        const int tile_y = y / cache.tile_size;
+        const size_t tile_index = static_cast<size_t>(tile_y) * cache.tiles_x + tile_x;
+
+        if (!cache.ready[tile_index].load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            if (!cache.ready[tile_index].load(std::memory_order_relaxed)) {
+                // 首次触碰：整块转换。块内布局为行主序 RGBA，边缘块按实际尺寸填充
+                const int x0 = tile_x * cache.tile_size;
+                const int y0 = tile_y * cache.tile_size;
+                const int x1 = std::min(x0 + cache.tile_size, width_);
+                const int y1 = std::min(y0 + cache.tile_size, height_);
+                const size_t tile_bytes = static_cast<size_t>(cache.tile_size) * cache.tile_size * 4;
+                std::unique_ptr<unsigned char[]> data(new unsigned char[tile_bytes]());
+
+                for (int ty = y0; ty < y1; ++ty) {
+                    const unsigned char *y_row = y_data_ + static_cast<size_t>(ty) * y_stride_;
+                    const unsigned char *u_row = u_data_ + static_cast<size_t>(ty / 2) * u_stride_;
+                    const unsigned char *v_row = v_data_ + static_cast<size_t>(ty / 2) * v_stride_;
+                    unsigned char *out = &data[(static_cast<size_t>(ty - y0) * cache.tile_size) * 4];
+                    for (int tx = x0; tx < x1; ++tx) {
+                        Color rgb = yuvToRGB(y_row[tx], u_row[tx / 2], v_row[tx / 2], cache.standard);
+                        out[0] = rgb.r;
+                        out[1] = rgb.g;
+                        out[2] = rgb.b;
+                        out[3] = 255;
+                        out += 4;
+                    }
+                }
+                cache.tiles[tile_index] = std::move(data);
+                cache.bytes.fetch_add(tile_bytes, std::memory_order_relaxed);
+                cache.ready[tile_index].store(true, std::memory_order_release);
+            }
+        }
+
+        const int in_tile = (y - tile_y * cache.tile_size) * cache.tile_size + (x - tile_x * cache.tile_size);
+        return &cache.tiles[tile_index][static_cast<size_t>(in_tile) * 4];
+    }
+
+    Color YUVTexture::sampleRGB(float u, float v, TextureFilter filter) const {
+        if (!rgb_cache_) {
+            throw std::logic_error("RGB缓存未开启，请先调用 enableRGBCache()");
+        }
+
+        if (filter == TextureFilter::NEAREST) {
+            // 与 sampleNearest 相同的取整和钳位规则
+            int pix_x = std::clamp(static_cast<int>(u * width_), 0, width_ - 1);
+            int pix_y = std::clamp(static_cast<int>(v * height_), 0, height_ - 1);
+            const unsigned char *texel = rgbTexel(pix_x, pix_y);
+            return Color(texel[0], texel[1], texel[2]);
+        }
+
+        // 与 samplePlaneBilinear 相同的纹素中心对齐、钳位和 smoothstep 权重，只是作用在 RGB 上
+        float center_based_x = u * width_ - 0.5f;
+        float center_based_y = v * height_ - 0.5f;
+        int x0 = static_cast<int>(std::floor(center_based_x));
+        int y0 = static_cast<int>(std::floor(center_based_y));
+        int x1 = std::clamp(x0 + 1, 0, width_ - 1);
+        int y1 = std::clamp(y0 + 1, 0, height_ - 1);
+        x0 = std::clamp(x0, 0, width_ - 1);
+        y0 = std::clamp(y0, 0, height_ - 1);
+
+        float s = center_based_x - static_cast<float>(x0);
+        float t = center_based_y - static_cast<float>(y0);
+        s = std::clamp(s * s * (3.0f - 2.0f * s), 0.0f, 1.0f);
+        t = std::clamp(t * t * (3.0f - 2.0f * t), 0.0f, 1.0f);
+
+        const unsigned char *c00 = rgbTexel(x0, y0);
+        const unsigned char *c10 = rgbTexel(x1, y0);
+        const unsigned char *c01 = rgbTexel(x0, y1);
+        const unsigned char *c11 = rgbTexel(x1, y1);
+
+        unsigned char result[3];
+        for (int c = 0; c < 3; ++c) {
+            float bottom = (1.0f - s) * c00[c] + s * c10[c];
+            float top = (1.0f - s) * c01[c] + s * c11[c];
+            result[c] = static_cast<unsigned char>(std::clamp((1.0f - t) * bottom + t * top, 0.0f, 255.0f));
+        }
+        return Color(result[0], result[1], result[2]);
+    }
+
 } // namespace SoftRenderer
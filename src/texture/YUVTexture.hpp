@@ -12,7 +12,9 @@
 #include <vector>
 #include <string>
 #include <fstream>
+#include <memory>
 #include <algorithm>
+#include "ColorSpace.hpp"
 
 /**
  YUVTexture (YUV数据)
@@ -36,13 +38,58 @@ namespace SoftRenderer {
           BILINEAR  // 双线性插值
      };
 
+     // 纹理源数据的像素格式，目前只支持 I420（YUV420P），作为纹理缓存键的一部分预留扩展
+     enum class YUVFormat {
+          I420
+     };
+
+     /**
+      * 外部内存中的 I420 平面（不拥有数据）：每个平面一个首地址和以字节为单位的行跨度（stride），
+      * 行跨度不小于该平面的行宽，允许行尾有对齐填充（如解码器输出的帧）。
+      */
+     struct YUVPlaneView {
+          const unsigned char *y = nullptr;
+          const unsigned char *u = nullptr;
+          const unsigned char *v = nullptr;
+          size_t y_stride = 0;
+          size_t u_stride = 0;
+          size_t v_stride = 0;
+     };
+
      class YUVTexture {
      public:
-          // 从文件加载数据
-          YUVTexture(const std::string &filename, int w, int h);
+          /**
+           * 从文件加载数据
+           * @param filename YUV 文件路径，文件可包含多帧（按帧顺序连续存放）
+           * @param w 纹理宽度
+           * @param h 纹理高度
+           * @param frame_index 读取第几帧，从 0 开始
+           */
+          YUVTexture(const std::string &filename, int w, int h, int frame_index = 0);
+
+          // 直接由内存中的三个平面构造（用于 mipmap 等派生纹理），平面尺寸必须与 I420 布局一致
+          YUVTexture(int w, int h,
+                     std::vector<unsigned char> y_plane,
+                     std::vector<unsigned char> u_plane,
+                     std::vector<unsigned char> v_plane);
+
+          /**
+           * 零拷贝：直接在调用方的平面内存上采样，不复制数据。调用方负责保证内存在纹理的生命周期内有效且不被改写
+           * （改写后若开启了 RGB 缓存，需调用 invalidateRGBCache）。
+           */
+          YUVTexture(int w, int h, const YUVPlaneView &view);
+
+          // RGB 缓存持有互斥量，纹理只能移动不能拷贝
+          YUVTexture(YUVTexture &&other) noexcept;
+          YUVTexture &operator=(YUVTexture &&other) noexcept;
+          ~YUVTexture();
 
           void setFilterMode(TextureFilter mode) { filter_mode_ = mode; }
 
+          // 纹理数据所采用的 YUV 标准，决定转换到 RGB（或其他 YUV 标准）时使用的系数，默认 BT.601
+          void setColorSpace(ColorSpaceStandard standard) { color_space_ = standard; }
+          ColorSpaceStandard getColorSpace() const { return color_space_; }
+
           /**
            * 根据纹理坐标获取YUV值，此时还不能显示
            * @param u 归一化水平纹理坐标u [0,1]，0=左边界，1=右边界
@@ -52,25 +99,115 @@ namespace SoftRenderer {
            * @param v_val 输出：色度分量V（为避免命名冲突）
            */
           void sampleYUV(float u, float v,
+                         unsigned char &y_val, unsigned char &u_val, unsigned char &v_val) const {
+              sampleYUV(u, v, filter_mode_, y_val, u_val, v_val);
+          }
+
+          /**
+           * 以 filter 指定的过滤方式采样，不读取也不修改纹理的过滤模式。
+           * 同一张纹理需要以不同过滤方式绘制时（如 Rasterizer::setFilterOverride）使用，纹理保持只读。
+           * 下面 sampleLuma、sampleChroma、sampleRGB 带 filter 参数的重载同理。
+           */
+          void sampleYUV(float u, float v, TextureFilter filter,
                          unsigned char &y_val, unsigned char &u_val, unsigned char &v_val) const;
 
           int getWidth() const { return width_; }
 
           int getHeight() const { return height_; }
 
+          TextureFilter getFilterMode() const { return filter_mode_; }
+
+          /**
+           * 只采样亮度 / 只采样色度，使用当前过滤模式，结果与 sampleYUV 对应分量一致。
+           * 直接输出 YUV420 时亮度和色度的采样频率不同（色度每 2×2 像素一次），分开采样避免浪费。
+           */
+          unsigned char sampleLuma(float u, float v) const { return sampleLuma(u, v, filter_mode_); }
+          void sampleChroma(float u, float v, unsigned char &u_val, unsigned char &v_val) const {
+              sampleChroma(u, v, filter_mode_, u_val, v_val);
+          }
+          unsigned char sampleLuma(float u, float v, TextureFilter filter) const;
+          void sampleChroma(float u, float v, TextureFilter filter, unsigned char &u_val, unsigned char &v_val) const;
+
+          /**
+           * 2×2 像素块（Quad）双线性采样：一次采样 4 个像素，忽略当前过滤模式，总是双线性。
+           * 1. 权重使用 8 位定点数（smoothstep 查表），全程整数运算，4 个通道写成定长循环便于编译器向量化；
+           * 2. U/V 平面只有 1/4 分辨率，4 个像素的色度采样足迹通常落在同一组 2×2 色度纹素上，
+           *    此时色度纹素只读取一次、4 个像素共享。
+           * 结果与 sampleYUV 的浮点双线性相比每个分量误差不超过 ±1。
+           * @param u 4 个像素的归一化纹理坐标 u（需已钳制到 [0,1]），顺序为左上、右上、左下、右下
+           * @param v 4 个像素的归一化纹理坐标 v
+           */
+          void sampleBilinearQuad(const float u[4], const float v[4],
+                                  unsigned char y_val[4], unsigned char u_val[4], unsigned char v_val[4]) const;
+
+          // 平面数据只读访问：首地址 + 行跨度（字节），纹素 (x, y) 位于 data[y × stride + x]
+          const unsigned char *getYData() const { return y_data_; }
+          const unsigned char *getUData() const { return u_data_; }
+          const unsigned char *getVData() const { return v_data_; }
+          size_t getYStride() const { return y_stride_; }
+          size_t getUStride() const { return u_stride_; }
+          size_t getVStride() const { return v_stride_; }
+
+          // 纹理自身拥有的平面占用的字节数，用于缓存的内存预算统计（外部内存视图为 0）
+          size_t getMemoryBytes() const { return y_plane_.size() + u_plane_.size() + v_plane_.size(); }
+
+          // 单帧 I420 数据的字节数：w × h × 1.5
+          static size_t frameSize(int w, int h) { return static_cast<size_t>(w) * h * 3 / 2; }
+
+          /**
+           * 惰性 RGB 缓存：同一张纹理被反复绘制时，每次采样都要重新做 yuvToRGB。
+           * 开启后，纹理按 tile_size × tile_size 分块，某块第一次被采样时才整块转换为 RGBA 并缓存，
+           * 之后的采样（sampleRGB）直接读取转换结果，不再做任何颜色计算。
+           *
+           * 注意：双线性过滤会在转换后的 RGB 上进行（先转换、后过滤），与 sampleYUV 先过滤、后转换的结果
+           * 存在细微差异；开启缓存即表示调用方接受这一结果。
+           *
+           * 内存：每块 tile_size² × 4 字节，只在首次访问时分配，可通过 getRGBCacheBytes() 查询。
+           * 重复调用会丢弃已有缓存并按新的标准/块大小重建。
+           * 不指定 standard 时按纹理自身的颜色标准（getColorSpace()）转换。
+           */
+          void enableRGBCache(ColorSpaceStandard standard, int tile_size = 64);
+          void enableRGBCache(int tile_size = 64) { enableRGBCache(color_space_, tile_size); }
+
+          // 释放缓存内存并关闭 RGB 缓存
+          void releaseRGBCache();
+
+          // 保留开启状态，但丢弃所有已转换的块（纹理数据被改写后调用），下次访问时重新转换。
+          // 与 releaseRGBCache 一样，不能与采样并发调用。
+          void invalidateRGBCache();
+
+          bool hasRGBCache() const { return rgb_cache_ != nullptr; }
+
+          // RGB 缓存当前实际占用的字节数
+          size_t getRGBCacheBytes() const;
+
+          /**
+           * 从 RGB 缓存采样，使用当前过滤模式。线程安全：多个线程可以同时采样，首次触碰的块只转换一次。
+           * 必须先调用 enableRGBCache()，否则抛出 std::logic_error。
+           */
+          Color sampleRGB(float u, float v) const { return sampleRGB(u, v, filter_mode_); }
+          Color sampleRGB(float u, float v, TextureFilter filter) const;
+
      private:
+          // 校验宽高是否满足 I420 要求，不满足时抛出 std::invalid_argument
+          static void validateSize(int w, int h);
+
+          // 让平面指针指向自有的 vector（std::vector 移动时缓冲区地址不变，移动构造/赋值后指针依然有效）
+          void bindOwnedPlanes();
+
           void sampleNearest(float u, float v,
                              unsigned char &y_val, unsigned char &u_val, unsigned char &v_val) const;
           /**
            * 在指定平面上进行双线性采样
            * @param plane 纹理平面数据
+           * @param stride 平面的行跨度（字节）
            * @param planeWidth 纹理平面宽度
            * @param planeHeight 纹理平面高度
            * @param u 归一化水平纹理坐标u [0,1]，0=左边界，1=右边界
            * @param v 归一化垂直纹理坐标v [0,1]，0=上边界，1=下边界
            * @return 插值后的采样值
            */
-          float samplePlaneBilinear(const std::vector<unsigned char> &plane,
+          float samplePlaneBilinear(const unsigned char *plane, size_t stride,
                                     int planeWidth, int planeHeight,
                                     float u, float v) const;
           /**
@@ -83,9 +220,16 @@ namespace SoftRenderer {
            */
           void sampleBilinear(float u, float v,
                               unsigned char &y_val, unsigned char &u_val, unsigned char &v_val) const;
+          struct RGBCache;
+
+          // 返回纹素 (x, y) 在 RGB 缓存中的 RGBA 地址，所在块尚未转换时先转换
+          const unsigned char *rgbTexel(int x, int y) const;
+
           // 纹理过滤模式，使用成员变量一次设定每次采样受益。也更符合现代图形API的“状态机”模型设计思路。
           TextureFilter filter_mode_ = TextureFilter::NEAREST;
 
+          ColorSpaceStandard color_space_ = ColorSpaceStandard::BT601;
+
           /// 为什么用std::vector<unsigned char>而不是float？
           /// 因为unsigned char兼顾了传输性能和图像质量，一般来讲8bit对于视觉上能接受的图片精度已然足够，
           /// 除非进行复杂的数字信号处理（颜色空间变换、hdr、滤镜渲染等）才需要将8bit数据转成flaot类型32bit。
@@ -96,7 +240,16 @@ namespace SoftRenderer {
           std::vector<unsigned char> u_plane_;
           std::vector<unsigned char> v_plane_;
 
+          // 采样实际使用的平面地址和行跨度：指向上面的自有平面，或外部内存视图
+          const unsigned char *y_data_ = nullptr;
+          const unsigned char *u_data_ = nullptr;
+          const unsigned char *v_data_ = nullptr;
+          size_t y_stride_ = 0, u_stride_ = 0, v_stride_ = 0;
+
           int width_, height_; // 宽高
+
+          // 惰性 RGB 缓存，未开启时为空
+          std::unique_ptr<RGBCache> rgb_cache_;
      };
 
 } // namespace SoftRenderer
@@ -0,0 +1,295 @@
+//
+//  SoftRendererGen.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <cmath>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#include "core/YUVSequenceWriter.hpp"
+#include "tools/TestPattern.hpp"
+#include "tools/Workload.hpp"
+#include "tuning/AutoTuner.hpp"
+#include "rasterization/RealtimeRenderer.hpp"
+
+/**
+ * SoftRendererGen：压测输入生成工具
+ *   SoftRendererGen pattern <gradient|bars|checker|zoneplate|noise> <宽> <高> <帧数> <输出>
+ *                   [--format i420|nv12|y4m] [--seed N] [--scroll N] [--cell N] [--standard bt601|bt709|bt2020]
+ *   SoftRendererGen workload <sprites|quads|slivers|mixed> <数量> <宽> <高> <输出>
+ *                   [--seed N] [--sprite-size N]
+ *   SoftRendererGen tune <宽> <高> <纹理宽> <纹理高> <配置文件> [--repeat N]
+ *   SoftRendererGen realtime <宽> <高> <层数> <帧数> [--deadline 毫秒] [--texture N]
+ * 未指定 --format 时按扩展名推断（.y4m / .nv12，其余为 I420）。
+ */
+namespace {
+
+    using namespace SoftRenderer;
+
+    void printUsage() {
+        std::cerr << "用法:\n"
+                  << "  SoftRendererGen pattern <gradient|bars|checker|zoneplate|noise> <宽> <高> <帧数> <输出>\n"
+                  << "                  [--format i420|nv12|y4m] [--seed N] [--scroll N] [--cell N]\n"
+                  << "                  [--standard bt601|bt709|bt2020]\n"
+                  << "  SoftRendererGen workload <sprites|quads|slivers|mixed> <数量> <宽> <高> <输出>\n"
+                  << "                  [--seed N] [--sprite-size N]\n"
+                  << "  SoftRendererGen tune <宽> <高> <纹理宽> <纹理高> <配置文件> [--repeat N]\n"
+                  << "  SoftRendererGen realtime <宽> <高> <层数> <帧数> [--deadline 毫秒] [--texture N]\n";
+    }
+
+    long long parseInteger(const std::string &text) {
+        size_t consumed = 0;
+        long long value = std::stoll(text, &consumed);
+        if (consumed != text.size()) {
+            throw std::invalid_argument("无效的整数: " + text);
+        }
+        return value;
+    }
+
+    // 解析 argv[first..] 中的 "--name value" 选项，handler 返回 false 表示未知选项
+    template <typename Handler>
+    void parseOptions(int argc, char *argv[], int first, Handler &&handler) {
+        for (int i = first; i < argc; i += 2) {
+            const std::string name = argv[i];
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("选项缺少取值: " + name);
+            }
+            if (!handler(name, std::string(argv[i + 1]))) {
+                throw std::invalid_argument("未知选项: " + name);
+            }
+        }
+    }
+
+    int runPattern(int argc, char *argv[]) {
+        if (argc < 7) {
+            printUsage();
+            return 1;
+        }
+        TestPatternOptions options;
+        if (!parseTestPatternType(argv[2], options.type)) {
+            throw std::invalid_argument(std::string("未知图案: ") + argv[2]);
+        }
+        const int width = static_cast<int>(parseInteger(argv[3]));
+        const int height = static_cast<int>(parseInteger(argv[4]));
+        const int frames = static_cast<int>(parseInteger(argv[5]));
+        const std::string output = argv[6];
+        YUVFileFormat format = yuvFileFormatFromPath(output);
+        ColorSpaceStandard standard = ColorSpaceStandard::BT601;
+
+        parseOptions(argc, argv, 7, [&](const std::string &name, const std::string &value) {
+            if (name == "--format") {
+                if (value == "i420") {
+                    format = YUVFileFormat::I420;
+                } else if (value == "nv12") {
+                    format = YUVFileFormat::NV12;
+                } else if (value == "y4m") {
+                    format = YUVFileFormat::Y4M;
+                } else {
+                    throw std::invalid_argument("未知格式: " + value);
+                }
+            } else if (name == "--seed") {
+                options.seed = static_cast<uint64_t>(parseInteger(value));
+            } else if (name == "--scroll") {
+                options.scroll_per_frame = static_cast<int>(parseInteger(value));
+            } else if (name == "--cell") {
+                options.cell_size = static_cast<int>(parseInteger(value));
+            } else if (name == "--standard") {
+                if (value == "bt601") {
+                    standard = ColorSpaceStandard::BT601;
+                } else if (value == "bt709") {
+                    standard = ColorSpaceStandard::BT709;
+                } else if (value == "bt2020") {
+                    standard = ColorSpaceStandard::BT2020;
+                } else {
+                    throw std::invalid_argument("未知颜色标准: " + value);
+                }
+            } else {
+                return false;
+            }
+            return true;
+        });
+        if (frames <= 0) {
+            throw std::invalid_argument("帧数必须为正");
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        TestPatternGenerator generator(width, height, options, standard);
+        YUVFrameBuffer frame(width, height, standard);
+        YUVSequenceWriter writer(output, width, height, format);
+        for (int i = 0; i < frames; ++i) {
+            generator.renderFrame(i, frame);
+            if (!writer.writeFrame(frame)) {
+                throw std::runtime_error("写入失败: " + output);
+            }
+        }
+        if (!writer.finish()) {
+            throw std::runtime_error("写入失败: " + output);
+        }
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "已生成 " << width << "x" << height << " × " << frames << " 帧 → " << output
+                  << "（" << elapsed << " 秒）" << std::endl;
+        return 0;
+    }
+
+    int runWorkload(int argc, char *argv[]) {
+        if (argc < 7) {
+            printUsage();
+            return 1;
+        }
+        WorkloadOptions options;
+        if (!parseWorkloadType(argv[2], options.type)) {
+            throw std::invalid_argument(std::string("未知负载类型: ") + argv[2]);
+        }
+        const long long count = parseInteger(argv[3]);
+        if (count < 0) {
+            throw std::invalid_argument("数量不能为负");
+        }
+        options.count = static_cast<size_t>(count);
+        options.width = static_cast<int>(parseInteger(argv[4]));
+        options.height = static_cast<int>(parseInteger(argv[5]));
+        const std::string output = argv[6];
+
+        parseOptions(argc, argv, 7, [&](const std::string &name, const std::string &value) {
+            if (name == "--seed") {
+                options.seed = static_cast<uint64_t>(parseInteger(value));
+            } else if (name == "--sprite-size") {
+                options.sprite_size = static_cast<float>(parseInteger(value));
+            } else {
+                return false;
+            }
+            return true;
+        });
+
+        std::vector<Vertex> vertices = generateWorkload(options);
+        if (!saveWorkload(output, vertices)) {
+            throw std::runtime_error("写入失败: " + output);
+        }
+        std::cout << "已生成 " << vertices.size() / 3 << " 个三角形 → " << output << std::endl;
+        return 0;
+    }
+
+    // 按需调优：重新校准该尺寸等级，合并写入配置文件并打印报告
+    int runTune(int argc, char *argv[]) {
+        if (argc < 7) {
+            printUsage();
+            return 1;
+        }
+        const int width = static_cast<int>(parseInteger(argv[2]));
+        const int height = static_cast<int>(parseInteger(argv[3]));
+        const int texture_width = static_cast<int>(parseInteger(argv[4]));
+        const int texture_height = static_cast<int>(parseInteger(argv[5]));
+        AutoTuner tuner(argv[6]);
+
+        parseOptions(argc, argv, 7, [&](const std::string &name, const std::string &value) {
+            if (name == "--repeat") {
+                tuner.setRepetitions(static_cast<int>(parseInteger(value)));
+            } else {
+                return false;
+            }
+            return true;
+        });
+
+        auto start = std::chrono::steady_clock::now();
+        tuner.calibrate(width, height, texture_width, texture_height);
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << tuner.getReport() << "校准耗时 " << elapsed << " 秒，已写入 " << argv[6] << std::endl;
+        return 0;
+    }
+
+    /**
+     * 实时模式演练：每帧叠加若干层旋转中的噪声纹理（双线性，铺满画面），由 RealtimeRenderer 按时限选档，
+     * 输出帧耗时分布、超时帧数和各档位的使用次数。
+     */
+    int runRealtime(int argc, char *argv[]) {
+        if (argc < 6) {
+            printUsage();
+            return 1;
+        }
+        const int width = static_cast<int>(parseInteger(argv[2]));
+        const int height = static_cast<int>(parseInteger(argv[3]));
+        const int layers = static_cast<int>(parseInteger(argv[4]));
+        const int frames = static_cast<int>(parseInteger(argv[5]));
+        RealtimeSettings settings;
+        int texture_size = 1024;
+        parseOptions(argc, argv, 6, [&](const std::string &name, const std::string &value) {
+            if (name == "--deadline") {
+                settings.deadline_ms = std::stod(value);
+            } else if (name == "--texture") {
+                texture_size = static_cast<int>(parseInteger(value));
+            } else {
+                return false;
+            }
+            return true;
+        });
+        if (layers <= 0 || frames <= 0) {
+            throw std::invalid_argument("层数和帧数必须大于0");
+        }
+
+        TestPatternOptions options;
+        options.type = TestPatternType::NOISE;
+        YUVFrameBuffer source(texture_size, texture_size);
+        TestPatternGenerator(texture_size, texture_size, options).renderFrame(0, source);
+        YUVTexture texture(texture_size, texture_size, source.getYPlane(), source.getUPlane(), source.getVPlane());
+        texture.setFilterMode(TextureFilter::BILINEAR);
+
+        RealtimeRenderer renderer(settings);
+        FrameBuffer fb(width, height);
+        const float cx = width * 0.5f, cy = height * 0.5f;
+        const float half_w = width * 0.6f, half_h = height * 0.6f;
+        for (int frame = 0; frame < frames; ++frame) {
+            renderer.beginFrame();
+            for (int layer = 0; layer < layers; ++layer) {
+                const float angle = 0.01f * frame + 0.4f * layer;
+                const float c = std::cos(angle), s = std::sin(angle);
+                auto corner = [&](float x, float y, float u, float v) {
+                    return Vertex(cx + x * c - y * s, cy + x * s + y * c, u, v);
+                };
+                renderer.drawTexturedQuad(corner(-half_w, -half_h, 0, 0), corner(half_w, -half_h, 1, 0),
+                                          corner(half_w, half_h, 1, 1), corner(-half_w, half_h, 0, 1), texture);
+            }
+            renderer.endFrame(fb);
+        }
+
+        const RealtimeStats stats = renderer.getStats();
+        std::cout << "时限 " << settings.deadline_ms << " ms，共 " << stats.frames << " 帧，超时 " << stats.missed
+                  << " 帧\n帧耗时 p50 " << stats.p50_ms << " ms，p99 " << stats.p99_ms << " ms，最大 " << stats.max_ms << " ms\n";
+        for (int level = 0; level < kRealtimeQualityCount; ++level) {
+            std::cout << "  " << realtimeQualityName(static_cast<RealtimeQuality>(level)) << ": "
+                      << stats.frames_per_quality[level] << " 帧\n";
+        }
+        return 0;
+    }
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+    try {
+        const std::string command = argv[1];
+        if (command == "pattern") {
+            return runPattern(argc, argv);
+        }
+        if (command == "workload") {
+            return runWorkload(argc, argv);
+        }
+        if (command == "tune") {
+            return runTune(argc, argv);
+        }
+        if (command == "realtime") {
+            return runRealtime(argc, argv);
+        }
+        printUsage();
+        return 1;
+    } catch (const std::exception &e) {
+        std::cerr << "错误: " << e.what() << std::endl;
+        return 1;
+    }
+}
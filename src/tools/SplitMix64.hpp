@@ -0,0 +1,41 @@
+//
+//  SplitMix64.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef SplitMix64_hpp
+#define SplitMix64_hpp
+
+#include <cstdint>
+
+namespace SoftRenderer {
+
+    /**
+     * 固定种子的伪随机数发生器。std::uniform_*_distribution 的输出随标准库实现而变，
+     * 生成器需要跨平台、跨编译器逐位可复现，所以自己实现整数到浮点的映射。
+     */
+    class SplitMix64 {
+    public:
+        explicit SplitMix64(uint64_t seed) : state_(seed) {}
+
+        uint64_t next() {
+            uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        // [0, 1) 内均匀分布，取高 24 位，float 可精确表示
+        float uniform() { return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f); }
+
+        float uniform(float lo, float hi) { return lo + (hi - lo) * uniform(); }
+
+    private:
+        uint64_t state_;
+    };
+
+} // namespace SoftRenderer
+
+#endif /* SplitMix64_hpp */
@@ -0,0 +1,248 @@
+//
+//  TestPattern.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <cmath>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include "TestPattern.hpp"
+#include "SplitMix64.hpp"
+
+namespace SoftRenderer {
+
+    namespace {
+
+        // Python 的 int() 对非负数向零截断，与 static_cast<int> 一致
+        int scaled(int i, int denominator) {
+            return static_cast<int>(static_cast<double>(i) / std::max(denominator, 1) * 255.0);
+        }
+
+        unsigned char clampByte(int value) {
+            return static_cast<unsigned char>(std::min(std::max(value, 0), 255));
+        }
+
+        // dst[x] = src[(x + shift) % count]，shift ∈ [0, count)
+        void copyRotated(unsigned char *dst, const unsigned char *src, int count, int shift) {
+            std::memcpy(dst, src + shift, static_cast<size_t>(count - shift));
+            std::memcpy(dst + (count - shift), src, static_cast<size_t>(shift));
+        }
+
+    } // namespace
+
+    bool parseTestPatternType(const std::string &name, TestPatternType &type) {
+        if (name == "gradient") {
+            type = TestPatternType::GRADIENT;
+        } else if (name == "bars") {
+            type = TestPatternType::COLOR_BARS;
+        } else if (name == "checker") {
+            type = TestPatternType::CHECKER;
+        } else if (name == "zoneplate") {
+            type = TestPatternType::ZONE_PLATE;
+        } else if (name == "noise") {
+            type = TestPatternType::NOISE;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    TestPatternGenerator::TestPatternGenerator(int width, int height, const TestPatternOptions &options,
+                                               ColorSpaceStandard standard)
+        : options_(options), base_(width, height, standard) {
+        if (options_.cell_size <= 0) {
+            throw std::invalid_argument("TestPatternGenerator: cell_size 必须为正");
+        }
+        switch (options_.type) {
+        case TestPatternType::GRADIENT:
+            fillGradient();
+            break;
+        case TestPatternType::COLOR_BARS:
+            fillColorBars(standard);
+            break;
+        case TestPatternType::CHECKER:
+            fillChecker();
+            break;
+        case TestPatternType::ZONE_PLATE:
+            fillZonePlate();
+            break;
+        case TestPatternType::NOISE:
+            fillNoise();
+            break;
+        }
+    }
+
+    void TestPatternGenerator::renderFrame(int frame_index, YUVFrameBuffer &frame) const {
+        const int width = base_.getWidth();
+        const int height = base_.getHeight();
+        if (frame.getWidth() != width || frame.getHeight() != height) {
+            throw std::invalid_argument("TestPatternGenerator::renderFrame: 帧尺寸不匹配");
+        }
+        // 平移量按偶数取整，亮度平移 shift、色度平移 shift / 2
+        long long offset = static_cast<long long>(frame_index) * (options_.scroll_per_frame & ~1);
+        int shift = static_cast<int>(((offset % width) + width) % width);
+        for (int y = 0; y < height; ++y) {
+            copyRotated(frame.getYRow(y), base_.getYRow(y), width, shift);
+        }
+        for (int cy = 0; cy < height / 2; ++cy) {
+            copyRotated(frame.getURow(cy), base_.getURow(cy), width / 2, shift / 2);
+            copyRotated(frame.getVRow(cy), base_.getVRow(cy), width / 2, shift / 2);
+        }
+    }
+
+    void TestPatternGenerator::fillGradient() {
+        const int width = base_.getWidth();
+        const int height = base_.getHeight();
+        const int cell = options_.cell_size;
+
+        // 逐项预先乘好权重，求和顺序与脚本一致：h * 0.3 + v * 0.3 + d * 0.2 + p * 0.2
+        std::vector<double> horizontal(width);
+        std::vector<int> cell_x(width);
+        for (int x = 0; x < width; ++x) {
+            horizontal[x] = scaled(x, width - 1) * 0.3;
+            cell_x[x] = x / cell;
+        }
+        std::vector<double> diagonal(width + height - 1);
+        for (int i = 0; i < width + height - 1; ++i) {
+            diagonal[i] = scaled(i, width + height - 2) * 0.2;
+        }
+        const double pattern[2] = {200 * 0.2, 50 * 0.2};
+
+        for (int y = 0; y < height; ++y) {
+            const double vertical = scaled(y, height - 1) * 0.3;
+            const double *diag = diagonal.data() + y;
+            const int cell_y = y / cell;
+            unsigned char *row = base_.getYRow(y);
+            for (int x = 0; x < width; ++x) {
+                int value = static_cast<int>(horizontal[x] + vertical + diag[x] + pattern[(cell_x[x] + cell_y) & 1]);
+                row[x] = clampByte(value);
+            }
+        }
+
+        // 色度：四个象限各有基准色，再叠加 30% 的水平（U）/ 垂直（V）渐变
+        const int chroma_width = width / 2;
+        const int chroma_height = height / 2;
+        std::vector<int> u_gradient(chroma_width);
+        for (int u = 0; u < chroma_width; ++u) {
+            u_gradient[u] = scaled(u, chroma_width - 1);
+        }
+        for (int v = 0; v < chroma_height; ++v) {
+            const bool top = v < chroma_height / 2;
+            const int v_gradient = scaled(v, chroma_height - 1);
+            unsigned char *u_row = base_.getURow(v);
+            unsigned char *v_row = base_.getVRow(v);
+            for (int u = 0; u < chroma_width; ++u) {
+                const bool left = u < chroma_width / 2;
+                const int u_val = top ? 128 : 200;
+                const int v_val = (top && !left) || (!top && left) ? 128 : 200;
+                u_row[u] = clampByte(static_cast<int>(u_val * 0.7 + u_gradient[u] * 0.3));
+                v_row[u] = clampByte(static_cast<int>(v_val * 0.7 + v_gradient * 0.3));
+            }
+        }
+    }
+
+    void TestPatternGenerator::fillColorBars(ColorSpaceStandard standard) {
+        const int width = base_.getWidth();
+        const int height = base_.getHeight();
+        const Color bars[8] = {
+            Color(191, 191, 191), Color(191, 191, 0), Color(0, 191, 191), Color(0, 191, 0),
+            Color(191, 0, 191),   Color(191, 0, 0),   Color(0, 0, 191),   Color(0, 0, 0),
+        };
+
+        // 先生成一行（色度按 2×2 块所在的彩条取值），其余行直接拷贝
+        unsigned char *y_row = base_.getYRow(0);
+        unsigned char *u_row = base_.getURow(0);
+        unsigned char *v_row = base_.getVRow(0);
+        for (int cx = 0; cx < width / 2; ++cx) {
+            const int bar = static_cast<int>(static_cast<long long>(2 * cx) * 8 / width);
+            unsigned char y, u, v;
+            rgbToYUV(bars[bar], y, u, v, standard);
+            y_row[2 * cx] = y_row[2 * cx + 1] = y;
+            u_row[cx] = u;
+            v_row[cx] = v;
+        }
+        for (int y = 1; y < height; ++y) {
+            std::memcpy(base_.getYRow(y), y_row, static_cast<size_t>(width));
+        }
+        for (int cy = 1; cy < height / 2; ++cy) {
+            std::memcpy(base_.getURow(cy), u_row, static_cast<size_t>(width / 2));
+            std::memcpy(base_.getVRow(cy), v_row, static_cast<size_t>(width / 2));
+        }
+    }
+
+    void TestPatternGenerator::fillChecker() {
+        const int width = base_.getWidth();
+        const int height = base_.getHeight();
+        const int cell = options_.cell_size;
+
+        // 只有两种行：偶数格行和奇数格行
+        std::vector<unsigned char> rows[2] = {std::vector<unsigned char>(width), std::vector<unsigned char>(width)};
+        for (int x = 0; x < width; ++x) {
+            const bool even = (x / cell) % 2 == 0;
+            rows[0][x] = even ? 235 : 16;
+            rows[1][x] = even ? 16 : 235;
+        }
+        for (int y = 0; y < height; ++y) {
+            std::memcpy(base_.getYRow(y), rows[(y / cell) & 1].data(), static_cast<size_t>(width));
+        }
+        std::fill(base_.getURow(0), base_.getURow(0) + base_.getUPlane().size(), 128);
+        std::fill(base_.getVRow(0), base_.getVRow(0) + base_.getVPlane().size(), 128);
+    }
+
+    void TestPatternGenerator::fillZonePlate() {
+        const int width = base_.getWidth();
+        const int height = base_.getHeight();
+
+        // 相位 = k · r²，瞬时频率 = k · r / π（周期/像素），在 r = max(w, h) / 2 处达到 0.5
+        constexpr double kTwoPi = 6.283185307179586;
+        const double radius = std::max(width, height) * 0.5;
+        const double k = kTwoPi / (4.0 * radius);
+
+        // 相位量化到 1024 级查余弦表，避免逐像素调用 cos
+        constexpr int kTableSize = 1024;
+        unsigned char cosine[kTableSize];
+        for (int i = 0; i < kTableSize; ++i) {
+            cosine[i] = clampByte(static_cast<int>(std::lround(128.0 + 127.0 * std::cos(kTwoPi * i / kTableSize))));
+        }
+        const double to_index = k * kTableSize / kTwoPi;
+
+        std::vector<double> dx2(width);
+        for (int x = 0; x < width; ++x) {
+            const double dx = x + 0.5 - width * 0.5;
+            dx2[x] = dx * dx;
+        }
+        for (int y = 0; y < height; ++y) {
+            const double dy = y + 0.5 - height * 0.5;
+            const double dy2 = dy * dy;
+            unsigned char *row = base_.getYRow(y);
+            for (int x = 0; x < width; ++x) {
+                const uint64_t index = static_cast<uint64_t>((dx2[x] + dy2) * to_index);
+                row[x] = cosine[index & (kTableSize - 1)];
+            }
+        }
+        std::fill(base_.getURow(0), base_.getURow(0) + base_.getUPlane().size(), 128);
+        std::fill(base_.getVRow(0), base_.getVRow(0) + base_.getVPlane().size(), 128);
+    }
+
+    void TestPatternGenerator::fillNoise() {
+        SplitMix64 rng(options_.seed);
+        // 每个 64 位随机数按小端顺序拆成 8 个字节，输出与平台字节序无关
+        auto fill = [&rng](unsigned char *data, size_t size) {
+            for (size_t i = 0; i < size; i += 8) {
+                const uint64_t bits = rng.next();
+                const size_t count = std::min<size_t>(8, size - i);
+                for (size_t j = 0; j < count; ++j) {
+                    data[i + j] = static_cast<unsigned char>(bits >> (8 * j));
+                }
+            }
+        };
+        fill(base_.getYRow(0), base_.getYPlane().size());
+        fill(base_.getURow(0), base_.getUPlane().size());
+        fill(base_.getVRow(0), base_.getVPlane().size());
+    }
+
+} // namespace SoftRenderer
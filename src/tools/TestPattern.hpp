@@ -0,0 +1,67 @@
+//
+//  TestPattern.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef TestPattern_hpp
+#define TestPattern_hpp
+
+#include <string>
+#include <cstdint>
+#include "core/YUVFrameBuffer.hpp"
+
+/**
+ * 原生测试图案生成：替代 assets/scripts/generate_test_yuv.py 的逐像素 Python 循环，
+ * 用于生成 4K/8K、多帧的压测输入。
+ *
+ * 图案只在构造时生成一次（按行、查表填充，内层循环可被编译器自动向量化），
+ * 之后每一帧只是把基准图案按行循环平移后拷贝出来（两段 memcpy），帧数再多也不会重复计算图案。
+ */
+namespace SoftRenderer {
+
+    enum class TestPatternType {
+        GRADIENT,    // 与 generate_test_yuv.py 相同（同尺寸下输出逐字节一致）
+        COLOR_BARS,  // 75% 八色彩条（白、黄、青、绿、品红、红、蓝、黑）
+        CHECKER,     // 黑白棋盘格，色度为中性
+        ZONE_PLATE,  // 圆形波带片：频率从中心向外线性增加，边缘接近奈奎斯特频率，用于观察缩放走样
+        NOISE,       // 均匀随机噪声（固定种子），纹理缓存/压缩最不友好的输入
+    };
+
+    // 名称（gradient / bars / checker / zoneplate / noise）→ 类型，未知名称返回 false
+    bool parseTestPatternType(const std::string &name, TestPatternType &type);
+
+    struct TestPatternOptions {
+        TestPatternType type = TestPatternType::GRADIENT;
+        int cell_size = 40;            // GRADIENT / CHECKER 的棋盘格边长（像素）
+        uint64_t seed = 1;             // NOISE 的随机种子
+        int scroll_per_frame = 0;      // 每帧向左平移的像素数（取偶数，保证色度随亮度整块移动）
+    };
+
+    class TestPatternGenerator {
+    public:
+        // 宽高必须为正偶数（否则抛出 std::invalid_argument）；standard 决定彩条的 RGB → YUV 转换
+        TestPatternGenerator(int width, int height, const TestPatternOptions &options = TestPatternOptions(),
+                             ColorSpaceStandard standard = ColorSpaceStandard::BT601);
+
+        // 把第 frame_index 帧写入 frame，frame 尺寸必须与生成器一致（否则抛出 std::invalid_argument）
+        void renderFrame(int frame_index, YUVFrameBuffer &frame) const;
+
+        int getWidth() const { return base_.getWidth(); }
+        int getHeight() const { return base_.getHeight(); }
+
+    private:
+        void fillGradient();
+        void fillColorBars(ColorSpaceStandard standard);
+        void fillChecker();
+        void fillZonePlate();
+        void fillNoise();
+
+        TestPatternOptions options_;
+        YUVFrameBuffer base_;   // 第 0 帧
+    };
+
+} // namespace SoftRenderer
+
+#endif /* TestPattern_hpp */
@@ -0,0 +1,159 @@
+//
+//  Workload.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include "Workload.hpp"
+#include "SplitMix64.hpp"
+
+namespace SoftRenderer {
+
+    namespace {
+
+        constexpr float kTwoPi = 6.2831853f;
+
+        // 以 (cx, cy) 为中心、半边长 (hx, hy)、旋转 angle 的矩形，两个三角形，UV 覆盖整张纹理
+        void appendQuad(std::vector<Vertex> &out, float cx, float cy, float hx, float hy, float angle) {
+            const float c = std::cos(angle);
+            const float s = std::sin(angle);
+            auto corner = [&](float sx, float sy, float u, float v) {
+                const float x = sx * hx;
+                const float y = sy * hy;
+                return Vertex(cx + x * c - y * s, cy + x * s + y * c, u, v);
+            };
+            const Vertex v00 = corner(-1, -1, 0, 0);
+            const Vertex v10 = corner(1, -1, 1, 0);
+            const Vertex v01 = corner(-1, 1, 0, 1);
+            const Vertex v11 = corner(1, 1, 1, 1);
+            out.push_back(v00);
+            out.push_back(v10);
+            out.push_back(v01);
+            out.push_back(v10);
+            out.push_back(v11);
+            out.push_back(v01);
+        }
+
+        void appendSprite(std::vector<Vertex> &out, SplitMix64 &rng, const WorkloadOptions &options) {
+            const float hx = 0.5f * options.sprite_size * rng.uniform(0.5f, 1.5f);
+            const float hy = 0.5f * options.sprite_size * rng.uniform(0.5f, 1.5f);
+            const float cx = rng.uniform(0.0f, static_cast<float>(options.width));
+            const float cy = rng.uniform(0.0f, static_cast<float>(options.height));
+            appendQuad(out, cx, cy, hx, hy, 0.0f);
+        }
+
+        void appendRotatedQuad(std::vector<Vertex> &out, SplitMix64 &rng, const WorkloadOptions &options) {
+            const float w = static_cast<float>(options.width);
+            const float h = static_cast<float>(options.height);
+            const float extent = 0.5f * std::max(w, h);
+            const float cx = w * rng.uniform(0.25f, 0.75f);
+            const float cy = h * rng.uniform(0.25f, 0.75f);
+            const float hx = extent * rng.uniform(0.5f, 1.5f);
+            const float hy = extent * rng.uniform(0.5f, 1.5f);
+            appendQuad(out, cx, cy, hx, hy, rng.uniform(0.0f, kTwoPi));
+        }
+
+        void appendSliver(std::vector<Vertex> &out, SplitMix64 &rng, const WorkloadOptions &options) {
+            const float w = static_cast<float>(options.width);
+            const float h = static_cast<float>(options.height);
+            const float diagonal = std::sqrt(w * w + h * h);
+            const float x = rng.uniform(0.0f, w);
+            const float y = rng.uniform(0.0f, h);
+            const float angle = rng.uniform(0.0f, kTwoPi);
+            const float length = diagonal * rng.uniform(0.25f, 1.0f);
+            const float thickness = rng.uniform(0.1f, 1.0f);
+            const float dx = std::cos(angle);
+            const float dy = std::sin(angle);
+            const float ex = x + dx * length;
+            const float ey = y + dy * length;
+            out.emplace_back(x, y, rng.uniform(), rng.uniform());
+            out.emplace_back(ex, ey, rng.uniform(), rng.uniform());
+            out.emplace_back(ex - dy * thickness, ey + dx * thickness, rng.uniform(), rng.uniform());
+        }
+
+    } // namespace
+
+    bool parseWorkloadType(const std::string &name, WorkloadType &type) {
+        if (name == "sprites") {
+            type = WorkloadType::SMALL_SPRITES;
+        } else if (name == "quads") {
+            type = WorkloadType::ROTATED_QUADS;
+        } else if (name == "slivers") {
+            type = WorkloadType::SLIVERS;
+        } else if (name == "mixed") {
+            type = WorkloadType::MIXED;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<Vertex> generateWorkload(const WorkloadOptions &options) {
+        if (options.width <= 0 || options.height <= 0 || options.sprite_size <= 0.0f) {
+            throw std::invalid_argument("generateWorkload: 尺寸必须为正");
+        }
+        SplitMix64 rng(options.seed);
+        std::vector<Vertex> vertices;
+        vertices.reserve(options.count * (options.type == WorkloadType::SLIVERS ? 3 : 6));
+
+        for (size_t i = 0; i < options.count; ++i) {
+            WorkloadType type = options.type;
+            if (type == WorkloadType::MIXED) {
+                type = static_cast<WorkloadType>(i % 3);
+            }
+            switch (type) {
+            case WorkloadType::SMALL_SPRITES:
+                appendSprite(vertices, rng, options);
+                break;
+            case WorkloadType::ROTATED_QUADS:
+                appendRotatedQuad(vertices, rng, options);
+                break;
+            case WorkloadType::SLIVERS:
+            case WorkloadType::MIXED:
+                appendSliver(vertices, rng, options);
+                break;
+            }
+        }
+        return vertices;
+    }
+
+    bool saveWorkload(const std::string &filename, const std::vector<Vertex> &vertices) {
+        std::unique_ptr<FILE, int (*)(FILE *)> file(std::fopen(filename.c_str(), "w"), &std::fclose);
+        if (!file || vertices.size() % 3 != 0) {
+            return false;
+        }
+        std::fprintf(file.get(), "# SoftRenderer workload v1\ntriangles %zu\n", vertices.size() / 3);
+        for (const Vertex &v : vertices) {
+            std::fprintf(file.get(), "%.9g %.9g %.9g %.9g\n", v.x, v.y, v.u, v.v);
+        }
+        return std::fflush(file.get()) == 0 && !std::ferror(file.get());
+    }
+
+    std::vector<Vertex> loadWorkload(const std::string &filename) {
+        std::unique_ptr<FILE, int (*)(FILE *)> file(std::fopen(filename.c_str(), "r"), &std::fclose);
+        if (!file) {
+            throw std::runtime_error("无法打开负载文件: " + filename);
+        }
+        char header[64] = {};
+        size_t triangles = 0;
+        if (!std::fgets(header, sizeof(header), file.get()) ||
+            std::string(header) != "# SoftRenderer workload v1\n" ||
+            std::fscanf(file.get(), " triangles %zu", &triangles) != 1) {
+            throw std::runtime_error("负载文件格式错误: " + filename);
+        }
+        std::vector<Vertex> vertices(triangles * 3);
+        for (Vertex &v : vertices) {
+            if (std::fscanf(file.get(), "%f %f %f %f", &v.x, &v.y, &v.u, &v.v) != 4) {
+                throw std::runtime_error("负载文件顶点数据不完整: " + filename);
+            }
+        }
+        return vertices;
+    }
+
+} // namespace SoftRenderer
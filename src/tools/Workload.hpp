@@ -0,0 +1,55 @@
+//
+//  Workload.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef Workload_hpp
+#define Workload_hpp
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "geometry/Vertex.hpp"
+
+/**
+ * 合成三角形负载：按固定种子生成压测用的三角形列表（每 3 个顶点一个三角形，UV 在 [0, 1] 内）。
+ * 相同的参数生成相同的顶点（随机序列与平台无关，旋转角的 sin/cos 取决于数学库），基准测试结果可以直接对比。
+ */
+namespace SoftRenderer {
+
+    enum class WorkloadType {
+        SMALL_SPRITES,   // 大量轴对齐小矩形（每个 2 个三角形），考验三角形建立开销
+        ROTATED_QUADS,   // 少量覆盖大半屏幕的旋转矩形（每个 2 个三角形），考验填充率
+        SLIVERS,         // 细长三角形（宽度 0.1 ~ 1 像素），考验包围盒剔除和边缘函数精度
+        MIXED,           // 以上三类轮流生成
+    };
+
+    // 名称（sprites / quads / slivers / mixed）→ 类型，未知名称返回 false
+    bool parseWorkloadType(const std::string &name, WorkloadType &type);
+
+    struct WorkloadOptions {
+        WorkloadType type = WorkloadType::SMALL_SPRITES;
+        size_t count = 1000;        // 图元数：精灵 / 矩形按个数计，细长三角形按三角形计
+        int width = 1920;           // 目标帧缓冲尺寸，决定坐标范围
+        int height = 1080;
+        uint64_t seed = 1;
+        float sprite_size = 16.0f;  // 精灵的平均边长（像素），实际边长在 0.5 ~ 1.5 倍之间
+    };
+
+    std::vector<Vertex> generateWorkload(const WorkloadOptions &options);
+
+    /**
+     * 文本格式保存/读取（便于检查和在不同程序间共享）：
+     *   # SoftRenderer workload v1
+     *   triangles <N>
+     *   x y u v      ← 3N 行
+     * 浮点数以 %.9g 写出，读回后逐位相同。保存失败返回 false，读取失败抛出 std::runtime_error。
+     */
+    bool saveWorkload(const std::string &filename, const std::vector<Vertex> &vertices);
+    std::vector<Vertex> loadWorkload(const std::string &filename);
+
+} // namespace SoftRenderer
+
+#endif /* Workload_hpp */
@@ -0,0 +1,360 @@
+//
+//  AutoTuner.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <cmath>
+#include <chrono>
+#include <limits>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include "AutoTuner.hpp"
+#include "tools/TestPattern.hpp"
+
+namespace SoftRenderer {
+
+    namespace {
+        const char *const kProfileHeader = "# SoftRenderer tuning profile v2";
+        const char *const kProfileHeaderV1 = "# SoftRenderer tuning profile v1"; // 没有 worker_count 列
+
+        constexpr int kShearCandidates[] = {0, 1};
+        constexpr int kRGBCacheCandidates[] = {0, 32, 64, 128};
+        constexpr int kBandCandidates[] = {64, 128, 256, 512};
+        constexpr int kDeferredCandidates[] = {16, 32, 64};
+
+        // 明显更慢（超过当前最优的 1.5 倍）的候选值只测一次，缩短校准时间
+        constexpr double kEarlyOutRatio = 1.5;
+
+        // 先预热一次，再取至多 repetitions 次中最快的一次（毫秒）
+        template <typename Body>
+        double measure(int repetitions, double best_so_far, Body &&body) {
+            body();
+            double best = std::numeric_limits<double>::max();
+            for (int i = 0; i < repetitions; ++i) {
+                auto start = std::chrono::steady_clock::now();
+                body();
+                best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+                if (best > kEarlyOutRatio * best_so_far) {
+                    break;
+                }
+            }
+            return best;
+        }
+
+        // 测量所有候选值（数组或 std::vector<int>），返回最快的一个
+        template <typename Candidates, typename Body>
+        int pickFastest(const char *parameter, const Candidates &candidates, int repetitions,
+                        std::vector<TuningMeasurement> &measurements, Body &&body) {
+            int best_candidate = *std::begin(candidates);
+            double best_time = std::numeric_limits<double>::max();
+            for (int candidate : candidates) {
+                const double time = measure(repetitions, best_time, [&] { body(candidate); });
+                measurements.push_back({parameter, candidate, time});
+                if (time < best_time) {
+                    best_time = time;
+                    best_candidate = candidate;
+                }
+            }
+            return best_candidate;
+        }
+    }
+
+    void TuningConfig::applyToStaticTexture(YUVTexture &texture) const {
+        if (rgb_cache_tile > 0) {
+            texture.enableRGBCache(rgb_cache_tile);
+        } else {
+            texture.releaseRGBCache();
+        }
+    }
+
+    TuningConfig AutoTuner::loadAndApply(const std::string &profile_path, int fb_width, int fb_height,
+                                         int texture_width, int texture_height, Rasterizer &rasterizer) {
+        std::unique_ptr<AutoTuner> tuner;
+        try {
+            tuner = std::make_unique<AutoTuner>(profile_path);
+        } catch (const std::invalid_argument &) {
+            // 配置值越界：不信任这份文件，回退到默认配置
+            const TuningConfig defaults;
+            defaults.apply(rasterizer);
+            return defaults;
+        }
+        const TuningConfig config = tuner->getConfig(fb_width, fb_height, texture_width, texture_height);
+        config.apply(rasterizer);
+        return config;
+    }
+
+    TunedRenderers::TunedRenderers(const std::string &profile_path, int fb_width, int fb_height,
+                                   int texture_width, int texture_height, Rasterizer &rasterizer)
+        : TunedRenderers(AutoTuner::loadAndApply(profile_path, fb_width, fb_height, texture_width, texture_height, rasterizer),
+                         fb_width, fb_height, rasterizer) {}
+
+    TunedRenderers::TunedRenderers(const TuningConfig &config, int fb_width, int fb_height, Rasterizer &rasterizer)
+        : rasterizer_(rasterizer),
+          config_(config),
+          bands_(fb_width, fb_height, config_.band_height),
+          deferred_(config_.deferred_tile_size) {
+        config_.apply(rasterizer_);
+    }
+
+    ParallelRenderer &TunedRenderers::getParallelRenderer() {
+        if (!parallel_) {
+            pool_ = std::make_unique<WorkerPool>(config_.workerTopology());
+            parallel_ = std::make_unique<ParallelRenderer>(*pool_);
+        }
+        return *parallel_;
+    }
+
+    AutoTuner::AutoTuner(std::string profile_path) : profile_path_(std::move(profile_path)) {
+        if (!profile_path_.empty()) {
+            load();
+        }
+    }
+
+    int AutoTuner::sizeClass(int width, int height) {
+        return static_cast<int>(std::lround(std::log2(std::max(1.0, static_cast<double>(width) * height))));
+    }
+
+    AutoTuner::Key AutoTuner::makeKey(int fb_width, int fb_height, int texture_width, int texture_height) {
+        return Key(sizeClass(fb_width, fb_height), sizeClass(texture_width, texture_height));
+    }
+
+    bool AutoTuner::hasConfig(int fb_width, int fb_height, int texture_width, int texture_height) const {
+        return entries_.count(makeKey(fb_width, fb_height, texture_width, texture_height)) != 0;
+    }
+
+    const TuningConfig &AutoTuner::getConfig(int fb_width, int fb_height, int texture_width, int texture_height) {
+        auto found = entries_.find(makeKey(fb_width, fb_height, texture_width, texture_height));
+        if (found != entries_.end()) {
+            return found->second.config;
+        }
+        return calibrate(fb_width, fb_height, texture_width, texture_height);
+    }
+
+    const TuningConfig &AutoTuner::calibrate(int fb_width, int fb_height, int texture_width, int texture_height) {
+        if (fb_width <= 0 || fb_height <= 0 || texture_width <= 0 || texture_height <= 0) {
+            throw std::invalid_argument("AutoTuner: 尺寸必须为正");
+        }
+        Entry &entry = entries_[makeKey(fb_width, fb_height, texture_width, texture_height)];
+        entry = runCalibration(fb_width, fb_height, texture_width, texture_height);
+        save();
+        return entry.config;
+    }
+
+    void AutoTuner::setRepetitions(int repetitions) {
+        if (repetitions <= 0) {
+            throw std::invalid_argument("AutoTuner: 测量次数必须为正");
+        }
+        repetitions_ = repetitions;
+    }
+
+    AutoTuner::Entry AutoTuner::runCalibration(int fb_width, int fb_height, int texture_width, int texture_height) const {
+        Entry entry;
+        entry.fb_width = fb_width;
+        entry.fb_height = fb_height;
+        entry.texture_width = texture_width;
+        entry.texture_height = texture_height;
+
+        // 校准纹理：测试图案（YUV420 要求偶数宽高）
+        const int tex_w = (texture_width + 1) & ~1;
+        const int tex_h = (texture_height + 1) & ~1;
+        TestPatternOptions options;
+        options.type = TestPatternType::ZONE_PLATE;
+        YUVFrameBuffer pattern(tex_w, tex_h);
+        TestPatternGenerator(tex_w, tex_h, options).renderFrame(0, pattern);
+        YUVTexture texture(tex_w, tex_h, pattern.getYPlane(), pattern.getUPlane(), pattern.getVPlane());
+        texture.setFilterMode(TextureFilter::BILINEAR);
+
+        // 校准场景：整张纹理旋转 15° 铺满帧缓冲，v0 → v1 → v2 → v3 沿边界排列
+        const float cx = fb_width * 0.5f, cy = fb_height * 0.5f;
+        const float angle = 15.0f * 3.14159265f / 180.0f;
+        const float cos_a = std::cos(angle), sin_a = std::sin(angle);
+        auto corner = [&](float x, float y, float u, float v) {
+            const float dx = x - cx, dy = y - cy;
+            return Vertex(cx + cos_a * dx - sin_a * dy, cy + sin_a * dx + cos_a * dy, u, v);
+        };
+        const Vertex v0 = corner(0.0f, 0.0f, 0.0f, 0.0f);
+        const Vertex v1 = corner(static_cast<float>(fb_width), 0.0f, 1.0f, 0.0f);
+        const Vertex v2 = corner(static_cast<float>(fb_width), static_cast<float>(fb_height), 1.0f, 1.0f);
+        const Vertex v3 = corner(0.0f, static_cast<float>(fb_height), 0.0f, 1.0f);
+
+        FrameBuffer fb(fb_width, fb_height);
+        Rasterizer rasterizer;
+        auto drawFrame = [&] {
+            fb.clear();
+            rasterizer.drawTexturedQuad(fb, v0, v1, v2, v3, texture);
+        };
+
+        TuningConfig &config = entry.config;
+        std::vector<TuningMeasurement> &measurements = entry.measurements;
+
+        // 1. 整图四边形的绘制路径
+        config.shear_path = pickFastest("shear_path", kShearCandidates, repetitions_, measurements, [&](int shear) {
+            rasterizer.setShearPathEnabled(shear != 0);
+            drawFrame();
+        }) != 0;
+        config.apply(rasterizer);
+
+        // 2. 静态纹理的布局（预热后缓存已填满，测的是稳定状态的每帧耗时）
+        int cached_tile = 0;
+        config.rgb_cache_tile = pickFastest("rgb_cache_tile", kRGBCacheCandidates, repetitions_, measurements, [&](int tile) {
+            if (tile != cached_tile) {
+                TuningConfig layout;
+                layout.rgb_cache_tile = tile;
+                layout.applyToStaticTexture(texture);
+                cached_tile = tile;
+            }
+            drawFrame();
+        });
+        texture.releaseRGBCache();
+
+        // 3. 条带高度（条带渲染按三角形绘制，结果交给空回调）
+        config.band_height = pickFastest("band_height", kBandCandidates, repetitions_, measurements, [&](int band_height) {
+            BandRenderer bands(fb_width, fb_height, band_height);
+            bands.drawTexturedTriangle(v0, v1, v2, texture);
+            bands.drawTexturedTriangle(v0, v2, v3, texture);
+            bands.render([](const FrameBuffer &, int, int) { return true; });
+        });
+
+        // 4. 延迟着色的分块边长
+        config.deferred_tile_size = pickFastest("deferred_tile_size", kDeferredCandidates, repetitions_, measurements, [&](int tile_size) {
+            DeferredRenderer deferred(tile_size);
+            deferred.beginFrame(fb_width, fb_height);
+            deferred.drawTexturedTriangle(v0, v1, v2, texture);
+            deferred.drawTexturedTriangle(v0, v2, v3, texture);
+            fb.clear();
+            deferred.resolve(fb);
+        });
+
+        // 5. 工作线程数：每个候选值建一次线程池（线程创建不计入测量），整帧按三角形并行绘制
+        const NumaTopology topology = NumaTopology::detect();
+        std::vector<int> worker_candidates;
+        for (int count = 1; count < topology.getCpuCount(); count *= 2) {
+            worker_candidates.push_back(count);
+        }
+        worker_candidates.push_back(topology.getCpuCount());
+        std::unique_ptr<WorkerPool> pool;
+        std::unique_ptr<ParallelRenderer> parallel;
+        int pool_workers = 0;
+        config.worker_count = pickFastest("worker_count", worker_candidates, repetitions_, measurements, [&](int workers) {
+            if (workers != pool_workers) {
+                parallel.reset();
+                pool = std::make_unique<WorkerPool>(topology.limit(workers));
+                parallel = std::make_unique<ParallelRenderer>(*pool);
+                parallel->drawTexturedTriangle(v0, v1, v2, texture);
+                parallel->drawTexturedTriangle(v0, v2, v3, texture);
+                pool_workers = workers;
+            }
+            parallel->render(fb);
+        });
+        return entry;
+    }
+
+    void AutoTuner::validate(const TuningConfig &config) const {
+        auto check = [this](bool valid, const char *key, int value) {
+            if (!valid) {
+                throw std::invalid_argument("调优配置文件 " + profile_path_ + " 中 " + key + " 无效: " + std::to_string(value));
+            }
+        };
+        check(config.rgb_cache_tile >= 0, "rgb_cache_tile", config.rgb_cache_tile);
+        check(config.band_height > 0, "band_height", config.band_height);
+        check(config.deferred_tile_size > 0, "deferred_tile_size", config.deferred_tile_size);
+        check(config.worker_count >= 0, "worker_count", config.worker_count);
+    }
+
+    void AutoTuner::load() {
+        std::ifstream file(profile_path_);
+        if (!file) {
+            return; // 还没有配置文件，第一次运行
+        }
+        std::string line;
+        if (!std::getline(file, line) || (line != kProfileHeader && line != kProfileHeaderV1)) {
+            throw std::runtime_error("调优配置文件格式错误: " + profile_path_);
+        }
+        const bool has_worker_count = line == kProfileHeader;
+        Entry *current = nullptr;
+        while (std::getline(file, line)) {
+            std::istringstream fields(line);
+            std::string kind;
+            if (!(fields >> kind)) {
+                continue;
+            }
+            if (kind == "entry") {
+                Entry entry;
+                int shear = 0;
+                if (!(fields >> entry.fb_width >> entry.fb_height >> entry.texture_width >> entry.texture_height >> shear >>
+                      entry.config.rgb_cache_tile >> entry.config.band_height >> entry.config.deferred_tile_size) ||
+                    (has_worker_count && !(fields >> entry.config.worker_count))) {
+                    throw std::runtime_error("调优配置文件格式错误: " + profile_path_);
+                }
+                entry.config.shear_path = shear != 0;
+                validate(entry.config);
+                current = &(entries_[makeKey(entry.fb_width, entry.fb_height, entry.texture_width, entry.texture_height)] = entry);
+            } else if (kind == "measure" && current) {
+                TuningMeasurement measurement;
+                if (!(fields >> measurement.parameter >> measurement.candidate >> measurement.milliseconds)) {
+                    throw std::runtime_error("调优配置文件格式错误: " + profile_path_);
+                }
+                current->measurements.push_back(measurement);
+            } else {
+                throw std::runtime_error("调优配置文件格式错误: " + profile_path_);
+            }
+        }
+    }
+
+    void AutoTuner::save() const {
+        if (profile_path_.empty()) {
+            return;
+        }
+        std::ofstream file(profile_path_, std::ios::trunc);
+        file << kProfileHeader << "\n";
+        for (const auto &item : entries_) {
+            const Entry &entry = item.second;
+            const TuningConfig &config = entry.config;
+            file << "entry " << entry.fb_width << " " << entry.fb_height << " " << entry.texture_width << " "
+                 << entry.texture_height << " " << (config.shear_path ? 1 : 0) << " " << config.rgb_cache_tile << " "
+                 << config.band_height << " " << config.deferred_tile_size << " " << config.worker_count << "\n";
+            for (const TuningMeasurement &measurement : entry.measurements) {
+                file << "measure " << measurement.parameter << " " << measurement.candidate << " "
+                     << measurement.milliseconds << "\n";
+            }
+        }
+        if (!file.flush()) {
+            throw std::runtime_error("无法写入调优配置文件: " + profile_path_);
+        }
+    }
+
+    std::string AutoTuner::getReport() const {
+        std::ostringstream report;
+        report.setf(std::ios::fixed);
+        report.precision(2);
+        for (const auto &item : entries_) {
+            const Entry &entry = item.second;
+            const TuningConfig &config = entry.config;
+            report << "帧缓冲 " << entry.fb_width << "x" << entry.fb_height << "（等级 " << item.first.first << "），纹理 "
+                   << entry.texture_width << "x" << entry.texture_height << "（等级 " << item.first.second << "）\n";
+            auto chosen = [&](const std::string &parameter) {
+                if (parameter == "shear_path") return config.shear_path ? 1 : 0;
+                if (parameter == "rgb_cache_tile") return config.rgb_cache_tile;
+                if (parameter == "band_height") return config.band_height;
+                if (parameter == "worker_count") return config.worker_count;
+                return config.deferred_tile_size;
+            };
+            std::string parameter;
+            for (const TuningMeasurement &measurement : entry.measurements) {
+                if (measurement.parameter != parameter) {
+                    parameter = measurement.parameter;
+                    report << "  " << parameter << " = " << chosen(parameter) << "\n";
+                }
+                report << "      " << measurement.candidate << ": " << measurement.milliseconds << " ms"
+                       << (measurement.candidate == chosen(parameter) ? "  ←" : "") << "\n";
+            }
+        }
+        return report.str();
+    }
+
+} // namespace SoftRenderer
@@ -0,0 +1,162 @@
+//
+//  AutoTuner.hpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#ifndef AutoTuner_hpp
+#define AutoTuner_hpp
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include "rasterization/Rasterizer.hpp"
+#include "rasterization/BandRenderer.hpp"
+#include "rasterization/DeferredRenderer.hpp"
+#include "parallel/ParallelRenderer.hpp"
+
+/**
+ * 启动时自动调优：最优的分块大小、绘制路径和纹理布局取决于宿主 CPU（缓存大小、向量宽度）
+ * 以及帧缓冲 / 纹理的尺寸。AutoTuner 用真实管线做几次短的校准渲染，为每个尺寸等级选出最快的配置，
+ * 并保存到本地配置文件，之后的运行直接读取，不再校准。
+ *
+ * 校准场景：测试图案纹理旋转 15° 后铺满帧缓冲（与整图变换的典型负载一致），每个候选值先预热一次，
+ * 再取 getRepetitions() 次中最快的一次（明显更慢的候选值只测一次）。依次决定：
+ *   1. 整图四边形的绘制路径：三趟剪切 / 两个三角形
+ *   2. 静态纹理的布局：不缓存 / RGB 缓存（块边长 32、64、128），缓存已预热（纹理内容不变的场景）
+ *   3. BandRenderer 的条带高度：64、128、256、512
+ *   4. DeferredRenderer 的分块边长：16、32、64
+ *   5. ParallelRenderer 的工作线程数：1、2、4 …… 直到本机拓扑的全部 CPU
+ *      （帧缓冲小、三角形少时线程同步的开销可能超过并行的收益）
+ *
+ * 启动时用 AutoTuner::loadAndApply 一步完成加载与应用，或用 TunedRenderers 同时按配置构造各渲染器。
+ */
+namespace SoftRenderer {
+
+    struct TuningConfig {
+        bool shear_path = true;       // 整图四边形是否使用三趟剪切路径
+        int rgb_cache_tile = 0;       // 静态纹理的 RGB 缓存块边长，0 表示不开启
+        int band_height = 256;        // BandRenderer 的条带高度
+        int deferred_tile_size = 32;  // DeferredRenderer 的分块边长
+        int worker_count = 0;         // ParallelRenderer 的工作线程数，0 表示拓扑中的全部 CPU
+
+        void apply(Rasterizer &rasterizer) const { rasterizer.setShearPathEnabled(shear_path); }
+
+        // 对内容不变、会被反复绘制的纹理按配置开启 RGB 缓存
+        void applyToStaticTexture(YUVTexture &texture) const;
+
+        // WorkerPool 使用的拓扑：topology 中只保留 worker_count 个 CPU
+        NumaTopology workerTopology(const NumaTopology &topology = NumaTopology::detect()) const {
+            return topology.limit(worker_count);
+        }
+    };
+
+    // 一次候选值的测量结果
+    struct TuningMeasurement {
+        std::string parameter;  // shear_path / rgb_cache_tile / band_height / deferred_tile_size / worker_count
+        int candidate = 0;
+        double milliseconds = 0.0;
+    };
+
+    class AutoTuner {
+    public:
+        /**
+         * @param profile_path 配置文件路径，文件存在时立即加载（格式错误抛出 std::runtime_error，
+         *                     配置值越界时抛出 std::invalid_argument，消息中指出字段名）；为空时只在内存中保存结果
+         */
+        explicit AutoTuner(std::string profile_path = std::string());
+
+        /**
+         * 启动时的加载与应用：读取 profile_path 中该尺寸等级的配置（没有记录时先校准并写入文件），
+         * 把绘制路径设置到 rasterizer，返回配置供构造其他渲染器、开启静态纹理的 RGB 缓存。
+         * 配置文件中有越界的配置值（例如手工编辑出的 band_height 0）时不使用该文件，改用默认配置（也不校准、不写入）。
+         * 配置文件格式错误或写入失败时抛出 std::runtime_error。
+         */
+        static TuningConfig loadAndApply(const std::string &profile_path, int fb_width, int fb_height,
+                                         int texture_width, int texture_height, Rasterizer &rasterizer);
+
+        // 尺寸等级：像素数的 log2 四舍五入（1280×720 → 20，1920×1080 → 21，3840×2160 → 23）
+        static int sizeClass(int width, int height);
+
+        // 返回该尺寸等级的配置；没有记录时先校准并保存到配置文件
+        const TuningConfig &getConfig(int fb_width, int fb_height, int texture_width, int texture_height);
+
+        // 无论是否已有记录都重新校准（按需调优），并保存到配置文件
+        const TuningConfig &calibrate(int fb_width, int fb_height, int texture_width, int texture_height);
+
+        bool hasConfig(int fb_width, int fb_height, int texture_width, int texture_height) const;
+
+        // 每个候选值的测量次数（取最快的一次），默认 2
+        void setRepetitions(int repetitions);
+        int getRepetitions() const { return repetitions_; }
+
+        // 写出所有尺寸等级的配置和测量数据；没有配置文件路径时不做任何事，写入失败抛出 std::runtime_error
+        void save() const;
+
+        // 可读的报告：每个尺寸等级选中的配置和每个候选值的耗时
+        std::string getReport() const;
+
+    private:
+        struct Entry {
+            int fb_width = 0, fb_height = 0;            // 校准时实际使用的尺寸
+            int texture_width = 0, texture_height = 0;
+            TuningConfig config;
+            std::vector<TuningMeasurement> measurements;
+        };
+        using Key = std::pair<int, int>; // (帧缓冲尺寸等级, 纹理尺寸等级)
+
+        static Key makeKey(int fb_width, int fb_height, int texture_width, int texture_height);
+
+        void load();
+        // 加载的配置值越界时抛出 std::invalid_argument（rgb_cache_tile、worker_count 可以为 0，其余必须为正）
+        void validate(const TuningConfig &config) const;
+        Entry runCalibration(int fb_width, int fb_height, int texture_width, int texture_height) const;
+
+        std::string profile_path_;
+        int repetitions_ = 2;
+        std::map<Key, Entry> entries_;
+    };
+
+    /**
+     * 按调优配置构造的一组渲染器，程序启动时建立一次：
+     *   - rasterizer 经 loadAndApply 设置绘制路径；
+     *   - BandRenderer 使用调优的条带高度，DeferredRenderer 使用调优的分块边长；
+     *   - ParallelRenderer 的 WorkerPool 只包含调优的工作线程数，在第一次 getParallelRenderer 时创建线程。
+     * rasterizer 需存活到 TunedRenderers 析构。
+     */
+    class TunedRenderers {
+    public:
+        TunedRenderers(const std::string &profile_path, int fb_width, int fb_height,
+                       int texture_width, int texture_height, Rasterizer &rasterizer);
+
+        // 直接使用给定的配置（不读写配置文件，也不校准），例如没有指定配置文件时的默认配置
+        TunedRenderers(const TuningConfig &config, int fb_width, int fb_height, Rasterizer &rasterizer);
+
+        TunedRenderers(const TunedRenderers &) = delete;
+        TunedRenderers &operator=(const TunedRenderers &) = delete;
+
+        const TuningConfig &getConfig() const { return config_; }
+        Rasterizer &getRasterizer() { return rasterizer_; }
+
+        // 对内容不变、会被反复绘制的纹理按配置开启 RGB 缓存
+        void prepareStaticTexture(YUVTexture &texture) const { config_.applyToStaticTexture(texture); }
+
+        BandRenderer &getBandRenderer() { return bands_; }
+        DeferredRenderer &getDeferredRenderer() { return deferred_; }
+        ParallelRenderer &getParallelRenderer();
+
+    private:
+        Rasterizer &rasterizer_;
+        TuningConfig config_;
+        BandRenderer bands_;
+        DeferredRenderer deferred_;
+        std::unique_ptr<WorkerPool> pool_;
+        std::unique_ptr<ParallelRenderer> parallel_;
+    };
+
+} // namespace SoftRenderer
+
+#endif /* AutoTuner_hpp */
@@ -0,0 +1,166 @@
+//
+//  ParallelRendererTest.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <cmath>
+#include <mutex>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include "core/YUVFrameBuffer.hpp"
+#include "tools/TestPattern.hpp"
+#include "parallel/ParallelRenderer.hpp"
+
+/**
+ * 模拟多节点拓扑（2 个节点 × 3 个 CPU）上的 ParallelRenderer：
+ *   1. 工作线程按拓扑顺序分到各节点，禁止窃取时每个任务都在其归属节点的线程上执行；
+ *   2. 条带并行渲染（普通帧缓冲的多种条带高度、按节点放置的帧缓冲）与单线程 Rasterizer 的结果逐字节一致。
+ */
+namespace {
+
+    int failures = 0;
+
+    void check(bool condition, const char *what) {
+        if (!condition) {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            ++failures;
+        }
+    }
+
+    size_t countDifferences(const SoftRenderer::FrameBuffer &a, const SoftRenderer::FrameBuffer &b) {
+        size_t differences = 0;
+        for (int y = 0; y < a.getHeight(); ++y) {
+            const Color *row_a = a.getRow(y);
+            const Color *row_b = b.getRow(y);
+            for (int x = 0; x < a.getWidth(); ++x) {
+                if (row_a[x].r != row_b[x].r || row_a[x].g != row_b[x].g || row_a[x].b != row_b[x].b) {
+                    ++differences;
+                }
+            }
+        }
+        return differences;
+    }
+
+    SoftRenderer::YUVTexture makeTexture(SoftRenderer::TestPatternType type, SoftRenderer::TextureFilter filter) {
+        SoftRenderer::TestPatternOptions options;
+        options.type = type;
+        SoftRenderer::YUVFrameBuffer pattern(160, 120);
+        SoftRenderer::TestPatternGenerator(160, 120, options).renderFrame(0, pattern);
+        SoftRenderer::YUVTexture texture(160, 120, pattern.getYPlane(), pattern.getUPlane(), pattern.getVPlane());
+        texture.setFilterMode(filter);
+        return texture;
+    }
+
+    // 绕 (cx, cy) 旋转 angle 的整图四边形，拆成两个三角形
+    void quadTriangles(float cx, float cy, float half_w, float half_h, float angle,
+                       std::vector<Vertex> &out) {
+        const float c = std::cos(angle), s = std::sin(angle);
+        auto corner = [&](float dx, float dy, float u, float v) {
+            return Vertex(cx + dx * c - dy * s, cy + dx * s + dy * c, u, v);
+        };
+        const Vertex v0 = corner(-half_w, -half_h, 0.0f, 0.0f);
+        const Vertex v1 = corner(half_w, -half_h, 1.0f, 0.0f);
+        const Vertex v2 = corner(half_w, half_h, 1.0f, 1.0f);
+        const Vertex v3 = corner(-half_w, half_h, 0.0f, 1.0f);
+        out.insert(out.end(), {v0, v1, v2, v0, v2, v3});
+    }
+
+    void testWorkerAssignment(SoftRenderer::WorkerPool &pool) {
+        check(pool.getWorkerCount() == 6, "模拟拓扑应有 6 个工作线程");
+        check(pool.getNodeCount() == 2, "模拟拓扑应有 2 个节点");
+        for (int worker = 0; worker < pool.getWorkerCount(); ++worker) {
+            check(pool.getWorkerNode(worker) == worker / 3, "工作线程按拓扑顺序分到节点（每节点 3 个）");
+        }
+
+        // 每个工作线程恰好执行一次 runOnEachWorker
+        std::vector<int> visits(pool.getWorkerCount(), 0);
+        std::mutex mutex;
+        pool.runOnEachWorker([&](int worker) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++visits[worker];
+        });
+        for (int count : visits) {
+            check(count == 1, "runOnEachWorker 在每个工作线程上各执行一次");
+        }
+
+        // 禁止窃取：每个任务都由其归属节点的线程执行
+        const size_t task_count = 48;
+        std::vector<int> executed_node(task_count, -1);
+        pool.run(task_count, [](size_t task) { return static_cast<int>(task % 2); },
+                 [&](size_t task, int worker) { executed_node[task] = pool.getWorkerNode(worker); }, false);
+        for (size_t task = 0; task < task_count; ++task) {
+            check(executed_node[task] == static_cast<int>(task % 2), "禁止窃取时任务在归属节点上执行");
+        }
+        check(pool.getLastRunStats().stolen_tasks == 0 && pool.getLastRunStats().local_tasks == task_count,
+              "禁止窃取时所有任务都计为本节点任务");
+
+        // 条带连续地分给节点：上半部分属于节点 0，下半部分属于节点 1
+        SoftRenderer::NodeLocalFrameBuffer target(64, 64 * 8, pool, 64);
+        for (int band = 0; band < target.getBandCount(); ++band) {
+            check(target.getBandNode(band) == (band < 4 ? 0 : 1), "条带按行号连续地分给各节点");
+        }
+    }
+
+    void testMatchesSingleThread(SoftRenderer::WorkerPool &pool) {
+        const int width = 333, height = 250;
+        const Color clear_color(12, 34, 56);
+        const SoftRenderer::YUVTexture bilinear = makeTexture(SoftRenderer::TestPatternType::ZONE_PLATE,
+                                                              SoftRenderer::TextureFilter::BILINEAR);
+        const SoftRenderer::YUVTexture nearest = makeTexture(SoftRenderer::TestPatternType::COLOR_BARS,
+                                                             SoftRenderer::TextureFilter::NEAREST);
+
+        // 跨越多个条带、互相重叠的纹理三角形和纯色三角形，部分超出帧缓冲
+        std::vector<Vertex> bilinear_triangles, nearest_triangles;
+        quadTriangles(170.0f, 120.0f, 150.0f, 100.0f, 0.26f, bilinear_triangles);
+        quadTriangles(60.0f, 200.0f, 90.0f, 70.0f, -0.6f, nearest_triangles);
+        const Vertex solid[3] = {Vertex(200.0f, -20.0f), Vertex(340.0f, 130.0f),
+                                               Vertex(150.0f, 240.0f)};
+        const Color solid_color(200, 40, 90);
+
+        SoftRenderer::FrameBuffer reference(width, height);
+        reference.clear(clear_color);
+        SoftRenderer::Rasterizer rasterizer;
+        SoftRenderer::ParallelRenderer renderer(pool);
+        for (size_t i = 0; i < bilinear_triangles.size(); i += 3) {
+            rasterizer.drawTexturedTriangle(reference, bilinear_triangles[i], bilinear_triangles[i + 1],
+                                            bilinear_triangles[i + 2], bilinear);
+            renderer.drawTexturedTriangle(bilinear_triangles[i], bilinear_triangles[i + 1], bilinear_triangles[i + 2], bilinear);
+        }
+        rasterizer.drawSolidTriangle(reference, solid[0], solid[1], solid[2], solid_color);
+        renderer.drawSolidTriangle(solid[0], solid[1], solid[2], solid_color);
+        for (size_t i = 0; i < nearest_triangles.size(); i += 3) {
+            rasterizer.drawTexturedTriangle(reference, nearest_triangles[i], nearest_triangles[i + 1],
+                                            nearest_triangles[i + 2], nearest);
+            renderer.drawTexturedTriangle(nearest_triangles[i], nearest_triangles[i + 1], nearest_triangles[i + 2], nearest);
+        }
+
+        // 条带高度不整除帧高、大于帧高时结果都不变；同一批三角形重复渲染也不变
+        for (int band_rows : {64, 37, 1000}) {
+            SoftRenderer::FrameBuffer target(width, height);
+            renderer.render(target, clear_color, band_rows);
+            const size_t differences = countDifferences(reference, target);
+            if (differences != 0) {
+                std::fprintf(stderr, "band_rows %d: %zu 个像素与单线程结果不同\n", band_rows, differences);
+            }
+            check(differences == 0, "条带并行渲染与单线程 Rasterizer 逐字节一致");
+        }
+
+        SoftRenderer::NodeLocalFrameBuffer node_local(width, height, pool, 32);
+        renderer.render(node_local, clear_color);
+        check(countDifferences(reference, node_local.get()) == 0, "按节点放置的帧缓冲与单线程 Rasterizer 逐字节一致");
+    }
+}
+
+int main() {
+    // 不绑核：模拟拓扑的 CPU 编号在单核机器上会全部映射到同一个 CPU
+    SoftRenderer::WorkerPool pool(SoftRenderer::NumaTopology::simulate(2, 3), false);
+    testWorkerAssignment(pool);
+    testMatchesSingleThread(pool);
+    if (failures == 0) {
+        std::printf("ParallelRendererTest: 全部通过\n");
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,157 @@
+//
+//  SplitFrameRendererTest.cpp
+//  SoftRenderer
+//
+//  Created by Jormungand on 2026/10/18.
+//
+
+#include <cmath>
+#include <vector>
+#include <cstdio>
+#include <string>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+#include <filesystem>
+#include "core/YUVFrameBuffer.hpp"
+#include "tools/TestPattern.hpp"
+#include "parallel/SplitFrameRenderer.hpp"
+
+/**
+ * 多进程分屏渲染：SplitFrameRenderer 各工作进程在共享帧缓冲上拼出的整帧，与单进程 Rasterizer 的结果逐字节一致。
+ * 覆盖不整除帧高的区域划分、跨区域的三角形、纹理引用的跨帧缓存（第二帧不再发送纹理）以及清屏色的变化。
+ */
+namespace {
+
+    int failures = 0;
+
+    void check(bool condition, const char *what) {
+        if (!condition) {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            ++failures;
+        }
+    }
+
+    size_t countDifferences(const SoftRenderer::FrameBuffer &a, const SoftRenderer::FrameBuffer &b) {
+        size_t differences = 0;
+        for (int y = 0; y < a.getHeight(); ++y) {
+            const Color *row_a = a.getRow(y);
+            const Color *row_b = b.getRow(y);
+            for (int x = 0; x < a.getWidth(); ++x) {
+                if (row_a[x].r != row_b[x].r || row_a[x].g != row_b[x].g || row_a[x].b != row_b[x].b) {
+                    ++differences;
+                }
+            }
+        }
+        return differences;
+    }
+
+    // 把测试图案写成 I420 文件：工作进程按文件路径加载纹理
+    void writePattern(const std::string &path, int width, int height, SoftRenderer::TestPatternType type) {
+        SoftRenderer::TestPatternOptions options;
+        options.type = type;
+        SoftRenderer::YUVFrameBuffer pattern(width, height);
+        SoftRenderer::TestPatternGenerator(width, height, options).renderFrame(0, pattern);
+        std::ofstream file(path, std::ios::binary);
+        for (const std::vector<unsigned char> *plane : {&pattern.getYPlane(), &pattern.getUPlane(), &pattern.getVPlane()}) {
+            file.write(reinterpret_cast<const char *>(plane->data()), static_cast<std::streamsize>(plane->size()));
+        }
+        if (!file) {
+            throw std::runtime_error("无法写入测试纹理 " + path);
+        }
+    }
+
+    struct Triangle {
+        Vertex v0, v1, v2;
+        int texture = -1; // -1 表示纯色
+        Color color;
+    };
+
+    // 绕 (cx, cy) 旋转 angle 的整图四边形，拆成两个三角形
+    void addQuad(std::vector<Triangle> &out, float cx, float cy, float half_w, float half_h, float angle, int texture) {
+        const float c = std::cos(angle), s = std::sin(angle);
+        auto corner = [&](float dx, float dy, float u, float v) {
+            return Vertex(cx + dx * c - dy * s, cy + dx * s + dy * c, u, v);
+        };
+        const Vertex v0 = corner(-half_w, -half_h, 0.0f, 0.0f);
+        const Vertex v1 = corner(half_w, -half_h, 1.0f, 0.0f);
+        const Vertex v2 = corner(half_w, half_h, 1.0f, 1.0f);
+        const Vertex v3 = corner(-half_w, half_h, 0.0f, 1.0f);
+        out.push_back({v0, v1, v2, texture, Color()});
+        out.push_back({v0, v2, v3, texture, Color()});
+    }
+
+    std::vector<Triangle> makeScene(int frame) {
+        std::vector<Triangle> scene;
+        const float shift = 23.0f * static_cast<float>(frame);
+        addQuad(scene, 150.0f + shift, 110.0f, 140.0f, 95.0f, 0.3f + 0.1f * static_cast<float>(frame), 0);
+        scene.push_back({Vertex(180.0f, -15.0f), Vertex(330.0f, 90.0f), Vertex(120.0f + shift, 230.0f), -1, Color(210, 60, 20)});
+        addQuad(scene, 70.0f, 170.0f - shift, 60.0f, 45.0f, -0.7f, 1);
+        return scene;
+    }
+
+    void testMatchesSingleProcess(const std::string &bilinear_path, const std::string &nearest_path, int worker_count) {
+        const int width = 321, height = 233;
+        const int texture_width = 160, texture_height = 120;
+
+        SoftRenderer::SplitFrameRenderer split(width, height, worker_count);
+        split.addTexture(bilinear_path, texture_width, texture_height, 0, SoftRenderer::TextureFilter::BILINEAR);
+        split.addTexture(nearest_path, texture_width, texture_height, 0, SoftRenderer::TextureFilter::NEAREST);
+
+        SoftRenderer::YUVTexture bilinear(bilinear_path, texture_width, texture_height);
+        bilinear.setFilterMode(SoftRenderer::TextureFilter::BILINEAR);
+        SoftRenderer::YUVTexture nearest(nearest_path, texture_width, texture_height);
+        nearest.setFilterMode(SoftRenderer::TextureFilter::NEAREST);
+        const SoftRenderer::YUVTexture *textures[2] = {&bilinear, &nearest};
+
+        const Color clear_colors[2] = {Color(12, 34, 56), Color(90, 90, 10)};
+        for (int frame = 0; frame < 2; ++frame) {
+            SoftRenderer::FrameBuffer reference(width, height);
+            reference.clear(clear_colors[frame]);
+            SoftRenderer::Rasterizer rasterizer;
+            split.clearTriangles();
+            for (const Triangle &triangle : makeScene(frame)) {
+                if (triangle.texture < 0) {
+                    rasterizer.drawSolidTriangle(reference, triangle.v0, triangle.v1, triangle.v2, triangle.color);
+                    split.drawSolidTriangle(triangle.v0, triangle.v1, triangle.v2, triangle.color);
+                } else {
+                    rasterizer.drawTexturedTriangle(reference, triangle.v0, triangle.v1, triangle.v2, *textures[triangle.texture]);
+                    split.drawTexturedTriangle(triangle.v0, triangle.v1, triangle.v2, triangle.texture);
+                }
+            }
+            split.render(clear_colors[frame]);
+
+            const size_t differences = countDifferences(reference, split.getFrameBuffer());
+            if (differences != 0) {
+                std::fprintf(stderr, "%d 个工作进程，第 %d 帧：%zu 个像素与单进程结果不同\n", worker_count, frame, differences);
+            }
+            check(differences == 0, "分屏渲染与单进程 Rasterizer 逐字节一致");
+        }
+    }
+}
+
+int main() {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() /
+                                            ("softrenderer-split-test-" + std::to_string(getpid()));
+    std::filesystem::create_directories(directory);
+    const std::string bilinear_path = (directory / "zoneplate_160x120.yuv").string();
+    const std::string nearest_path = (directory / "bars_160x120.yuv").string();
+
+    try {
+        writePattern(bilinear_path, 160, 120, SoftRenderer::TestPatternType::ZONE_PLATE);
+        writePattern(nearest_path, 160, 120, SoftRenderer::TestPatternType::COLOR_BARS);
+        // 1 个进程（整帧一个区域）、不整除帧高的 3 个和 7 个区域
+        for (int worker_count : {1, 3, 7}) {
+            testMatchesSingleProcess(bilinear_path, nearest_path, worker_count);
+        }
+    } catch (const std::exception &e) {
+        std::fprintf(stderr, "FAILED: %s\n", e.what());
+        ++failures;
+    }
+    std::filesystem::remove_all(directory);
+
+    if (failures == 0) {
+        std::printf("SplitFrameRendererTest: 全部通过\n");
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}